@@ -40,6 +40,7 @@
 #include "base/ds/Feature.h"
 #include "base/ds/Gradient.h"
 #include "base/ds/Handle.h"
+#include "base/ds/Histogram.h"
 #include "base/ds/Mean.h"
 #include "base/ds/Khash.h"
 #include "base/ds/MemoryPool.h"
@@ -51,6 +52,8 @@
 #include "base/ds/State.h"
 #include "base/ds/StaticBuffer.h"
 #include "base/ds/StaticCircularBuffer.h"
+#include "base/ds/Swiss.h"
+#include "base/ds/TimerWheel.h"
 #include "base/ds/Tokens.h"
 #include "base/ds/Twiddler.h"
 #include "base/ds/UID.h"
@@ -60,6 +63,7 @@
 #include "base/ipc/inet.h"
 #include "base/Network.h"
 #include "base/Options.h"
+#include "base/Ring.h"
 #include "base/Selector.h"
 #include "base/Signal.h"
 #include "base/Storage.h"
@@ -102,6 +106,7 @@
 #include "hub/Agent.h"
 #include "hub/Alarm.h"
 #include "hub/Event.h"
+#include "hub/FairQueue.h"
 #include "hub/Hub.h"
 #include "hub/HubInfo.h"
 #include "hub/Identity.h"
@@ -109,6 +114,7 @@
 #include "hub/Interrupt.h"
 #include "hub/Job.h"
 #include "hub/Logic.h"
+#include "hub/Offload.h"
 #include "hub/Protocol.h"
 #include "hub/Socket.h"
 #include "hub/Stream.h"
@@ -66,7 +66,18 @@ void ConfigTool::execute() noexcept {
 void ConfigTool::generateKeyPair() {
 	char pkf[1024] { };
 	char skf[1024] { };
+	unsigned int type; //unsigned
 	try {
+		std::cout << "Select key type\n" << "1: RSA (encryption and signing)\n"
+				<< "2: Ed25519 (signing only)\n:: ";
+		std::cin >> type;
+		if (CommandLine::inputError()) {
+			return;
+		} else if (type != 1 && type != 2) {
+			std::cerr << "Invalid option" << std::endl;
+			return;
+		}
+
 		std::cout << "Public key file: ";
 		std::cin.ignore();
 		std::cin.getline(pkf, sizeof(pkf));
@@ -79,9 +90,14 @@ void ConfigTool::generateKeyPair() {
 			return;
 		}
 
-		std::cout << "Generating " << PKI::KEY_LENGTH << " bit RSA keys"
-				<< std::endl;
-		PKI::generate(skf, pkf);
+		if (type == 1) {
+			std::cout << "Generating " << PKI::KEY_LENGTH << " bit RSA keys"
+					<< std::endl;
+			PKI::generate(skf, pkf);
+		} else {
+			std::cout << "Generating Ed25519 keys" << std::endl;
+			PKI::generateSignature(skf, pkf);
+		}
 	} catch (const BaseException &e) {
 		throw;
 	}
@@ -16,10 +16,18 @@
 #include "../server/auth/AuthenticationHub.h"
 #include "../server/core/OverlayHub.h"
 #include "../server/core/OverlayTool.h"
+#include "../test/auth/CredentialsTest.h"
+#include "../test/base/SelectorTest.h"
 #include "../test/ds/BufferTest.h"
 #include "../test/ds/HashTableTest.h"
+#include "../test/ds/TimerWheelTest.h"
+#include "../test/flood/LoopbackTest.h"
 #include "../test/flood/NetworkTest.h"
+#include "../test/hub/FairQueueTest.h"
+#include "../test/multicast/FanoutTest.h"
 #include "../test/multicast/MulticastConsumer.h"
+#include "../test/security/SignatureTest.h"
+#include "../test/util/PacketTest.h"
 #include <iostream>
 #include <getopt.h>
 
@@ -53,16 +61,20 @@ int Manager::parseOptions(int argc, char *argv[]) noexcept {
 	ctx.program = strrchr(argv[0], Storage::PATH_SEPARATOR);
 	ctx.program = ctx.program ? (ctx.program + 1) : argv[0];
 	//-----------------------------------------------------------------
-	auto shortOptions = "c:hmn:St:v";
-	const struct option longOptions[] = { { "config", 1, nullptr, 'c' }, {
-			"help", 0, nullptr, 'h' }, { "menu", 0, nullptr, 'm' }, { "name", 1,
-			nullptr, 'n' }, { "syslog", 0, nullptr, 'S' }, { "type", 1, nullptr,
-			't' }, { "version", 0, nullptr, 'v' }, { nullptr, 0, nullptr, 0 } };
+	auto shortOptions = "bc:hmn:St:v";
+	const struct option longOptions[] = { { "benchmark", 0, nullptr, 'b' }, {
+			"config", 1, nullptr, 'c' }, { "help", 0, nullptr, 'h' }, { "menu",
+			0, nullptr, 'm' }, { "name", 1, nullptr, 'n' }, { "syslog", 0,
+			nullptr, 'S' }, { "type", 1, nullptr, 't' }, { "version", 0,
+			nullptr, 'v' }, { nullptr, 0, nullptr, 0 } };
 	//-----------------------------------------------------------------
 	while (true) {
 		auto nextOption = getopt_long(argc, argv, shortOptions, longOptions,
 				nullptr);
 		switch (nextOption) {
+		case 'b':
+			ctx.benchmark = true;
+			break;
 		case 'c':
 			ctx.config = optarg;
 			break;
@@ -100,7 +112,10 @@ int Manager::parseOptions(int argc, char *argv[]) noexcept {
 
 void Manager::processOptions() noexcept {
 	int option = 1; //Default option
-	if (ctx.menu) {
+	if (ctx.benchmark) {
+		runBenchmark();
+		return;
+	} else if (ctx.menu) {
 		std::cout << "Select an option\n" << "1. WANHIVE HUB\n"
 				<< "2. UTILITIES\n" << "3. PROTOCOL TEST\n"
 				<< "4. NETWORK TEST\n" << "5. COMPONENTS TEST\n" << "6. ABOUT\n"
@@ -225,6 +240,13 @@ void Manager::runNetworkTest() noexcept {
 	NetworkTest::test(ctx.config);
 }
 
+void Manager::runBenchmark() noexcept {
+	LoopbackTest t(ctx.config);
+	if (!t.execute()) {
+		WH_LOG_ERROR("Benchmark failed");
+	}
+}
+
 void Manager::runComponentsTest() noexcept {
 	//Maintaining the scopes to free up the memory immediately
 	{
@@ -234,6 +256,13 @@ void Manager::runComponentsTest() noexcept {
 		std::cout << "\n-----RING BUFFER TEST END-----\n";
 	}
 
+	{
+		std::cout << "\n-----SELECTOR TEST BEGIN-----\n";
+		SelectorTest t;
+		t.execute();
+		std::cout << "\n-----SELECTOR TEST END-----\n";
+	}
+
 	{
 		std::cout << "\n-----HASH TABLE TEST BEGIN-----\n";
 		HashTableTest t;
@@ -241,6 +270,41 @@ void Manager::runComponentsTest() noexcept {
 		std::cout << "\n-----HASH TABLE TEST END-----\n";
 	}
 
+	{
+		std::cout << "\n-----TIMER WHEEL TEST BEGIN-----\n";
+		TimerWheelTest t;
+		t.execute();
+		std::cout << "\n-----TIMER WHEEL TEST END-----\n";
+	}
+
+	{
+		std::cout << "\n-----CREDENTIALS CACHE TEST BEGIN-----\n";
+		CredentialsTest t;
+		t.execute();
+		std::cout << "\n-----CREDENTIALS CACHE TEST END-----\n";
+	}
+
+	{
+		std::cout << "\n-----FAIR QUEUE TEST BEGIN-----\n";
+		FairQueueTest t;
+		t.execute();
+		std::cout << "\n-----FAIR QUEUE TEST END-----\n";
+	}
+
+	{
+		std::cout << "\n-----BATCH FRAME TEST BEGIN-----\n";
+		PacketTest t;
+		t.execute();
+		std::cout << "\n-----BATCH FRAME TEST END-----\n";
+	}
+
+	{
+		std::cout << "\n-----FAN-OUT BENCHMARK BEGIN-----\n";
+		FanoutTest t;
+		t.execute();
+		std::cout << "\n-----FAN-OUT BENCHMARK END-----\n";
+	}
+
 	{
 		std::cout << "\n-----ENCODING TEST BEGIN-----\n";
 		Encoding::test();
@@ -272,6 +336,13 @@ void Manager::runComponentsTest() noexcept {
 		std::cout << "Time elapsed: " << t.elapsed() << " seconds" << std::endl;
 		std::cout << "\n-----SRP STRESS TEST END-----\n";
 	}
+
+	{
+		std::cout << "\n-----SIGNATURE BENCHMARK BEGIN-----\n";
+		SignatureTest t;
+		t.execute();
+		std::cout << "\n-----SIGNATURE BENCHMARK END-----\n";
+	}
 }
 
 void Manager::installSignals() {
@@ -324,6 +395,7 @@ void Manager::printVersion(FILE *stream) noexcept {
 void Manager::printUsage(FILE *stream) noexcept {
 	fprintf(stream, "Usage: %s [OPTIONS]\n", ctx.program);
 	fprintf(stream, "OPTIONS\n");
+	fprintf(stream, "-b --benchmark            \tRun the loopback benchmark.\n");
 	fprintf(stream, "-c --config   <path>      \tConfiguration file's path.\n");
 	fprintf(stream, "-h --help                 \tDisplay usage information.\n");
 	fprintf(stream, "-m --menu                 \tShow the application menu.\n");
@@ -348,6 +420,7 @@ void Manager::printContact(FILE *stream) noexcept {
 void Manager::clear() noexcept {
 	ctx.program = nullptr;
 	ctx.menu = false;
+	ctx.benchmark = false;
 	ctx.uid = INVALID_UID;
 	ctx.type = '\0';
 	ctx.config = nullptr;
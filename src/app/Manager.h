@@ -44,6 +44,7 @@ private:
 	static void runCommandTest() noexcept;
 	static void runNetworkTest() noexcept;
 	static void runComponentsTest() noexcept;
+	static void runBenchmark() noexcept;
 	//-----------------------------------------------------------------
 	static void installSignals();
 	static void restoreSignals();
@@ -58,6 +59,7 @@ public:
 	struct Context {
 		const char *program;
 		bool menu;
+		bool benchmark;
 		char type;
 		unsigned long long uid;
 		const char *config;
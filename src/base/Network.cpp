@@ -17,6 +17,7 @@
 #include "unix/SystemException.h"
 #include <cerrno>
 #include <cstdio>
+#include <netinet/tcp.h>
 #include <sys/un.h>
 #include <sys/stat.h>
 
@@ -258,4 +259,11 @@ void Network::setTimeout(int sfd, int input, int output) {
 	}
 }
 
+void Network::setCork(int sfd, bool cork) {
+	int value = cork ? 1 : 0;
+	if (::setsockopt(sfd, IPPROTO_TCP, TCP_CORK, &value, sizeof(value))) {
+		throw SystemException();
+	}
+}
+
 } /* namespace wanhive */
@@ -151,6 +151,13 @@ public:
 	 * @param output send timeout value in milliseconds
 	 */
 	static void setTimeout(int sfd, int input, int output);
+	/**
+	 * Corks or uncorks a TCP socket (see TCP_CORK). A corked socket holds back
+	 * the partial frames, uncorking pushes them out.
+	 * @param sfd socket file descriptor
+	 * @param cork true to cork, false to uncork
+	 */
+	static void setCork(int sfd, bool cork);
 };
 
 } /* namespace wanhive */
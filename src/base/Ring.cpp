@@ -0,0 +1,181 @@
+/*
+ * Ring.cpp
+ *
+ * Asynchronous IO submission and completion queues
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "Ring.h"
+#include "common/Atomic.h"
+#include "common/Exception.h"
+#include "unix/SystemException.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace wanhive {
+
+Ring::Ring() noexcept {
+
+}
+
+Ring::Ring(unsigned int entries) {
+	initialize(entries);
+}
+
+Ring::~Ring() {
+	close();
+}
+
+void Ring::initialize(unsigned int entries) {
+	close();
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	auto ret = ::syscall(__NR_io_uring_setup, entries, &params);
+	if (ret == -1) {
+		throw SystemException();
+	} else {
+		fd = ret;
+	}
+
+	try {
+		map(params);
+	} catch (const BaseException &e) {
+		close();
+		throw;
+	}
+}
+
+io_uring_sqe* Ring::next() {
+	if (pending() == sq.entries) {
+		//Submission queue is full, make some space
+		if (enter(0) == -1) {
+			throw SystemException();
+		} else if (pending() == sq.entries) {
+			throw Exception(EX_OVERFLOW);
+		}
+	}
+
+	auto index = sq.local & sq.mask;
+	auto sqe = &sqes[index];
+	memset(sqe, 0, sizeof(io_uring_sqe));
+	sq.array[index] = index;
+	++sq.local;
+	return sqe;
+}
+
+unsigned int Ring::pending() const noexcept {
+	return sq.local - Atomic<unsigned int>::load(sq.head, MO_ACQUIRE);
+}
+
+int Ring::enter(unsigned int wait, int timeout, const sigset_t *mask) noexcept {
+	//Publish the new entries
+	Atomic<unsigned int>::store(sq.tail, sq.local, MO_RELEASE);
+
+	__kernel_timespec ts;
+	io_uring_getevents_arg arg;
+	memset(&arg, 0, sizeof(arg));
+	arg.sigmask = (uintptr_t) mask;
+	arg.sigmask_sz = _NSIG / 8;
+	if (timeout >= 0) {
+		ts.tv_sec = timeout / 1000;
+		ts.tv_nsec = (timeout % 1000) * 1000000L;
+		arg.ts = (uintptr_t) &ts;
+	}
+
+	return ::syscall(__NR_io_uring_enter, fd, pending(), wait,
+			(IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG), &arg, sizeof(arg));
+}
+
+unsigned int Ring::ready() const noexcept {
+	return Atomic<unsigned int>::load(cq.tail, MO_ACQUIRE) - *cq.head;
+}
+
+const io_uring_cqe* Ring::peek() const noexcept {
+	auto head = *cq.head;
+	if (head != Atomic<unsigned int>::load(cq.tail, MO_ACQUIRE)) {
+		return &cq.cqes[head & cq.mask];
+	} else {
+		return nullptr;
+	}
+}
+
+void Ring::advance() noexcept {
+	Atomic<unsigned int>::store(cq.head, *cq.head + 1, MO_RELEASE);
+}
+
+void Ring::map(const io_uring_params &params) {
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP)
+			|| !(params.features & IORING_FEAT_EXT_ARG)) {
+		throw Exception(EX_OPERATION);
+	}
+
+	//Submission and completion queues share a single mapping
+	auto sqSize = params.sq_off.array
+			+ params.sq_entries * sizeof(unsigned int);
+	auto cqSize = params.cq_off.cqes
+			+ params.cq_entries * sizeof(io_uring_cqe);
+	ringsSize = (sqSize > cqSize) ? sqSize : cqSize;
+	rings = ::mmap(nullptr, ringsSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (rings == MAP_FAILED) {
+		rings = nullptr;
+		throw SystemException();
+	}
+
+	sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+	auto p = ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (p == MAP_FAILED) {
+		throw SystemException();
+	} else {
+		sqes = (io_uring_sqe*) p;
+	}
+
+	auto base = (unsigned char*) rings;
+	sq.head = (unsigned int*) (base + params.sq_off.head);
+	sq.tail = (unsigned int*) (base + params.sq_off.tail);
+	sq.array = (unsigned int*) (base + params.sq_off.array);
+	sq.mask = *(unsigned int*) (base + params.sq_off.ring_mask);
+	sq.entries = *(unsigned int*) (base + params.sq_off.ring_entries);
+	sq.local = *sq.tail;
+
+	cq.head = (unsigned int*) (base + params.cq_off.head);
+	cq.tail = (unsigned int*) (base + params.cq_off.tail);
+	cq.cqes = (io_uring_cqe*) (base + params.cq_off.cqes);
+	cq.mask = *(unsigned int*) (base + params.cq_off.ring_mask);
+}
+
+int Ring::close() noexcept {
+	if (sqes) {
+		::munmap(sqes, sqesSize);
+	}
+
+	if (rings) {
+		::munmap(rings, ringsSize);
+	}
+
+	int ret = 0;
+	if (fd != -1) {
+		ret = ::close(fd);
+	}
+
+	fd = -1;
+	rings = nullptr;
+	ringsSize = 0;
+	sqes = nullptr;
+	sqesSize = 0;
+	memset(&sq, 0, sizeof(sq));
+	memset(&cq, 0, sizeof(cq));
+	return ret;
+}
+
+} /* namespace wanhive */
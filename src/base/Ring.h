@@ -0,0 +1,121 @@
+/**
+ * @file Ring.h
+ *
+ * Asynchronous IO submission and completion queues
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_BASE_RING_H_
+#define WH_BASE_RING_H_
+#include "common/NonCopyable.h"
+#include <csignal>
+#include <linux/io_uring.h>
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Submission and completion queues shared with the kernel.
+ * @note Provides abstraction of Linux's io_uring(7) mechanism. Requires Linux
+ * kernel version 5.11 or later.
+ */
+class Ring: private NonCopyable {
+public:
+	/**
+	 * Constructor: creates an empty object.
+	 */
+	Ring() noexcept;
+	/**
+	 * Constructor: creates and initializes a new ring.
+	 * @param entries minimum number of submission queue entries
+	 */
+	Ring(unsigned int entries);
+	/**
+	 * Destructor
+	 */
+	~Ring();
+	/**
+	 * Initializes the object (performs clean up if the object was previously
+	 * initialized).
+	 * @param entries minimum number of submission queue entries
+	 */
+	void initialize(unsigned int entries);
+	/**
+	 * Releases the resources (the object can be reinitialized).
+	 * @return zero (0) on success, -1 on error
+	 */
+	int close() noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns a cleared submission queue entry. The entry gets submitted to the
+	 * kernel during the next call to Ring::enter(). If the submission queue is
+	 * full then the pending entries are submitted first.
+	 * @return submission queue entry
+	 */
+	io_uring_sqe* next();
+	/**
+	 * Returns the number of entries waiting for submission.
+	 * @return pending submissions count
+	 */
+	unsigned int pending() const noexcept;
+	/**
+	 * Submits the pending entries and optionally waits for completions, signal
+	 * delivery, or timeout.
+	 * @param wait minimum number of completions to wait for
+	 * @param timeout wait period in milliseconds, set to -1 to block
+	 * indefinitely
+	 * @param mask signal mask to apply during the wait (nullptr to ignore)
+	 * @return number of submitted entries on success, -1 on error (errno is
+	 * set to indicate the error).
+	 */
+	int enter(unsigned int wait, int timeout = -1,
+			const sigset_t *mask = nullptr) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns the number of completions which can be read.
+	 * @return completions count
+	 */
+	unsigned int ready() const noexcept;
+	/**
+	 * Returns the next completion queue entry without consuming it.
+	 * @return completion queue entry (nullptr if none available)
+	 */
+	const io_uring_cqe* peek() const noexcept;
+	/**
+	 * Consumes the completion queue entry returned by Ring::peek().
+	 */
+	void advance() noexcept;
+private:
+	void map(const io_uring_params &params);
+private:
+	int fd { -1 };
+	//Shared memory
+	void *rings { };
+	size_t ringsSize { };
+	io_uring_sqe *sqes { };
+	size_t sqesSize { };
+	//Submission queue
+	struct {
+		unsigned int *head;
+		unsigned int *tail;
+		unsigned int *array;
+		unsigned int mask;
+		unsigned int entries;
+		unsigned int local; //Local copy of the tail
+	} sq { };
+	//Completion queue
+	struct {
+		unsigned int *head;
+		unsigned int *tail;
+		io_uring_cqe *cqes;
+		unsigned int mask;
+	} cq { };
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_BASE_RING_H_ */
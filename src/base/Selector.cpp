@@ -13,35 +13,89 @@
 #include "Selector.h"
 #include "unix/SystemException.h"
 #include <cerrno>
+#include <cstring>
 #include <signal.h>
 #include <unistd.h>
 
+namespace {
+
+//Request types of the io_uring backend
+enum : uint32_t {
+	OP_POLL, //Readiness notification
+	OP_RECV, //Multi-shot receive into the provided buffers
+	OP_SEND, //Gather write
+	OP_OUT //One-shot write readiness notification
+};
+
+//States of a stream registration
+enum : uint32_t {
+	ST_RECEIVING = 1, //Receive request is armed
+	ST_CANCELING = 2, //Receive request is getting canceled
+	ST_STARVED = 4, //Receive request ran out of the provided buffers
+	ST_EOF = 8, //Peer closed the stream
+	ST_SENDING = 16, //Send request is in flight
+	ST_SENT = 32, //Send request's result is available
+	ST_BLOCKED = 64, //Send request would have blocked
+	ST_WATCHING = 128 //Write readiness notification is armed
+};
+
+//Provided buffers' group identifier
+constexpr unsigned int BUFFER_GROUP = 0;
+//Requests' tags are 28 bits wide
+constexpr uint32_t TAG_MASK = 0x0fffffff;
+
+//User data of the io_uring requests: (tag << 36 | type << 32 | descriptor)
+uint64_t makeKey(int fd, uint32_t tag, uint32_t type = OP_POLL) noexcept {
+	return (((uint64_t) ((tag << 4) | type)) << 32) | ((uint32_t) fd);
+}
+
+}  // namespace
+
 namespace wanhive {
 
 Selector::Selector() noexcept {
 
 }
 
-Selector::Selector(unsigned int events, bool signal) {
-	initialize(events, signal);
+Selector::Selector(unsigned int events, bool signal, bool uring) {
+	initialize(events, signal, uring);
 }
 
 Selector::~Selector() {
 	close();
 }
 
-void Selector::initialize(unsigned int events, bool signal) {
+void Selector::initialize(unsigned int events, bool signal, bool uring) {
 	//Strictly maintain the sequence to prevent resource leak
 	close();
 	selected.initialize(events);
 	selected.rewind(); //Nothing to read yet
 	mask = (signal ? &signals : nullptr);
-	create();
+	this->uring = uring;
+	create(events);
 }
 
 void Selector::add(int fd, uint32_t events, void *handle) {
+	if (uring) {
+		auto r = lookup(fd, true);
+		if (r->tag) {
+			throw SystemException(EEXIST);
+		} else if (!streaming()) {
+			events &= ~TRIGGER_STREAM;
+		}
+
+		*r = { handle, events, nextTag(), { } };
+		try {
+			arm(fd, *r);
+		} catch (const BaseException &e) {
+			*r = { };
+			throw;
+		}
+		return;
+	}
+
 	epoll_event event;
-	event.events = events;
+	event.events = (events & ~TRIGGER_STREAM);
 	event.data.ptr = handle;
 
 	if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event)) {
@@ -50,8 +104,29 @@ void Selector::add(int fd, uint32_t events, void *handle) {
 }
 
 void Selector::modify(int fd, uint32_t events, void *handle) {
+	if (uring) {
+		auto r = lookup(fd);
+		if (!r || !r->tag) {
+			throw SystemException(ENOENT);
+		} else if (r->events & TRIGGER_STREAM) {
+			//Keep the requests in flight, a stream remains a stream
+			r->handle = handle;
+			r->events = (events | TRIGGER_STREAM);
+			if ((events & IO_WRITE)
+					&& !(r->stream.state & (ST_SENDING | ST_BLOCKED))) {
+				watch(fd, *r);
+			}
+			return;
+		}
+
+		disarm(fd, *r);
+		*r = { handle, (events & ~TRIGGER_STREAM), nextTag(), { } };
+		arm(fd, *r);
+		return;
+	}
+
 	epoll_event event;
-	event.events = events;
+	event.events = (events & ~TRIGGER_STREAM);
 	event.data.ptr = handle;
 
 	if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &event)) {
@@ -60,6 +135,17 @@ void Selector::modify(int fd, uint32_t events, void *handle) {
 }
 
 void Selector::remove(int fd) {
+	if (uring) {
+		auto r = lookup(fd);
+		if (!r || !r->tag) {
+			throw SystemException(ENOENT);
+		}
+
+		disarm(fd, *r);
+		*r = { };
+		return;
+	}
+
 	epoll_event event;
 	if (epoll_ctl(epfd, EPOLL_CTL_DEL, fd, &event)) {
 		throw SystemException();
@@ -70,9 +156,11 @@ unsigned int Selector::select(int timeout) {
 	_interrupted = false;
 	_expired = false;
 	selected.clear();
-	auto n = epoll_pwait(epfd, selected.offset(), selected.space(), timeout,
-			mask);
-	if (n > 0) {
+	int n;
+	if (uring) {
+		n = wait(timeout);
+	} else if ((n = epoll_pwait(epfd, selected.offset(), selected.space(),
+			timeout, mask)) > 0) {
 		selected.setIndex(selected.getIndex() + n);
 	}
 	//Rewind the buffer, for reading
@@ -94,6 +182,100 @@ unsigned int Selector::select(int timeout) {
 	}
 }
 
+bool Selector::streaming() const noexcept {
+	return uring && buffers.capacity();
+}
+
+ssize_t Selector::receive(int fd, const iovec *vectors, unsigned int count) {
+	auto r = lookup(fd);
+	if (!r || !r->tag || !(r->events & TRIGGER_STREAM)) {
+		errno = EBADF;
+		return -1;
+	} else if (!count) {
+		return 0;
+	}
+
+	auto &s = r->stream;
+	size_t total = 0;
+	for (unsigned int i = 0; i < count && s.held; ++i) {
+		auto base = (unsigned char*) vectors[i].iov_base;
+		auto length = vectors[i].iov_len;
+		size_t done = 0;
+		while (done < length && s.held) {
+			auto &slot = slots[s.head];
+			auto data = buffers.offset((size_t) s.head * BUFFER_SIZE);
+			auto n = slot.length - s.offset;
+			n = (n < (length - done)) ? n : (length - done);
+			memcpy(base + done, data + s.offset, n);
+			done += n;
+			s.offset += n;
+			if (s.offset == slot.length) {
+				auto id = s.head;
+				s.head = slot.next;
+				s.offset = 0;
+				--s.held;
+				recycle(id);
+			}
+		}
+		total += done;
+	}
+
+	if (total) {
+		//Resume the receive request stopped by the hold limit
+		listen(fd, *r);
+		replenish();
+		return total;
+	} else if (s.state & ST_EOF) {
+		return 0;
+	} else if (s.error) {
+		errno = s.error;
+		return -1;
+	} else {
+		errno = EAGAIN;
+		return -1;
+	}
+}
+
+ssize_t Selector::send(int fd, const iovec *vectors, unsigned int count) {
+	auto r = lookup(fd);
+	if (!r || !r->tag || !(r->events & TRIGGER_STREAM)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	auto &s = r->stream;
+	if (s.state & ST_SENT) {
+		s.state &= ~ST_SENT;
+		if (s.result >= 0) {
+			return s.result;
+		} else {
+			errno = -s.result;
+			return -1;
+		}
+	} else if (!count) {
+		return 0;
+	} else if (!(s.state & (ST_SENDING | ST_BLOCKED))) {
+		/*
+		 * The request doesn't wait for the buffer space: it completes during
+		 * the submission and fails with EAGAIN if the send buffer is full.
+		 */
+		memset(&s.message, 0, sizeof(s.message));
+		s.message.msg_iov = const_cast<iovec*>(vectors);
+		s.message.msg_iovlen = count;
+		auto sqe = ring.next();
+		sqe->opcode = IORING_OP_SENDMSG;
+		sqe->fd = fd;
+		sqe->addr = (uintptr_t) &s.message;
+		sqe->len = 1;
+		sqe->msg_flags = (MSG_DONTWAIT | MSG_NOSIGNAL);
+		sqe->user_data = makeKey(fd, r->tag, OP_SEND);
+		s.state |= ST_SENDING;
+	}
+
+	errno = EAGAIN;
+	return -1;
+}
+
 bool Selector::expired() const noexcept {
 	return _expired;
 }
@@ -114,10 +296,13 @@ uint32_t Selector::events(const SelectionEvent *se) noexcept {
 	return se->events;
 }
 
-void Selector::create() {
+void Selector::create(unsigned int events) {
 	//Maintain the order to prevent resource (descriptor) leak
 	if (sigemptyset(&signals) == -1) {
 		throw SystemException();
+	} else if (uring) {
+		ring.initialize(events > RING_ENTRIES ? events : RING_ENTRIES);
+		provide();
 	} else if ((epfd = epoll_create1(0)) == -1) {
 		throw SystemException();
 	} else {
@@ -132,9 +317,401 @@ int Selector::close() noexcept {
 	}
 	mask = nullptr;
 	epfd = -1;
+	ring.close();
+	release();
+	uring = false;
+	tag = 0;
+	registrations.resize(0);
 	_interrupted = false;
 	_expired = false;
 	return ret;
 }
 
+int Selector::wait(int timeout) {
+	unsigned int consumed = 0;
+	do {
+		//Skip the system call if there is nothing to submit or wait for
+		if (ring.pending() || !ring.ready()) {
+			auto wait = (ring.ready() || !timeout) ? 0 : 1;
+			if (ring.enter(wait, timeout, mask) == -1 && errno != ETIME
+					&& errno != EBUSY) {
+				return -1;
+			}
+		}
+
+		consumed = collect();
+		//Only the internal and stale completions, keep waiting
+	} while (!selected.getIndex() && consumed && timeout);
+	return selected.getIndex();
+}
+
+unsigned int Selector::collect() {
+	unsigned int consumed = 0;
+	const io_uring_cqe *cqe;
+	while (selected.hasSpace() && (cqe = ring.peek())) {
+		auto fd = (int) (cqe->user_data & 0xffffffff);
+		auto key = (uint32_t) (cqe->user_data >> 32);
+		auto tag = (key >> 4);
+		auto r = tag ? lookup(fd) : nullptr;
+		uint32_t events = 0;
+		//Skip the stale and internal requests
+		if (r && r->tag == tag) {
+			switch (key & 0xf) {
+			case OP_RECV:
+				events = received(fd, *r, cqe);
+				break;
+			case OP_SEND:
+				events = sent(fd, *r, cqe->res);
+				break;
+			case OP_OUT:
+				r->stream.state &= ~(ST_WATCHING | ST_BLOCKED);
+				events = (cqe->res < 0) ? IO_ERROR : cqe->res;
+				break;
+			default:
+				events = (cqe->res < 0) ? IO_ERROR : cqe->res;
+				//Multi-shot request got terminated, re-arm it
+				if (cqe->res >= 0 && !(cqe->flags & IORING_CQE_F_MORE)
+						&& !(r->events & TRIGGER_ONCE)) {
+					arm(fd, *r);
+				}
+				break;
+			}
+		} else if (cqe->flags & IORING_CQE_F_BUFFER) {
+			//Stale receive request picked a buffer, return it
+			--available;
+			recycle(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+		}
+
+		if (events) {
+			epoll_event event;
+			event.events = events;
+			event.data.ptr = r->handle;
+			selected.put(event);
+		}
+		ring.advance();
+		++consumed;
+	}
+
+	replenish();
+	return consumed;
+}
+
+Selector::Registration* Selector::lookup(int fd, bool grow) {
+	if (fd < 0) {
+		throw SystemException(EBADF);
+	} else if ((size_t) fd < registrations.capacity()) {
+		return registrations.offset(fd);
+	} else if (!grow) {
+		return nullptr;
+	} else {
+		auto capacity = registrations.capacity();
+		auto size = capacity ? capacity : 64;
+		while (size <= (size_t) fd) {
+			size <<= 1;
+		}
+		//Pending send requests refer to the registrations
+		if (ring.pending() && ring.enter(0) == -1) {
+			throw SystemException();
+		}
+		registrations.resize(size);
+		memset(registrations.offset(capacity), 0,
+				(size - capacity) * sizeof(Registration));
+		return registrations.offset(fd);
+	}
+}
+
+void Selector::arm(int fd, Registration &r) {
+	if (r.events & TRIGGER_STREAM) {
+		listen(fd, r);
+		if (r.events & IO_WRITE) {
+			watch(fd, r);
+		}
+		return;
+	}
+
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = fd;
+	sqe->poll32_events = r.events;
+	sqe->len = (r.events & TRIGGER_ONCE) ? 0 : IORING_POLL_ADD_MULTI;
+	sqe->user_data = makeKey(fd, r.tag);
+}
+
+void Selector::disarm(int fd, Registration &r) {
+	if (r.events & TRIGGER_STREAM) {
+		auto &s = r.stream;
+		//Submit the pending send request before the descriptor gets closed
+		if ((s.state & ST_SENDING) && ring.pending() && ring.enter(0) == -1) {
+			throw SystemException();
+		}
+
+		if ((s.state & ST_RECEIVING) && !(s.state & ST_CANCELING)) {
+			cancel(fd, r);
+		}
+
+		if (s.state & ST_WATCHING) {
+			auto sqe = ring.next();
+			sqe->opcode = IORING_OP_POLL_REMOVE;
+			sqe->fd = -1;
+			sqe->addr = makeKey(fd, r.tag, OP_OUT);
+			sqe->user_data = makeKey(fd, 0);
+		}
+
+		while (s.held) {
+			auto id = s.head;
+			s.head = slots[id].next;
+			--s.held;
+			recycle(id);
+		}
+		return;
+	}
+
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_POLL_REMOVE;
+	sqe->fd = -1;
+	sqe->addr = makeKey(fd, r.tag);
+	sqe->user_data = makeKey(fd, 0);
+}
+
+uint32_t Selector::nextTag() noexcept {
+	//Zero (0) is reserved for the internal requests
+	tag = (tag + 1) & TAG_MASK;
+	if (tag == 0) {
+		tag = 1;
+	}
+	return tag;
+}
+
+void Selector::provide() {
+	buffers.resize((size_t) BUFFER_COUNT * BUFFER_SIZE);
+	slots.resize(BUFFER_COUNT);
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+	sqe->fd = BUFFER_COUNT;
+	sqe->addr = (uintptr_t) buffers.offset();
+	sqe->len = BUFFER_SIZE;
+	sqe->buf_group = BUFFER_GROUP;
+	sqe->user_data = makeKey(0, 0);
+	if (complete(sqe->user_data) < 0) {
+		release();
+		return;
+	} else if (probe()) {
+		available = BUFFER_COUNT;
+		return;
+	}
+
+	//Not supported, fall back to the readiness notifications
+	sqe = ring.next();
+	sqe->opcode = IORING_OP_REMOVE_BUFFERS;
+	sqe->fd = BUFFER_COUNT;
+	sqe->buf_group = BUFFER_GROUP;
+	sqe->user_data = makeKey(0, 0);
+	complete(sqe->user_data);
+	release();
+}
+
+bool Selector::probe() {
+	//Multi-shot receive of an idle stream, canceled right away
+	int sv[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv) == -1) {
+		throw SystemException();
+	}
+
+	try {
+		auto sqe = ring.next();
+		sqe->opcode = IORING_OP_RECV;
+		sqe->fd = sv[0];
+		sqe->ioprio = IORING_RECV_MULTISHOT;
+		sqe->flags = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = BUFFER_GROUP;
+		sqe->user_data = makeKey(sv[0], 0, OP_RECV);
+
+		auto key = sqe->user_data;
+		sqe = ring.next();
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = key;
+		sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+		sqe->user_data = makeKey(sv[1], 0);
+		auto ret = complete(key);
+		::close(sv[0]);
+		::close(sv[1]);
+		return ret == -ECANCELED;
+	} catch (const BaseException &e) {
+		::close(sv[0]);
+		::close(sv[1]);
+		throw;
+	}
+}
+
+int Selector::complete(uint64_t key) {
+	//Waits for the completion of an internal request
+	while (true) {
+		if (ring.enter(ring.ready() ? 0 : 1) == -1 && errno != EINTR) {
+			throw SystemException();
+		}
+
+		const io_uring_cqe *cqe;
+		while ((cqe = ring.peek())) {
+			auto found = (cqe->user_data == key);
+			auto res = cqe->res;
+			ring.advance();
+			if (found) {
+				return res;
+			}
+		}
+	}
+}
+
+void Selector::release() noexcept {
+	buffers.resize(0);
+	slots.resize(0);
+	available = 0;
+	starved.resize(0);
+	starving = 0;
+}
+
+uint32_t Selector::received(int fd, Registration &r,
+		const io_uring_cqe *cqe) {
+	auto &s = r.stream;
+	auto res = cqe->res;
+	if (!(cqe->flags & IORING_CQE_F_MORE)) {
+		s.state &= ~(ST_RECEIVING | ST_CANCELING);
+	}
+
+	uint32_t events = 0;
+	if (cqe->flags & IORING_CQE_F_BUFFER) {
+		auto id = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+		--available;
+		if (res > 0) {
+			slots[id] = { 0, (uint32_t) res };
+			if (s.held) {
+				slots[s.tail].next = id;
+			} else {
+				//The stream became readable
+				s.head = id;
+				s.offset = 0;
+				events = IO_READ;
+			}
+			s.tail = id;
+			++s.held;
+		} else {
+			recycle(id);
+		}
+	}
+
+	if (res == 0) {
+		s.state |= ST_EOF;
+		events = IO_READ;
+	} else if (res == -ENOBUFS) {
+		starve(fd, r);
+	} else if (res < 0 && res != -ECANCELED) {
+		s.error = -res;
+		events = IO_ERROR;
+	}
+
+	if (!(s.state & ST_RECEIVING)) {
+		//Multi-shot request got terminated, re-arm it
+		listen(fd, r);
+	} else if (s.held >= HOLD_LIMIT && !(s.state & ST_CANCELING)) {
+		//Stop receiving until the application catches up
+		cancel(fd, r);
+	}
+	return events;
+}
+
+uint32_t Selector::sent(int fd, Registration &r, int result) {
+	auto &s = r.stream;
+	s.state &= ~ST_SENDING;
+	if (result == -EAGAIN) {
+		//Send buffer is full, retry after it drains
+		s.state |= ST_BLOCKED;
+		watch(fd, r);
+		return 0;
+	} else {
+		s.result = result;
+		s.state |= ST_SENT;
+		return IO_WRITE;
+	}
+}
+
+void Selector::listen(int fd, Registration &r) {
+	auto &s = r.stream;
+	if ((s.state & (ST_RECEIVING | ST_STARVED | ST_EOF)) || s.error
+			|| s.held >= HOLD_LIMIT) {
+		return;
+	}
+
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = BUFFER_GROUP;
+	sqe->user_data = makeKey(fd, r.tag, OP_RECV);
+	s.state |= ST_RECEIVING;
+}
+
+void Selector::watch(int fd, Registration &r) {
+	if (r.stream.state & ST_WATCHING) {
+		return;
+	}
+
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_POLL_ADD;
+	sqe->fd = fd;
+	sqe->poll32_events = IO_WRITE;
+	sqe->user_data = makeKey(fd, r.tag, OP_OUT);
+	r.stream.state |= ST_WATCHING;
+}
+
+void Selector::cancel(int fd, Registration &r) {
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = makeKey(fd, r.tag, OP_RECV);
+	sqe->user_data = makeKey(fd, 0);
+	r.stream.state |= ST_CANCELING;
+}
+
+void Selector::starve(int fd, Registration &r) {
+	r.stream.state |= ST_STARVED;
+	if (starving == starved.capacity()) {
+		starved.resize(starving ? (starving << 1) : 64);
+	}
+	*starved.offset(starving++) = fd;
+}
+
+void Selector::recycle(uint32_t id) {
+	//Submitted in a batch along with the next wait
+	auto sqe = ring.next();
+	sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+	sqe->fd = 1;
+	sqe->addr = (uintptr_t) buffers.offset((size_t) id * BUFFER_SIZE);
+	sqe->len = BUFFER_SIZE;
+	sqe->off = id;
+	sqe->buf_group = BUFFER_GROUP;
+	sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+	sqe->user_data = makeKey(0, 0);
+	++available;
+}
+
+void Selector::replenish() {
+	//Resume the starved streams after enough buffers have been returned
+	if (!starving || available < (BUFFER_COUNT >> 3)) {
+		return;
+	}
+
+	auto count = starving;
+	starving = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		auto fd = *starved.offset(i);
+		auto r = lookup(fd);
+		if (r && r->tag && (r->stream.state & ST_STARVED)) {
+			r->stream.state &= ~ST_STARVED;
+			listen(fd, *r);
+		}
+	}
+}
+
 } /* namespace wanhive */
@@ -12,9 +12,12 @@
 
 #ifndef WH_BASE_SELECTOR_H_
 #define WH_BASE_SELECTOR_H_
+#include "Ring.h"
+#include "common/Memory.h"
 #include "common/NonCopyable.h"
 #include "ds/Buffer.h"
 #include <sys/epoll.h>
+#include <sys/socket.h>
 
 /*! @namespace wanhive */
 namespace wanhive {
@@ -45,12 +48,17 @@ enum SelectorEvent : uint32_t {
  */
 enum SelectorFlag : uint32_t {
 	TRIGGER_EDGE = EPOLLET, /**< Edge trigger */
-	TRIGGER_ONCE = EPOLLONESHOT/**< One-shot notification */
+	TRIGGER_ONCE = EPOLLONESHOT, /**< One-shot notification */
+	TRIGGER_STREAM = (1U << 27) /**< Completion-based stream IO (io_uring) */
 };
 //-----------------------------------------------------------------
 /**
  * IO multiplexer: monitors multiple file descriptors for IO events.
- * @note Provides abstraction of Linux's epoll(7) mechanism.
+ * @note Provides abstraction of Linux's epoll(7) mechanism. Optionally uses
+ * the io_uring(7) mechanism: interest list updates are batched and submitted
+ * along with the wait in a single system call. The stream sockets registered
+ * with the TRIGGER_STREAM flag receive through a multi-shot request into the
+ * provided buffers and send through requests which get submitted in a batch.
  */
 class Selector: private NonCopyable {
 public:
@@ -62,8 +70,9 @@ public:
 	 * Constructor: creates and initializes a new selector.
 	 * @param events maximum number of IO events to report
 	 * @param signal true for signal safety, false for default behavior
+	 * @param uring true to use io_uring, false to use epoll (default)
 	 */
-	Selector(unsigned int events, bool signal);
+	Selector(unsigned int events, bool signal, bool uring = false);
 	/**
 	 * Destructor
 	 */
@@ -73,8 +82,9 @@ public:
 	 * initialized).
 	 * @param events maximum number of IO events to report
 	 * @param signal true true for signal safety, false for default behavior
+	 * @param uring true to use io_uring, false to use epoll (default)
 	 */
-	void initialize(unsigned int events, bool signal);
+	void initialize(unsigned int events, bool signal, bool uring = false);
 	//-----------------------------------------------------------------
 	/**
 	 * Adds a new file descriptor to the interest list.
@@ -96,6 +106,37 @@ public:
 	 */
 	void remove(int fd);
 	//-----------------------------------------------------------------
+	/**
+	 * Checks whether the completion-based stream IO is available (see
+	 * TRIGGER_STREAM). Requires the io_uring backend and Linux kernel version
+	 * 6.0 or later, the flag is ignored otherwise.
+	 * @return true if available, false otherwise
+	 */
+	bool streaming() const noexcept;
+	/**
+	 * Scatter read from a stream registered with the TRIGGER_STREAM flag:
+	 * copies out the data which has already been received.
+	 * @param fd file descriptor
+	 * @param vectors scatter input buffers
+	 * @param count input buffers count
+	 * @return number of bytes read on success, zero (0) on EOF, -1 on error
+	 * (errno is set to EAGAIN if no data is available).
+	 */
+	ssize_t receive(int fd, const iovec *vectors, unsigned int count);
+	/**
+	 * Gather write to a stream registered with the TRIGGER_STREAM flag. The
+	 * request gets submitted along with the next wait and its completion is
+	 * reported as the IO_WRITE event, the next call returns the result.
+	 * @note The caller must pass the same input until the result is returned.
+	 * The buffers must remain valid and unchanged until then.
+	 * @param fd file descriptor
+	 * @param vectors gather output buffers
+	 * @param count output buffers count
+	 * @return number of bytes written on success, -1 on error (errno is set
+	 * to EAGAIN while the request is in flight).
+	 */
+	ssize_t send(int fd, const iovec *vectors, unsigned int count);
+	//-----------------------------------------------------------------
 	/**
 	 * Waits for IO events, signal delivery, or timeout.
 	 * @param timeout wait period in milliseconds. Set to -1 (default) to block
@@ -133,15 +174,76 @@ public:
 	 */
 	static uint32_t events(const SelectionEvent *se) noexcept;
 private:
-	void create();
+	//Interest list entry of the io_uring backend
+	struct Registration {
+		void *handle;
+		uint32_t events;
+		uint32_t tag; //Zero (0) if not registered
+		//Completion-based stream IO
+		struct {
+			msghdr message; //Send request's header
+			ssize_t result; //Send request's result
+			uint32_t state;
+			int error; //Receive request's error
+			uint32_t head; //First received buffer
+			uint32_t tail; //Last received buffer
+			uint32_t offset; //Bytes consumed from the first buffer
+			uint32_t held; //Received buffers count
+		} stream;
+	};
+	//Provided buffer's bookkeeping
+	struct Slot {
+		uint32_t next;
+		uint32_t length;
+	};
+
+	void create(unsigned int events);
 	int close() noexcept;
+	//-----------------------------------------------------------------
+	int wait(int timeout);
+	unsigned int collect();
+	Registration* lookup(int fd, bool grow = false);
+	void arm(int fd, Registration &r);
+	void disarm(int fd, Registration &r);
+	uint32_t nextTag() noexcept;
+	//-----------------------------------------------------------------
+	void provide();
+	bool probe();
+	int complete(uint64_t key);
+	void release() noexcept;
+	uint32_t received(int fd, Registration &r, const io_uring_cqe *cqe);
+	uint32_t sent(int fd, Registration &r, int result);
+	void listen(int fd, Registration &r);
+	void watch(int fd, Registration &r);
+	void cancel(int fd, Registration &r);
+	void starve(int fd, Registration &r);
+	void recycle(uint32_t id);
+	void replenish();
 private:
 	sigset_t signals;
 	sigset_t *mask { };
 	int epfd { -1 };
 	Buffer<SelectionEvent> selected;
+	//The io_uring backend
+	bool uring { };
+	uint32_t tag { };
+	Ring ring;
+	Memory<Registration> registrations;
+	//Provided buffers of the stream IO
+	Memory<unsigned char> buffers;
+	Memory<Slot> slots;
+	unsigned int available { };
+	Memory<int> starved;
+	unsigned int starving { };
 	bool _interrupted { };
 	bool _expired { };
+	//Minimum size of the submission queue
+	static constexpr unsigned int RING_ENTRIES = 256;
+	//Provided buffers' count and size
+	static constexpr unsigned int BUFFER_COUNT = 1024;
+	static constexpr unsigned int BUFFER_SIZE = 4096;
+	//Received buffers a stream can hold before it stops receiving
+	static constexpr unsigned int HOLD_LIMIT = 16;
 };
 
 } /* namespace wanhive */
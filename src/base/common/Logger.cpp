@@ -11,9 +11,16 @@
  */
 
 #include "Logger.h"
-#include <cstdarg>
+#include "Atomic.h"
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
 #include <syslog.h>
+#include <unistd.h>
 
 namespace {
 
@@ -23,18 +30,78 @@ LOG_NOTICE, LOG_INFO, LOG_DEBUG };
 
 const char *levelNames[] = { "EMERGENCY", "ALERT", "CRITICAL", "ERROR",
 		"WARNING", "NOTICE", "INFO", "DEBUG" };
-const char *targetNames[] = { "STDERR", "SYSLOG" };
+const char *targetNames[] = { "STDERR", "SYSLOG", "FILE" };
+
+//Writer's batch size in bytes
+constexpr unsigned int BATCH_SIZE = 65536;
+//Writer's maximum sleep time in nanoseconds
+constexpr long IDLE_TIMEOUT = 100000000L;
+
+//Writes out the buffer, retries on interrupt and partial write
+void flush(int fd, const char *buffer, size_t count) noexcept {
+	while (count) {
+		auto n = ::write(fd, buffer, count);
+		if (n > 0) {
+			buffer += n;
+			count -= n;
+		} else if (n == -1 && errno == EINTR) {
+			continue;
+		} else {
+			return;
+		}
+	}
+}
+
 }  // namespace
 
 namespace wanhive {
 
+/*
+ * Bounded multi-producer single-consumer queue of formatted log records. Every
+ * record carries a sequence number which tells its state to the producers and
+ * the consumer, hence no lock is required.
+ */
+struct Journal {
+	struct Record {
+		unsigned long long sequence;
+		unsigned int length;
+		LogLevel level;
+		char text[Logger::RECORD_SIZE];
+	};
+
+	Record *records;
+	unsigned long long mask;
+	alignas(64) unsigned long long head; //Producers' position
+	alignas(64) unsigned long long tail; //Writer's position
+	alignas(64) unsigned long long dropped;
+	unsigned long long reported;
+	unsigned int idle; //Writer is waiting for records
+	unsigned int running;
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t wakeup;
+	const Logger *logger;
+	char batch[BATCH_SIZE];
+};
+//-----------------------------------------------------------------
 Logger::Logger() noexcept :
 		level(WH_LOGLEVEL_DEBUG), target(WH_LOG_STDERR) {
-
+	//Continuous logging must not starve a switch
+	pthread_rwlockattr_t attr;
+	pthread_rwlockattr_init(&attr);
+	pthread_rwlockattr_setkind_np(&attr,
+			PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+	pthread_rwlock_init(&lock, &attr);
+	pthread_rwlockattr_destroy(&attr);
 }
 
 Logger::~Logger() {
-
+	switchAsync(0);
+	if (fd != -1) {
+		::close(fd);
+		fd = -1;
+	}
+	pthread_rwlock_destroy(&lock);
 }
 
 void Logger::setLevel(unsigned int level) noexcept {
@@ -85,6 +152,9 @@ void Logger::setTarget(unsigned int target) noexcept {
 	case WH_LOG_SYS:
 		setTarget(WH_LOG_SYS);
 		break;
+	case WH_LOG_FILE:
+		setTarget(WH_LOG_FILE);
+		break;
 	default:
 		setTarget(WH_LOG_STDERR);
 		break;
@@ -99,21 +169,116 @@ LogTarget Logger::getTarget() const noexcept {
 	return target;
 }
 
+bool Logger::setFile(const char *path) noexcept {
+	int descriptor = -1;
+	if (path) {
+		descriptor = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+				0644);
+		if (descriptor == -1) {
+			return false;
+		}
+	}
+
+	//The writer must not be holding the old descriptor
+	pthread_rwlock_wrlock(&lock);
+	auto capacity = journal ? (journal->mask + 1) : 0;
+	switchAsync(0);
+	if (fd != -1) {
+		::close(fd);
+	}
+	fd = descriptor;
+	setTarget(path ? WH_LOG_FILE : WH_LOG_STDERR);
+	switchAsync(capacity);
+	pthread_rwlock_unlock(&lock);
+	return true;
+}
+
+bool Logger::setAsync(unsigned int capacity) noexcept {
+	pthread_rwlock_wrlock(&lock);
+	auto status = switchAsync(capacity);
+	pthread_rwlock_unlock(&lock);
+	return status;
+}
+
+bool Logger::switchAsync(unsigned int capacity) noexcept {
+	if (journal) {
+		//Drain the queue and stop the writer
+		Atomic<unsigned int>::store(&journal->running, 0, MO_RELEASE);
+		pthread_cond_signal(&journal->wakeup);
+		pthread_join(journal->thread, nullptr);
+		pthread_cond_destroy(&journal->wakeup);
+		pthread_mutex_destroy(&journal->mutex);
+		lost += journal->dropped;
+		delete[] journal->records;
+		delete journal;
+		journal = nullptr;
+	}
+
+	if (!capacity) {
+		return true;
+	}
+
+	unsigned long long size = 2;
+	while (size < capacity) {
+		size <<= 1;
+	}
+
+	auto j = new (std::nothrow) Journal;
+	if (!j) {
+		return false;
+	}
+	j->records = new (std::nothrow) Journal::Record[size];
+	if (!j->records) {
+		delete j;
+		return false;
+	}
+	for (unsigned long long i = 0; i < size; ++i) {
+		j->records[i].sequence = i;
+	}
+	j->mask = size - 1;
+	j->head = 0;
+	j->tail = 0;
+	j->dropped = 0;
+	j->reported = 0;
+	j->idle = 0;
+	j->running = 1;
+	j->mutex = PTHREAD_MUTEX_INITIALIZER;
+	j->wakeup = PTHREAD_COND_INITIALIZER;
+	j->logger = this;
+	if (pthread_create(&j->thread, nullptr, drain, j) != 0) {
+		delete[] j->records;
+		delete j;
+		return false;
+	}
+	journal = j;
+	return true;
+}
+
+bool Logger::isAsync() const noexcept {
+	return journal != nullptr;
+}
+
+unsigned long long Logger::dropped() const noexcept {
+	pthread_rwlock_rdlock(&lock);
+	auto count = lost;
+	if (journal) {
+		count += Atomic<unsigned long long>::load(&journal->dropped);
+	}
+	pthread_rwlock_unlock(&lock);
+	return count;
+}
+
 void Logger::log(LogLevel level, const char *format, ...) const noexcept {
 	if (level <= Logger::level) {
 		va_list ap;
 		va_start(ap, format);
-		switch (Logger::target) {
-		case WH_LOG_STDERR:
-			//POSIX-compliant vfprintf is thread safe
-			vfprintf(stderr, format, ap);
-			break;
-		case WH_LOG_SYS:
-			vsyslog(priorities[level], format, ap);
-			break;
-		default:
-			break;
+		pthread_rwlock_rdlock(&lock);
+		if (!journal) {
+			write(level, format, ap);
+		} else if (!post(level, format, ap)) {
+			Atomic<unsigned long long>::fetchAndAdd(&journal->dropped, 1);
 		}
+		pthread_rwlock_unlock(&lock);
 		va_end(ap);
 	} else {
 		return;
@@ -133,4 +298,154 @@ const char* Logger::targetString(LogTarget target) noexcept {
 	return targetNames[target];
 }
 
+void Logger::write(LogLevel level, const char *format,
+		va_list ap) const noexcept {
+	switch (Logger::target) {
+	case WH_LOG_STDERR:
+		//POSIX-compliant vfprintf is thread safe
+		vfprintf(stderr, format, ap);
+		break;
+	case WH_LOG_SYS:
+		vsyslog(priorities[level], format, ap);
+		break;
+	case WH_LOG_FILE:
+		if (fd != -1) {
+			vdprintf(fd, format, ap);
+		} else {
+			vfprintf(stderr, format, ap);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+bool Logger::post(LogLevel level, const char *format,
+		va_list ap) const noexcept {
+	using Sequence = Atomic<unsigned long long>;
+	auto j = journal;
+	//Claim a free record
+	auto position = Sequence::load(&j->head);
+	Journal::Record *record;
+	while (true) {
+		record = &j->records[position & j->mask];
+		auto sequence = Sequence::load(&record->sequence, MO_ACQUIRE);
+		auto diff = (long long) (sequence - position);
+		if (diff == 0) {
+			if (Sequence::compareExchange(&j->head, &position, position + 1,
+					MO_RELAXED, MO_RELAXED, true)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false; //Full
+		} else {
+			position = Sequence::load(&j->head);
+		}
+	}
+
+	//Format the message log and publish the record
+	auto n = vsnprintf(record->text, RECORD_SIZE, format, ap);
+	if (n < 0) {
+		record->length = 0;
+	} else if ((unsigned int) n >= RECORD_SIZE) {
+		record->length = RECORD_SIZE - 1;
+		record->text[RECORD_SIZE - 2] = '\n';
+	} else {
+		record->length = n;
+	}
+	record->level = level;
+	Sequence::store(&record->sequence, position + 1, MO_RELEASE);
+
+	//Wake up the writer only if it is waiting
+	if (Atomic<unsigned int>::load(&j->idle, MO_SEQ_CST)) {
+		pthread_cond_signal(&j->wakeup);
+	}
+	return true;
+}
+
+void* Logger::drain(void *arg) noexcept {
+	using Sequence = Atomic<unsigned long long>;
+	auto j = static_cast<Journal*>(arg);
+	auto logger = j->logger;
+	size_t used = 0;
+	auto output = [&]() {
+		return (logger->target == WH_LOG_FILE && logger->fd != -1) ?
+				logger->fd : STDERR_FILENO;
+	};
+
+	while (true) {
+		unsigned int count = 0;
+		while (true) {
+			auto record = &j->records[j->tail & j->mask];
+			if (Sequence::load(&record->sequence, MO_ACQUIRE)
+					!= (j->tail + 1)) {
+				break;
+			}
+
+			if (logger->target == WH_LOG_SYS) {
+				syslog(priorities[record->level], "%.*s", (int) record->length,
+						record->text);
+			} else {
+				if (used + record->length > BATCH_SIZE) {
+					flush(output(), j->batch, used);
+					used = 0;
+				}
+				memcpy(j->batch + used, record->text, record->length);
+				used += record->length;
+			}
+			Sequence::store(&record->sequence, j->tail + j->mask + 1,
+					MO_RELEASE);
+			++j->tail;
+			++count;
+		}
+
+		auto dropped = Sequence::load(&j->dropped);
+		if (dropped != j->reported) {
+			char note[128];
+			auto n = snprintf(note, sizeof(note),
+					"[%s]: %llu message logs dropped\n",
+					levelNames[WH_LOGLEVEL_WARNING], (dropped - j->reported));
+			j->reported = dropped;
+			if (logger->target == WH_LOG_SYS) {
+				syslog(priorities[WH_LOGLEVEL_WARNING], "%s", note);
+			} else if (n > 0) {
+				flush(output(), j->batch, used);
+				used = 0;
+				flush(output(), note, n);
+			}
+		}
+
+		if (count) {
+			continue;
+		}
+
+		//The queue is empty
+		if (used) {
+			flush(output(), j->batch, used);
+			used = 0;
+		}
+
+		if (!Atomic<unsigned int>::load(&j->running, MO_ACQUIRE)) {
+			break;
+		}
+
+		Atomic<unsigned int>::store(&j->idle, 1, MO_SEQ_CST);
+		auto record = &j->records[j->tail & j->mask];
+		if (Sequence::load(&record->sequence, MO_SEQ_CST) != (j->tail + 1)) {
+			timespec ts;
+			clock_gettime(CLOCK_REALTIME, &ts);
+			ts.tv_nsec += IDLE_TIMEOUT;
+			if (ts.tv_nsec >= 1000000000L) {
+				ts.tv_sec += 1;
+				ts.tv_nsec -= 1000000000L;
+			}
+			pthread_mutex_lock(&j->mutex);
+			pthread_cond_timedwait(&j->wakeup, &j->mutex, &ts);
+			pthread_mutex_unlock(&j->mutex);
+		}
+		Atomic<unsigned int>::store(&j->idle, 0, MO_SEQ_CST);
+	}
+	return nullptr;
+}
+
 } /* namespace wanhive */
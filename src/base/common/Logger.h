@@ -13,6 +13,8 @@
 #ifndef WH_BASE_COMMON_LOGGER_H_
 #define WH_BASE_COMMON_LOGGER_H_
 #include "defines.h"
+#include <cstdarg>
+#include <pthread.h>
 
 /*! @namespace wanhive */
 namespace wanhive {
@@ -35,11 +37,19 @@ enum LogLevel : unsigned char {
  */
 enum LogTarget : unsigned char {
 	WH_LOG_STDERR,/**< Use stderr */
-	WH_LOG_SYS /**< Use syslog */
+	WH_LOG_SYS, /**< Use syslog */
+	WH_LOG_FILE /**< Use a log file */
 };
 
+/*
+ * Queue of formatted log records (see Logger::setAsync())
+ */
+struct Journal;
+
 /**
- * Thread-safe logging utility
+ * Thread-safe logging utility. Message logs are written synchronously by the
+ * calling thread, or formatted into a bounded lock-free queue which is drained
+ * by a background writer thread (asynchronous mode).
  */
 class Logger {
 public:
@@ -71,7 +81,8 @@ public:
 	LogLevel getLevel() const noexcept;
 	/**
 	 * Sets the default message logs output target. Set zero (0) to select
-	 * stderr and set any other value to select the syslog facility.
+	 * stderr, one (1) to select the syslog facility, and two (2) to select the
+	 * log file (see Logger::setFile()). Any other value selects stderr.
 	 * @param target target code
 	 */
 	void setTarget(unsigned int target) noexcept;
@@ -85,6 +96,36 @@ public:
 	 * @return target code
 	 */
 	LogTarget getTarget() const noexcept;
+	/**
+	 * Opens a log file in append mode and selects it as the output target.
+	 * Closes the log file and selects stderr if the path is nullptr.
+	 * @note The logging threads wait while the output is switched.
+	 * @param path log file's pathname
+	 * @return true on success, false on error (the target is not changed)
+	 */
+	bool setFile(const char *path) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Switches to the asynchronous mode: the calling threads format the message
+	 * logs into a bounded lock-free queue and a background thread writes them
+	 * out in batches. Message logs are dropped (and counted) if the queue is
+	 * full. Capacity zero (0) drains the queue and restores the synchronous mode.
+	 * @note The logging threads wait while the mode is switched.
+	 * @param capacity queue's capacity in records (rounded up to power of two)
+	 * @return true on success, false on error (the mode is not changed)
+	 */
+	bool setAsync(unsigned int capacity) noexcept;
+	/**
+	 * Checks whether the asynchronous mode is enabled.
+	 * @return true if the message logs are written asynchronously
+	 */
+	bool isAsync() const noexcept;
+	/**
+	 * Returns the number of message logs dropped due to a full queue.
+	 * @return dropped message logs count
+	 */
+	unsigned long long dropped() const noexcept;
+	//-----------------------------------------------------------------
 	/**
 	 * Writes a message log.
 	 * @param level message's priority
@@ -109,9 +150,22 @@ public:
 	 * @return string description
 	 */
 	static const char* targetString(LogTarget target) noexcept;
+private:
+	void write(LogLevel level, const char *format, va_list ap) const noexcept;
+	bool post(LogLevel level, const char *format, va_list ap) const noexcept;
+	bool switchAsync(unsigned int capacity) noexcept;
+	static void* drain(void *arg) noexcept;
+public:
+	/*! Maximum length of an asynchronous message log (truncated if longer) */
+	static constexpr unsigned int RECORD_SIZE = 1024;
 private:
 	volatile LogLevel level;
 	volatile LogTarget target;
+	int fd { -1 };
+	Journal *journal { };
+	unsigned long long lost { };
+	//Held for reading while logging, for writing while switching the output
+	mutable pthread_rwlock_t lock;
 };
 
 //=================================================================
@@ -63,6 +63,33 @@ DBHealth DataStore::health() const noexcept {
 	return Postgres::health(db.conn);
 }
 
+void DataStore::pipeline() {
+	if (PQpipelineStatus(db.conn) != PQ_PIPELINE_OFF) {
+		return;
+	} else if (PQsetnonblocking(db.conn, 1) || !PQenterPipelineMode(db.conn)) {
+		throw Exception(EX_RESOURCE);
+	}
+}
+
+bool DataStore::flush() {
+	auto status = PQflush(db.conn);
+	if (status == -1) {
+		throw Exception(EX_RESOURCE);
+	} else {
+		return status == 0;
+	}
+}
+
+void DataStore::consume() {
+	if (!PQconsumeInput(db.conn)) {
+		throw Exception(EX_RESOURCE);
+	}
+}
+
+int DataStore::socket() const noexcept {
+	return PQsocket(db.conn);
+}
+
 bool DataStore::ping(const DBInfo &info) noexcept {
 	return Postgres::ping(info);
 }
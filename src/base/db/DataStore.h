@@ -69,6 +69,29 @@ public:
 	 * @return health code
 	 */
 	DBHealth health() const noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Switches the database connection to the non-blocking pipeline mode, in
+	 * which the queries are sent without waiting for the results of the
+	 * previous ones. The connection must be idle.
+	 */
+	void pipeline();
+	/**
+	 * Sends the queued queries to the database server (pipeline mode).
+	 * @return true if all the queued data has been sent, false if the
+	 * operation would block (wait for the socket to become writable).
+	 */
+	bool flush();
+	/**
+	 * Reads the available data from the database server (pipeline mode).
+	 */
+	void consume();
+	/**
+	 * Returns the database connection's socket file descriptor.
+	 * @return file descriptor, -1 if not connected
+	 */
+	int socket() const noexcept;
+	//-----------------------------------------------------------------
 	/**
 	 * Checks connection parameters and database server's status.
 	 * @param info connection parameters
@@ -0,0 +1,132 @@
+/*
+ * Histogram.cpp
+ *
+ * Log-linear histogram
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "Histogram.h"
+#include <cstring>
+
+namespace wanhive {
+
+Histogram::Histogram() noexcept {
+	reset();
+}
+
+Histogram::~Histogram() {
+
+}
+
+void Histogram::record(unsigned long long value,
+		unsigned long long count) noexcept {
+	if (!count) {
+		return;
+	}
+
+	counts[index(value)] += count;
+	if (!total || value < smallest) {
+		smallest = value;
+	}
+	if (value > largest) {
+		largest = value;
+	}
+	total += count;
+	sum += ((double) value * count);
+}
+
+void Histogram::merge(const Histogram &other) noexcept {
+	if (!other.total) {
+		return;
+	}
+
+	for (unsigned int i = 0; i < BUCKETS; ++i) {
+		counts[i] += other.counts[i];
+	}
+	if (!total || other.smallest < smallest) {
+		smallest = other.smallest;
+	}
+	if (other.largest > largest) {
+		largest = other.largest;
+	}
+	total += other.total;
+	sum += other.sum;
+}
+
+void Histogram::reset() noexcept {
+	memset(counts, 0, sizeof(counts));
+	total = 0;
+	smallest = 0;
+	largest = 0;
+	sum = 0;
+}
+
+unsigned long long Histogram::count() const noexcept {
+	return total;
+}
+
+unsigned long long Histogram::min() const noexcept {
+	return smallest;
+}
+
+unsigned long long Histogram::max() const noexcept {
+	return largest;
+}
+
+double Histogram::mean() const noexcept {
+	return total ? (sum / total) : 0;
+}
+
+unsigned long long Histogram::percentile(double percentile) const noexcept {
+	if (!total) {
+		return 0;
+	} else if (percentile > 100) {
+		percentile = 100;
+	} else if (percentile < 0) {
+		percentile = 0;
+	}
+
+	//Rank of the requested value (at least one)
+	auto rank = (unsigned long long) ((percentile / 100) * total + 0.5);
+	rank = rank ? rank : 1;
+
+	unsigned long long seen = 0;
+	for (unsigned int i = index(smallest); i < BUCKETS; ++i) {
+		seen += counts[i];
+		if (seen >= rank) {
+			auto value = highest(i);
+			return (value < largest) ? value : largest;
+		}
+	}
+	return largest;
+}
+
+unsigned int Histogram::index(unsigned long long value) noexcept {
+	if (value < SUB_BUCKETS) {
+		return (unsigned int) value;
+	} else {
+		//Position of the most significant bit (>= PRECISION)
+		unsigned int msb = 63 - __builtin_clzll(value);
+		unsigned int shift = msb - PRECISION;
+		unsigned int sub = (unsigned int) (value >> shift) & (SUB_BUCKETS - 1);
+		return ((shift + 1) * SUB_BUCKETS) + sub;
+	}
+}
+
+unsigned long long Histogram::highest(unsigned int index) noexcept {
+	if (index < SUB_BUCKETS) {
+		return index;
+	} else {
+		unsigned int shift = (index / SUB_BUCKETS) - 1;
+		unsigned long long sub = (index % SUB_BUCKETS);
+		auto lowest = ((SUB_BUCKETS + sub) << shift);
+		return lowest + ((1ULL << shift) - 1);
+	}
+}
+
+} /* namespace wanhive */
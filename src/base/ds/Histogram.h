@@ -0,0 +1,99 @@
+/**
+ * @file Histogram.h
+ *
+ * Log-linear histogram
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_BASE_DS_HISTOGRAM_H_
+#define WH_BASE_DS_HISTOGRAM_H_
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Log-linear (HDR style) histogram of non-negative integral values. Every
+ * power-of-two range is split into a fixed number of linear sub-buckets, hence
+ * the relative error of a reported value stays below 1/SUB_BUCKETS.
+ * @note Recording is a constant time operation without allocation. The bucket
+ * array takes about 58 KB, allocate the histograms along with their owners.
+ */
+class Histogram {
+public:
+	/**
+	 * Constructor: creates an empty histogram.
+	 */
+	Histogram() noexcept;
+	/**
+	 * Destructor
+	 */
+	~Histogram();
+	//-----------------------------------------------------------------
+	/**
+	 * Records a value.
+	 * @param value the recorded value
+	 * @param count number of occurrences of the value
+	 */
+	void record(unsigned long long value, unsigned long long count = 1) noexcept;
+	/**
+	 * Adds another histogram's recorded values to this histogram.
+	 * @param other the histogram to merge
+	 */
+	void merge(const Histogram &other) noexcept;
+	/**
+	 * Clears out all the recorded values.
+	 */
+	void reset() noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns the number of recorded values.
+	 * @return values count
+	 */
+	unsigned long long count() const noexcept;
+	/**
+	 * Returns the smallest recorded value.
+	 * @return minimum value, 0 if the histogram is empty
+	 */
+	unsigned long long min() const noexcept;
+	/**
+	 * Returns the largest recorded value.
+	 * @return maximum value, 0 if the histogram is empty
+	 */
+	unsigned long long max() const noexcept;
+	/**
+	 * Returns the arithmetic mean of the recorded values.
+	 * @return mean value, 0 if the histogram is empty
+	 */
+	double mean() const noexcept;
+	/**
+	 * Returns the value at a given percentile (the largest value equivalent to
+	 * the bucket where the percentile falls, capped at the maximum).
+	 * @param percentile the percentile in the range [0, 100]
+	 * @return value at the percentile, 0 if the histogram is empty
+	 */
+	unsigned long long percentile(double percentile) const noexcept;
+private:
+	static unsigned int index(unsigned long long value) noexcept;
+	static unsigned long long highest(unsigned int index) noexcept;
+public:
+	/*! Bits of precision within a power-of-two range (relative error < 1%) */
+	static constexpr unsigned int PRECISION = 7;
+	/*! Number of linear sub-buckets per power-of-two range */
+	static constexpr unsigned int SUB_BUCKETS = (1U << PRECISION);
+	/*! Total number of buckets (covers the full 64-bit range) */
+	static constexpr unsigned int BUCKETS = (64 - PRECISION + 1) * SUB_BUCKETS;
+private:
+	unsigned long long counts[BUCKETS];
+	unsigned long long total { };
+	unsigned long long smallest { };
+	unsigned long long largest { };
+	double sum { };
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_BASE_DS_HISTOGRAM_H_ */
@@ -16,22 +16,74 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <sys/mman.h>
 
 namespace {
 
 //Desired alignment of each block
 static constexpr unsigned int ALIGNMENT = (alignof(max_align_t));
+//Each block is preceded by the address of it's slab
+static constexpr size_t PREFIX = ALIGNMENT;
+//Size of a huge page (2MB)
+static constexpr size_t HUGE_PAGE_SIZE = (2UL << 20);
+//Flag for requesting the 2MB huge pages
+static constexpr int HUGE_PAGE_FLAG = (21 << MAP_HUGE_SHIFT);
+
+/*
+ * Maps <bytes> of memory backed by huge pages, updates <bytes> to the actual
+ * size of the mapping, and returns the type of pages in <type>.
+ */
+void* mapPages(size_t &bytes, wanhive::MemoryPage &type) noexcept {
+	bytes = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+	//Explicit huge pages, the kernel pre-faults them
+	auto p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | HUGE_PAGE_FLAG
+					| MAP_POPULATE, -1, 0);
+	if (p != MAP_FAILED) {
+		type = wanhive::PAGE_HUGE;
+		return p;
+	}
+
+	//Fall back to the transparent huge pages
+	p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED) {
+		return nullptr;
+	}
+
+	if (::madvise(p, bytes, MADV_HUGEPAGE) == 0) {
+		type = wanhive::PAGE_TRANSPARENT;
+	} else {
+		type = wanhive::PAGE_REGULAR;
+	}
+	//Pre-fault the pages on the calling thread
+	memset(p, 0, bytes);
+	return p;
+}
 
 }  // namespace
 
 namespace wanhive {
 
+struct MemoryPool::Slab {
+	Slab *next; //Next slab of the pool
+	Slab *prev; //Previous slab having free blocks
+	Slab *succ; //Next slab having free blocks
+	void *head; //Linked list of free blocks
+	unsigned int used; //Allocated blocks
+	unsigned int count; //Total blocks
+	size_t bytes; //Slab's size
+	bool mapped; //Memory mapped (otherwise heap allocated)
+	MemoryPage type; //Type of memory pages
+};
+
 MemoryPool::MemoryPool() noexcept {
 
 }
 
-MemoryPool::MemoryPool(unsigned int size, unsigned int count) {
-	initialize(size, count);
+MemoryPool::MemoryPool(unsigned int size, unsigned int count, bool huge,
+		unsigned int limit) {
+	initialize(size, count, huge, limit);
 }
 
 MemoryPool::~MemoryPool() {
@@ -40,7 +92,8 @@ MemoryPool::~MemoryPool() {
 	}
 }
 
-void MemoryPool::initialize(unsigned int size, unsigned int count) {
+void MemoryPool::initialize(unsigned int size, unsigned int count, bool huge,
+		unsigned int limit) {
 	if (isInitialized()) {
 		throw Exception(EX_OPERATION);
 	} else if (!size && count) {
@@ -49,46 +102,90 @@ void MemoryPool::initialize(unsigned int size, unsigned int count) {
 		return;
 	}
 
-	size = Twiddler::align(size, Twiddler::power2Ceil(ALIGNMENT));
-	if ((_bucket = calloc(count, size)) == nullptr) {
-		throw Exception(EX_MEMORY);
+	_blockSize = Twiddler::align(size, Twiddler::power2Ceil(ALIGNMENT));
+	_slabSize = count;
+	_limit = Twiddler::max(count, limit);
+	_huge = huge;
+	try {
+		auto slab = create(count);
+		prepend(slab);
+		_slabSize = slab->count;
+		_pageType = slab->type;
+	} catch (const BaseException &e) {
+		destroy();
+		throw;
 	}
-
-	_head = _bucket;
-	_capacity = count;
-	_blockSize = size;
-
-	/*
-	 * Linked list of unallocated blocks
-	 */
-	auto block = (char*) _bucket;
-	while (--count != 0) {
-		auto next = block + size;
-		*(void**) block = next;
-		block = next;
-	}
-	*(void**) block = nullptr;
 }
 
 unsigned int MemoryPool::destroy() noexcept {
 	auto ret = _allocated;
-	if (_bucket) {
-		memset(_bucket, 0, ((size_t) _capacity) * _blockSize);
+	while (_slabs) {
+		auto slab = _slabs;
+		_slabs = slab->next;
+		release(slab);
 	}
-	free(_bucket);
-	_bucket = nullptr;
-	_head = nullptr;
+
+	_first = nullptr;
+	_last = nullptr;
 	_allocated = 0;
 	_capacity = 0;
+	_limit = 0;
 	_blockSize = 0;
+	_slabSize = 0;
+	_huge = false;
+	_pageType = PAGE_REGULAR;
 	return ret;
 }
 
+unsigned int MemoryPool::shrink() noexcept {
+	//Idle slabs gather at the end of the list
+	auto slab = _last;
+	if (!slab || slab->used || !slab->next) {
+		//Nothing to release (the initial slab is at the end of the chain)
+		return 0;
+	} else if ((_capacity - _allocated - slab->count) < _slabSize) {
+		//Keep some free blocks in reserve
+		return 0;
+	}
+
+	detach(slab);
+	for (auto p = &_slabs; *p; p = &(*p)->next) {
+		if (*p == slab) {
+			*p = slab->next;
+			break;
+		}
+	}
+
+	auto count = slab->count;
+	_capacity -= count;
+	release(slab);
+	return count;
+}
+
+unsigned int MemoryPool::available() noexcept {
+	if ((_capacity - _allocated) <= (_slabSize / 2) && _capacity < _limit) {
+		//Keeps the reserve, shrink() doesn't release it
+		auto slab = grow();
+		if (slab) {
+			detach(slab);
+			append(slab);
+		}
+	}
+	return _capacity - _allocated;
+}
+
 void* MemoryPool::allocate() noexcept {
-	auto result = _head;
-	if (result) {
-		_head = *(void**) _head;
-		++_allocated;
+	auto slab = _first;
+	if (!slab && !(slab = grow())) {
+		return nullptr;
+	}
+
+	auto result = slab->head;
+	slab->head = *(void**) result;
+	++slab->used;
+	++_allocated;
+	if (!slab->head) {
+		detach(slab);
 	}
 	return result;
 }
@@ -98,9 +195,23 @@ void MemoryPool::deallocate(void *p) noexcept {
 		if (_allocated == 0) {
 			abort();
 		}
+
+		auto slab = *(Slab**) ((char*) p - PREFIX);
+		auto full = !slab->head;
+		*(void**) p = slab->head;
+		slab->head = p;
+		--slab->used;
 		--_allocated;
-		*(void**) p = _head;
-		_head = p;
+
+		if (!slab->used && slab->next) {
+			//An idle slab (not the initial one) goes to the end
+			if (!full) {
+				detach(slab);
+			}
+			append(slab);
+		} else if (full) {
+			prepend(slab);
+		}
 	}
 }
 
@@ -112,12 +223,132 @@ unsigned int MemoryPool::capacity() const noexcept {
 	return _capacity;
 }
 
+unsigned int MemoryPool::limit() const noexcept {
+	return _limit;
+}
+
 unsigned int MemoryPool::blockSize() const noexcept {
 	return _blockSize;
 }
 
+MemoryPage MemoryPool::pageType() const noexcept {
+	return _pageType;
+}
+
 bool MemoryPool::isInitialized() const noexcept {
-	return _bucket;
+	return _slabs;
+}
+
+MemoryPool::Slab* MemoryPool::create(unsigned int count) {
+	auto offset = Twiddler::align(sizeof(Slab), ALIGNMENT);
+	auto stride = PREFIX + _blockSize;
+	size_t bytes = offset + (count * stride);
+
+	void *p = nullptr;
+	MemoryPage type = PAGE_REGULAR;
+	if (_huge) {
+		p = mapPages(bytes, type);
+	} else {
+		p = calloc(1, bytes);
+	}
+
+	if (!p) {
+		throw Exception(EX_MEMORY);
+	} else if (_huge) {
+		//Fill up the rounded up mapping
+		count = (bytes - offset) / stride;
+	}
+
+	auto slab = (Slab*) p;
+	slab->next = _slabs;
+	slab->prev = nullptr;
+	slab->succ = nullptr;
+	slab->used = 0;
+	slab->count = count;
+	slab->bytes = bytes;
+	slab->mapped = _huge;
+	slab->type = type;
+
+	/*
+	 * Linked list of unallocated blocks
+	 */
+	auto block = (char*) p + offset;
+	slab->head = block + PREFIX;
+	while (count--) { //postfix --
+		auto next = block + stride;
+		*(Slab**) block = slab;
+		*(void**) (block + PREFIX) = count ? (next + PREFIX) : nullptr;
+		block = next;
+	}
+
+	_slabs = slab;
+	_capacity += slab->count;
+	_limit = Twiddler::max(_limit, _capacity);
+	return slab;
+}
+
+MemoryPool::Slab* MemoryPool::grow() noexcept {
+	if (_capacity >= _limit) {
+		return nullptr;
+	}
+
+	try {
+		auto slab = create(Twiddler::min(_slabSize, _limit - _capacity));
+		prepend(slab);
+		return slab;
+	} catch (const BaseException &e) {
+		return nullptr;
+	}
+}
+
+void MemoryPool::release(Slab *slab) noexcept {
+	auto bytes = slab->bytes;
+	auto mapped = slab->mapped;
+	memset((void*) slab, 0, bytes);
+	if (mapped) {
+		::munmap(slab, bytes);
+	} else {
+		free(slab);
+	}
+}
+
+void MemoryPool::prepend(Slab *slab) noexcept {
+	slab->prev = nullptr;
+	slab->succ = _first;
+	if (_first) {
+		_first->prev = slab;
+	} else {
+		_last = slab;
+	}
+	_first = slab;
+}
+
+void MemoryPool::append(Slab *slab) noexcept {
+	slab->succ = nullptr;
+	slab->prev = _last;
+	if (_last) {
+		_last->succ = slab;
+	} else {
+		_first = slab;
+	}
+	_last = slab;
+}
+
+void MemoryPool::detach(Slab *slab) noexcept {
+	if (slab->prev) {
+		slab->prev->succ = slab->succ;
+	} else {
+		_first = slab->succ;
+	}
+
+	if (slab->succ) {
+		slab->succ->prev = slab->prev;
+	} else {
+		_last = slab->prev;
+	}
+
+	slab->prev = nullptr;
+	slab->succ = nullptr;
 }
 
 } /* namespace wanhive */
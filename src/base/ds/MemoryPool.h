@@ -13,12 +13,26 @@
 #ifndef WH_BASE_DS_MEMORYPOOL_H_
 #define WH_BASE_DS_MEMORYPOOL_H_
 #include "../common/NonCopyable.h"
+#include <cstddef>
 
 /*! @namespace wanhive */
 namespace wanhive {
+//-----------------------------------------------------------------
+/**
+ * Enumeration of memory page types backing a memory pool
+ */
+enum MemoryPage : unsigned char {
+	PAGE_REGULAR,/**< Regular pages (heap allocation) */
+	PAGE_TRANSPARENT,/**< Transparent huge pages (best effort) */
+	PAGE_HUGE /**< Explicit huge pages (hugetlbfs) */
+};
+//-----------------------------------------------------------------
 /**
  * Memory pool for efficient memory allocation and deallocation.
  * Trades-off safety and versatility for speed.
+ * @note Memory is organized in slabs, each slab maintains its own list of free
+ * blocks. An elastic memory pool grows on demand by adding new slabs up to a
+ * limit, and shrinks on request by releasing the idle slabs.
  */
 class MemoryPool: private NonCopyable {
 public:
@@ -30,8 +44,12 @@ public:
 	 * Constructor: creates a memory pool
 	 * @param size size of each memory block
 	 * @param count number of memory blocks
+	 * @param huge true to back the memory pool with huge pages
+	 * @param limit maximum number of memory blocks (the memory pool grows on
+	 * demand if this value exceeds the initial count).
 	 */
-	MemoryPool(unsigned int size, unsigned int count);
+	MemoryPool(unsigned int size, unsigned int count, bool huge = false,
+			unsigned int limit = 0);
 	/**
 	 * Destructor: calls abort() on memory leak
 	 */
@@ -40,14 +58,39 @@ public:
 	 * Initializes the memory pool if not already initialized.
 	 * @param size size of each memory block
 	 * @param count number of memory blocks (0 will result in no-op)
+	 * @param huge true to back the memory pool with huge pages. Explicit huge
+	 * pages are tried first, transparent huge pages are used as the fallback.
+	 * The memory is pre-faulted by the calling thread, hence, on a NUMA system
+	 * it gets placed on the calling thread's node (first-touch policy).
+	 * @param limit maximum number of memory blocks. If this value exceeds the
+	 * initial count, then the memory pool grows on demand by adding slabs of
+	 * the initial count's size. A slab backed by huge pages holds as many
+	 * blocks as fit into its (rounded up) size, hence, the count and the limit
+	 * may get raised.
 	 */
-	void initialize(unsigned int size, unsigned int count);
+	void initialize(unsigned int size, unsigned int count, bool huge = false,
+			unsigned int limit = 0);
 	/**
 	 * Frees the memory pool. On success, the memory pool can be reinitialized.
 	 * @return number of memory blocks still in use. Non-zero value indicates a
 	 * memory leak and/or an imminent segmentation fault.
 	 */
 	unsigned int destroy() noexcept;
+	/**
+	 * Releases an idle slab added during the memory pool's growth. A slab is
+	 * released only if enough free memory blocks remain available after its
+	 * release (prevents thrashing). The initial slab is never released.
+	 * @return number of memory blocks released
+	 */
+	unsigned int shrink() noexcept;
+	/**
+	 * Returns the number of free memory blocks in the allocated slabs. Adds a
+	 * slab if at most half a slab's worth of free blocks remain (and the
+	 * limit permits), hence, the returned value accounts for a growth only if
+	 * it succeeded.
+	 * @return number of memory blocks available for allocation
+	 */
+	unsigned int available() noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Allocates a memory block.
@@ -68,14 +111,24 @@ public:
 	unsigned int allocated() const noexcept;
 	/**
 	 * Returns the total number of memory blocks including the allocated ones.
-	 * @return this memory pool's capacity
+	 * @return this memory pool's current capacity
 	 */
 	unsigned int capacity() const noexcept;
+	/**
+	 * Returns the maximum number of memory blocks this memory pool can grow to.
+	 * @return this memory pool's capacity limit
+	 */
+	unsigned int limit() const noexcept;
 	/**
 	 * Returns the size of each memory block.
 	 * @return memory block's size
 	 */
 	unsigned int blockSize() const noexcept;
+	/**
+	 * Returns the type of memory pages backing this memory pool.
+	 * @return memory page type
+	 */
+	MemoryPage pageType() const noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Returns the memory pool's initialization status.
@@ -83,11 +136,25 @@ public:
 	 */
 	bool isInitialized() const noexcept;
 private:
-	void *_bucket { };
-	void *_head { };
+	struct Slab;
+	Slab* create(unsigned int count);
+	Slab* grow() noexcept;
+	void release(Slab *slab) noexcept;
+	//Linked list of slabs having free blocks
+	void prepend(Slab *slab) noexcept;
+	void append(Slab *slab) noexcept;
+	void detach(Slab *slab) noexcept;
+private:
+	Slab *_slabs { };
+	Slab *_first { };
+	Slab *_last { };
 	unsigned int _allocated { };
 	unsigned int _capacity { };
+	unsigned int _limit { };
 	unsigned int _blockSize { };
+	unsigned int _slabSize { };
+	bool _huge { };
+	MemoryPage _pageType { PAGE_REGULAR };
 };
 
 } /* namespace wanhive */
@@ -36,27 +36,49 @@ public:
 	/**
 	 * Initializes the object pool.
 	 * @param count number of objects
+	 * @param huge true to back the pool with huge pages
+	 * @param limit maximum number of objects (the pool grows on demand if this
+	 * value exceeds the initial count).
 	 */
-	static void initPool(unsigned int count);
+	static void initPool(unsigned int count, bool huge = false,
+			unsigned int limit = 0);
 	/**
 	 * Destroys the object pool.
 	 */
 	static void destroyPool();
 	/**
-	 * Returns the capacity.
+	 * Releases an idle portion of a grown pool.
+	 * @return number of object slots released
+	 */
+	static unsigned int trimPool() noexcept;
+	/**
+	 * Returns the current capacity (objects which fit into the allocated
+	 * memory).
 	 * @return pool's capacity
 	 */
 	static unsigned int poolSize() noexcept;
+	/**
+	 * Returns the maximum capacity (the pool may grow up to this size).
+	 * @return pool's capacity limit
+	 */
+	static unsigned int poolLimit() noexcept;
 	/**
 	 * Returns the number of objects currently allocated.
 	 * @return allocated objects count
 	 */
 	static unsigned int allocated() noexcept;
 	/**
-	 * Returns the number of additional objects which can be allocated.
+	 * Returns the number of additional objects which can be allocated from
+	 * the allocated memory. Grows the pool ahead of demand if it is about to
+	 * run out of space, a failed growth is reflected in the returned value.
 	 * @return unallocated objects count
 	 */
 	static unsigned int unallocated() noexcept;
+	/**
+	 * Returns the type of memory pages backing the pool.
+	 * @return memory page type
+	 */
+	static MemoryPage pageType() noexcept;
 protected:
 	/**
 	 * The new operator that works with the preallocated memory pool.
@@ -83,8 +105,9 @@ wanhive::Pooled<X>::Pooled(char c) noexcept {
 }
 
 template<typename X>
-void wanhive::Pooled<X>::initPool(unsigned int count) {
-	pool.initialize(sizeof(X), count);
+void wanhive::Pooled<X>::initPool(unsigned int count, bool huge,
+		unsigned int limit) {
+	pool.initialize(sizeof(X), count, huge, limit);
 }
 
 template<typename X>
@@ -94,11 +117,21 @@ void wanhive::Pooled<X>::destroyPool() {
 	}
 }
 
+template<typename X>
+unsigned int wanhive::Pooled<X>::trimPool() noexcept {
+	return pool.shrink();
+}
+
 template<typename X>
 unsigned int wanhive::Pooled<X>::poolSize() noexcept {
 	return pool.capacity();
 }
 
+template<typename X>
+unsigned int wanhive::Pooled<X>::poolLimit() noexcept {
+	return pool.limit();
+}
+
 template<typename X>
 unsigned int wanhive::Pooled<X>::allocated() noexcept {
 	return pool.allocated();
@@ -106,7 +139,12 @@ unsigned int wanhive::Pooled<X>::allocated() noexcept {
 
 template<typename X>
 unsigned int wanhive::Pooled<X>::unallocated() noexcept {
-	return poolSize() - allocated();
+	return pool.available();
+}
+
+template<typename X>
+wanhive::MemoryPage wanhive::Pooled<X>::pageType() noexcept {
+	return pool.pageType();
 }
 
 template<typename X>
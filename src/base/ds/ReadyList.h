@@ -146,6 +146,16 @@ public:
 		}
 	}
 
+	/**
+	 * Returns a pointer to the first element. The elements are stored in a
+	 * contiguous array of ReadyList::readSpace() elements.
+	 * @return elements' base address (nullptr if the container was never
+	 * expanded)
+	 */
+	const T* array() const noexcept {
+		return storage;
+	}
+
 	/**
 	 * Inserts a value into the container (automatically expands the container
 	 * on overflow).
@@ -0,0 +1,713 @@
+/**
+ * @file Swiss.h
+ *
+ * Open addressing hash table with SIMD probing
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_BASE_DS_SWISS_H_
+#define WH_BASE_DS_SWISS_H_
+#include "functors.h"
+#include "Twiddler.h"
+#include "../common/Memory.h"
+#include <cstdint>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Hash table of POD (plain old data) types.
+ * @note Open addressing hash table modeled after the SwissTable design. Each
+ * bucket has a control byte which stores seven bits of the key's hash value
+ * or a marker (empty/deleted). Control bytes are probed in groups of sixteen
+ * using SSE2 instructions (portable fallback on other architectures). The
+ * control bytes are stored in a separate array, hence, a miss rarely touches
+ * the slots. Each slot holds a key and its value together, hence, a hit
+ * costs one slot access. The probe starts from the group selected by the
+ * hash value's low bits (less the lowest four), hence, sequential keys fill
+ * up the adjacent buckets (as in wanhive::Khash), and the control bytes get
+ * seven well mixed bits. Offers the same interface as wanhive::Khash.
+ * @ref https://abseil.io/about/design/swisstables
+ * @tparam KEY key's type
+ * @tparam VALUE value's type
+ * @tparam ISMAP true for hash map, false for hash set
+ * @tparam HFN hash functor (returns unsigned int hash value of a key)
+ * @tparam EQFN equality functor (returns true on equal keys, false otherwise)
+ */
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN> class Swiss: private NonCopyable {
+public:
+	/**
+	 * Default constructor: creates an empty hash table.
+	 */
+	Swiss() noexcept;
+	/**
+	 * Destructor
+	 */
+	~Swiss();
+	//-----------------------------------------------------------------
+	/**
+	 * Hash-map/hash-set operation: checks if the given key exists in the
+	 * hash table.
+	 * @param key key to search for
+	 * @return true if the key exists, false otherwise
+	 */
+	bool contains(KEY const &key) const noexcept;
+	/**
+	 * Hash-map/hash-set operation: removes the given key from the hash table.
+	 * @param key key for removal
+	 * @return true if the key existed, false otherwise
+	 */
+	bool removeKey(KEY const &key) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Hash-map operation: reads the value associated with the given key.
+	 * @param key key to search for
+	 * @param val object to store the value associated with the given key
+	 * @return true on success (key found), false otherwise (key doesn't exist)
+	 */
+	bool hmGet(KEY const &key, VALUE &val) const noexcept;
+	/**
+	 * Hash-map operation: inserts a new key-value pair in the hash table.
+	 * @param key key to insert
+	 * @param val value to associate with the given key
+	 * @return true on success, false on failure (the key already exists)
+	 */
+	bool hmPut(KEY const &key, VALUE const &val) noexcept;
+	/**
+	 * Hash-map operation: stores a key-value pair in the hash table. If the key
+	 * already exists then assigns the desired value to the existing key and
+	 * returns the old value.
+	 * @param key key to insert or update
+	 * @param val value to assign to the given key
+	 * @param oldVal object for returning the old value
+	 * @return true if old value was replaced (key exists), false otherwise
+	 */
+	bool hmReplace(KEY const &key, VALUE const &val, VALUE &oldVal) noexcept;
+	/**
+	 * Hash-map operation: swaps values associated with the given pair of keys.
+	 * If only one of the two keys exists in the hash table then the existing
+	 * key is removed and it's value gets assigned to the non-existing key. If
+	 * both the keys exist and swapping is allowed then the values associated
+	 * with the given keys are exchanged.
+	 * @param first first key
+	 * @param second second key
+	 * @param iterators stores iterators associated with the updated keys in
+	 * their given order. The values remain valid until a hash table update.
+	 * @param swap true to enable swapping, false otherwise
+	 * @return true on success, false on failure (neither of the two keys exists
+	 * or both the keys exist and swapping is disabled).
+	 */
+	bool hmSwap(KEY const &first, KEY const &second,
+			unsigned int (&iterators)[2], bool swap) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Hash-set operation: inserts a new key into the hash table.
+	 * @param key key to add
+	 * @return true on success, false otherwise (key already exists)
+	 */
+	bool hsPut(KEY const &key) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Resizes the hash table.
+	 * @param newCapacity new capacity
+	 * @return always 0
+	 */
+	int resize(unsigned int newCapacity) noexcept;
+	/**
+	 * Returns iterator to a given key.
+	 * @param key key to search for
+	 * @return iterator to the found element, or Swiss::end() if not found
+	 */
+	unsigned int get(KEY const &key) const noexcept;
+	/**
+	 * Inserts a key into the hash table.
+	 * @param key key to insert
+	 * @param ret stores an extra return code: 0 if the key is already
+	 * present, 1 if the bucket was empty and not deleted, 2 if the bucket
+	 * was deleted previously.
+	 * @return iterator to the inserted element
+	 */
+	unsigned int put(KEY const &key, int &ret) noexcept;
+	/**
+	 * Removes a key from the hash table.
+	 * @param x key's iterator (see Swiss::get())
+	 * @param shrink true to shrink the hash table if it is sparsely populated,
+	 * false otherwise. Shrinking invalidates the iterators.
+	 */
+	void remove(unsigned int x, bool shrink = true) noexcept;
+	/**
+	 * Iterates a callback function over the hash table. The Callback function
+	 * must return zero (0) to continue iterating, 1 to remove the key at it's
+	 * current position, and any other value to stop the iteration.
+	 * @param fn callback function. It's first argument is an iterator to
+	 * the next item and its second argument is a generic pointer.
+	 * @param arg second argument of the callback function
+	 */
+	void iterate(int (&fn)(unsigned int index, void *arg), void *arg);
+	/**
+	 * Returns hash table's capacity.
+	 * @return number of buckets
+	 */
+	unsigned int capacity() const noexcept;
+	/**
+	 * Returns the total number of filled buckets in the hash table.
+	 * @return number of existing keys
+	 */
+	unsigned int size() const noexcept;
+	/**
+	 * Returns the number of occupied buckets in the hash table. A bucket is
+	 * occupied if it is either filled or deleted.
+	 * @return number of occupied buckets
+	 */
+	unsigned int occupied() const noexcept;
+	/**
+	 * Returns the maximum number of buckets which can be occupied at the
+	 * current capacity.
+	 * @return maximum permissible number of occupied buckets
+	 */
+	unsigned int upperBound() const noexcept;
+	/**
+	 * Checks if the bucket at a given index is filled, i.e. it is neither
+	 * empty nor deleted.
+	 * @param x index to check
+	 * @return true if the bucket is filled, false if the bucket is either
+	 * empty or deleted.
+	 */
+	bool exists(unsigned int x) const noexcept;
+	/**
+	 * Returns the key present in the bucket at a given index.
+	 * @param x the index
+	 * @param key object for storing the key
+	 * @return true on success, false otherwise (invalid index)
+	 */
+	bool getKey(unsigned int x, KEY &key) const noexcept;
+	/**
+	 * Returns the value present in the bucket at a given index.
+	 * @param x the index
+	 * @param value object for storing the value
+	 * @return true on success, false otherwise (invalid index)
+	 */
+	bool getValue(unsigned int x, VALUE &value) const noexcept;
+	/**
+	 * Updates value stored at a given index.
+	 * @param x the index
+	 * @param value new value
+	 * @return true on success, false otherwise (invalid index)
+	 */
+	bool setValue(unsigned int x, VALUE const &value) noexcept;
+	/**
+	 * Returns pointer to the stored value at a given index.
+	 * @param x the index
+	 * @return stored value's pointer, nullptr if the index is invalid
+	 */
+	VALUE* getValueReference(unsigned int x) const noexcept;
+	/**
+	 * Returns the start iterator that determines the inclusive lower bound.
+	 * @return start iterator
+	 */
+	unsigned int begin() const noexcept;
+	/**
+	 * Returns the end iterator that determines the exclusive upper bound.
+	 * @return end iterator
+	 */
+	unsigned int end() const noexcept;
+	/**
+	 * Empties the hash table (doesn't deallocate memory).
+	 */
+	void clear() noexcept;
+private:
+	void deleteContainer() noexcept {
+		Memory<int8_t>::free(bucket.control);
+		Memory<Slot>::free(bucket.slots);
+		bucket.control = nullptr;
+		bucket.slots = nullptr;
+	}
+
+	//Finds a free (empty or deleted) bucket for a new key
+	static unsigned int locate(const int8_t *control, unsigned int capacity,
+			uint64_t code) noexcept {
+		auto mask = (capacity / GROUP) - 1;
+		auto group = position(code) & mask;
+		unsigned int step = 0;
+		while (true) {
+			auto bits = matchFree(control + (group * GROUP));
+			if (bits) {
+				return (group * GROUP) + lowest(bits);
+			}
+			//Triangular probe (visits every group)
+			group = (group + (++step)) & mask;
+		}
+	}
+
+	//Marks the bucket <x> as filled
+	void fill(unsigned int x, KEY const &key, uint64_t code) noexcept {
+		bucket.control[x] = tag(code);
+		bucket.slots[x].key = key;
+	}
+
+	//Hash value (low bits) and it's scrambled form (seven high bits)
+	uint64_t scramble(KEY const &key) const noexcept {
+		auto h = (uint64_t) hash(key);
+		return ((h * 0x9e3779b97f4a7c15ULL) & (0x7FULL << 57)) | h;
+	}
+	//Group's position in the probe sequence (sixteen keys per group)
+	static unsigned int position(uint64_t code) noexcept {
+		return ((unsigned int) code) >> 4;
+	}
+	//Seven bits of the hash value stored in a control byte
+	static int8_t tag(uint64_t code) noexcept {
+		return (int8_t) (code >> 57);
+	}
+	//Index of the lowest set bit
+	static unsigned int lowest(uint32_t bits) noexcept {
+		return __builtin_ctz(bits);
+	}
+	//Bit-mask of control bytes equal to the given value
+	static uint32_t match(const int8_t *group, int8_t value) noexcept {
+#if defined(__SSE2__)
+		auto ctrl = _mm_loadu_si128((const __m128i*) group);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrl));
+#else
+		uint32_t bits = 0;
+		for (unsigned int i = 0; i < GROUP; ++i) {
+			bits |= ((uint32_t) (group[i] == value)) << i;
+		}
+		return bits;
+#endif
+	}
+	//Bit-mask of the empty buckets
+	static uint32_t matchEmpty(const int8_t *group) noexcept {
+		return match(group, EMPTY);
+	}
+	//Bit-mask of the empty or deleted buckets (sign bit is set)
+	static uint32_t matchFree(const int8_t *group) noexcept {
+#if defined(__SSE2__)
+		auto ctrl = _mm_loadu_si128((const __m128i*) group);
+		return _mm_movemask_epi8(ctrl);
+#else
+		uint32_t bits = 0;
+		for (unsigned int i = 0; i < GROUP; ++i) {
+			bits |= ((uint32_t) (group[i] < 0)) << i;
+		}
+		return bits;
+#endif
+	}
+
+	//Calculate the upper bound for given capacity
+	static unsigned int calculateUpperBound(unsigned int capacity) noexcept {
+		return capacity - (capacity >> 3);
+	}
+private:
+	struct Pair {
+		KEY key;
+		VALUE value;
+	};
+	struct Single {
+		KEY key;
+	};
+	//Hash sets store only the keys
+	using Slot = std::conditional_t<ISMAP, Pair, Single>;
+
+	struct {
+		unsigned int capacity;
+		unsigned int size;
+		unsigned int occupied;
+		unsigned int upperBound;
+		int8_t *control;
+		Slot *slots;
+	} bucket;
+
+	HFN hash;
+	EQFN equal;
+
+	//Control byte values of the empty and deleted buckets
+	static constexpr int8_t EMPTY = -128;
+	static constexpr int8_t DELETED = -2;
+	//Number of buckets in a group (probing unit)
+	static constexpr unsigned int GROUP = 16;
+	static constexpr unsigned int MIN_CAPACITY = 16;
+	WH_POD_ASSERT(KEY);
+	WH_POD_ASSERT(VALUE);
+};
+
+/**
+ * Hash map specialization
+ */
+template<typename KEY, typename VALUE, typename HFN = wh_hash_fn,
+		typename EQFN = wh_eq_fn> using Smap = Swiss<KEY, VALUE, true, HFN, EQFN>;
+/**
+ * Hash set specialization
+ */
+template<typename KEY, typename HFN = wh_hash_fn, typename EQFN = wh_eq_fn> using Sset = Swiss<KEY, char, false, HFN, EQFN>;
+
+} /* namespace wanhive */
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::Swiss() noexcept {
+	memset(&bucket, 0, sizeof(bucket));
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::~Swiss() {
+	deleteContainer();
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::contains(
+		const KEY &key) const noexcept {
+	return get(key) != end();
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::removeKey(
+		const KEY &key) noexcept {
+	auto i = get(key);
+	if (i != end()) {
+		remove(i);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::hmGet(const KEY &key,
+		VALUE &val) const noexcept {
+	if constexpr (ISMAP) {
+		auto i = get(key);
+		if (i != end()) {
+			val = bucket.slots[i].value;
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::hmPut(const KEY &key,
+		const VALUE &val) noexcept {
+	if constexpr (ISMAP) {
+		int ret;
+		auto i = put(key, ret);
+		if (ret) {
+			bucket.slots[i].value = val;
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::hmReplace(const KEY &key,
+		const VALUE &val, VALUE &oldVal) noexcept {
+	if constexpr (ISMAP) {
+		int ret;
+		auto i = put(key, ret);
+		if (ret) {
+			//Key did not exist
+			bucket.slots[i].value = val;
+			return false;
+		} else {
+			oldVal = bucket.slots[i].value;
+			bucket.slots[i].value = val;
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::hmSwap(KEY const &first,
+		KEY const &second, unsigned int (&iterators)[2], bool swap) noexcept {
+	if constexpr (!ISMAP) {
+		iterators[0] = end();
+		iterators[1] = end();
+		return false;
+	}
+
+	auto fi = get(first);
+	auto si = (first != second) ? get(second) : fi;
+	//Correct iterators are returned even on failure
+	iterators[0] = fi;
+	iterators[1] = si;
+
+	if (fi == si) {
+		return exists(fi);
+	} else if (exists(fi) && exists(si) && swap) {
+		VALUE fv = bucket.slots[fi].value;
+		bucket.slots[fi].value = bucket.slots[si].value;
+		bucket.slots[si].value = fv;
+		return true;
+	} else if (exists(fi) && !exists(si)) {
+		int x;
+		VALUE fv = bucket.slots[fi].value;
+		remove(fi);
+		si = put(second, x);
+		bucket.slots[si].value = fv;
+		iterators[0] = end();
+		iterators[1] = si;
+		return true;
+	} else if (!exists(fi) && exists(si)) {
+		int x;
+		VALUE sv = bucket.slots[si].value;
+		remove(si);
+		fi = put(first, x);
+		bucket.slots[fi].value = sv;
+		iterators[0] = fi;
+		iterators[1] = end();
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::hsPut(
+		const KEY &key) noexcept {
+	if constexpr (!ISMAP) {
+		int ret;
+		put(key, ret);
+		if (ret) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::resize(
+		unsigned int newCapacity) noexcept {
+	newCapacity = Twiddler::power2Ceil(newCapacity);
+	if (newCapacity < MIN_CAPACITY) {
+		newCapacity = MIN_CAPACITY;
+	}
+
+	if (size() >= calculateUpperBound(newCapacity)) {
+		/* requested size is too small */
+		return 0;
+	}
+
+	auto control = Memory<int8_t>::allocate(newCapacity);
+	auto slots = Memory<Slot>::allocate(newCapacity);
+	memset(control, EMPTY, newCapacity);
+
+	/* move the existing elements, the deleted ones are dropped */
+	for (unsigned int j = 0; j < capacity(); ++j) {
+		if (exists(j)) {
+			auto code = scramble(bucket.slots[j].key);
+			auto i = locate(control, newCapacity, code);
+			control[i] = tag(code);
+			slots[i] = bucket.slots[j];
+		}
+	}
+
+	deleteContainer();
+	bucket.control = control;
+	bucket.slots = slots;
+	bucket.capacity = newCapacity;
+	bucket.occupied = size();
+	bucket.upperBound = calculateUpperBound(newCapacity);
+	return 0;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::get(
+		const KEY &key) const noexcept {
+	if (!capacity()) {
+		return end();
+	}
+
+	auto code = scramble(key);
+	auto t = tag(code);
+	auto mask = (capacity() / GROUP) - 1;
+	auto group = position(code) & mask;
+	unsigned int step = 0;
+	do {
+		auto ctrl = bucket.control + (group * GROUP);
+		for (auto bits = match(ctrl, t); bits; bits &= (bits - 1)) {
+			auto i = (group * GROUP) + lowest(bits);
+			if (equal(bucket.slots[i].key, key)) {
+				return i;
+			}
+		}
+
+		if (matchEmpty(ctrl)) {
+			return end();
+		}
+		//Triangular probe (visits every group)
+		group = (group + (++step)) & mask;
+	} while (step <= mask);
+
+	return end();
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::put(const KEY &key,
+		int &ret) noexcept {
+	auto i = get(key);
+	if (i != end()) {
+		//Key already present
+		ret = 0;
+		return i;
+	}
+
+	if (occupied() >= upperBound()) { /* update the hash table */
+		if (capacity() > (size() << 1)) {
+			resize(capacity() - 1); /* clear "deleted" elements */
+		} else {
+			resize(capacity() + 1); /* expand the hash table */
+		}
+	}
+
+	auto code = scramble(key);
+	i = locate(bucket.control, capacity(), code);
+	if (bucket.control[i] == EMPTY) {
+		bucket.occupied += 1;
+		ret = 1;
+	} else {
+		ret = 2;
+	}
+	fill(i, key, code);
+	bucket.size += 1;
+	return i;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+void wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::remove(unsigned int x,
+		bool shrink) noexcept {
+	if (exists(x)) {
+		/*
+		 * The bucket can be emptied if it's group has an empty bucket because
+		 * no probe sequence could have passed through such a group.
+		 */
+		if (matchEmpty(bucket.control + (x & ~(GROUP - 1)))) {
+			bucket.control[x] = EMPTY;
+			bucket.occupied -= 1;
+		} else {
+			bucket.control[x] = DELETED;
+		}
+		bucket.size -= 1;
+	}
+
+	//If the hash table has become too sparse then fix it
+	if (shrink && (size() > 4096) && (size() < (capacity() >> 2))) {
+		Swiss::resize(size() << 1);
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+void wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::iterate(
+		int (&fn)(unsigned int index, void *arg), void *arg) {
+	for (auto k = begin(); k < end(); ++k) {
+		if (!exists(k)) {
+			continue;
+		}
+
+		int ret = fn(k, arg);
+		if (ret == 0) {
+			continue;
+		} else if (ret == 1) { //Remove the key
+			remove(k, false); //Shrinking will invalidate the iterators
+		} else { //Stop iterating
+			break;
+		}
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::capacity() const noexcept {
+	return (bucket.capacity);
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::size() const noexcept {
+	return (bucket.size);
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::occupied() const noexcept {
+	return (bucket.occupied);
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::upperBound() const noexcept {
+	return (bucket.upperBound);
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::exists(
+		unsigned int x) const noexcept {
+	return (x < end() && bucket.control[x] >= 0);
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::getKey(unsigned int x,
+		KEY &key) const noexcept {
+	if (exists(x)) {
+		key = bucket.slots[x].key;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::getValue(unsigned int x,
+		VALUE &value) const noexcept {
+	if (ISMAP && exists(x)) {
+		value = bucket.slots[x].value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+bool wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::setValue(unsigned int x,
+		VALUE const &value) noexcept {
+	if (ISMAP && exists(x)) {
+		bucket.slots[x].value = value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+VALUE* wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::getValueReference(
+		unsigned int x) const noexcept {
+	if (ISMAP && exists(x)) {
+		return &(bucket.slots[x].value);
+	} else {
+		return nullptr;
+	}
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::begin() const noexcept {
+	return 0;
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+unsigned int wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::end() const noexcept {
+	return capacity();
+}
+
+template<typename KEY, typename VALUE, bool ISMAP, typename HFN, typename EQFN>
+void wanhive::Swiss<KEY, VALUE, ISMAP, HFN, EQFN>::clear() noexcept {
+	if (bucket.control) {
+		memset(bucket.control, EMPTY, capacity());
+	}
+	bucket.size = 0;		//No elements in the hash table
+	bucket.occupied = 0;	//No deleted slots in the hash table
+}
+
+#endif /* WH_BASE_DS_SWISS_H_ */
@@ -0,0 +1,168 @@
+/*
+ * TimerWheel.cpp
+ *
+ * Hierarchical timing wheel
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "TimerWheel.h"
+
+namespace wanhive {
+
+TimerWheel::TimerWheel() noexcept {
+	for (auto &level : slots) {
+		for (auto &head : level) {
+			reset(head);
+		}
+	}
+}
+
+TimerWheel::~TimerWheel() {
+	clear();
+}
+
+void TimerWheel::schedule(Deadline &d, unsigned long long ticks) noexcept {
+	cancel(d);
+	if (ticks == 0) {
+		ticks = 1;
+	} else if (ticks > RANGE) {
+		ticks = RANGE;
+	}
+
+	d.expiry = clock + ticks;
+	place(d);
+	++count;
+}
+
+void TimerWheel::cancel(Deadline &d) noexcept {
+	if (scheduled(d)) {
+		unlink(d);
+		--count;
+	}
+}
+
+bool TimerWheel::scheduled(const Deadline &d) noexcept {
+	return d.prev != nullptr;
+}
+
+void TimerWheel::touch(Deadline &d) const noexcept {
+	d.touched = clock;
+}
+
+unsigned int TimerWheel::advance(unsigned long long ticks,
+		void (*fn)(Deadline*, void*), void *arg) {
+	Deadline expired;
+	reset(expired);
+	unsigned int total = 0;
+	while (ticks--) { //postfix --
+		++clock;
+		if (!count) {
+			//Nothing to expire, jump ahead
+			clock += ticks;
+			break;
+		}
+
+		//Move the due entries towards the lower levels (highest level first)
+		unsigned int level = 0;
+		while ((level + 1) < LEVELS
+				&& !(clock & ((1ULL << ((level + 1) * BITS)) - 1))) {
+			++level;
+		}
+		for (; level > 0; --level) {
+			cascade(level);
+		}
+
+		//Collect the expired entries
+		splice(slots[0][clock & (SLOTS - 1)], expired);
+	}
+
+	//Callback may reschedule the expired entry or cancel the others
+	while (expired.next != &expired) {
+		auto d = expired.next;
+		unlink(*d);
+		--count;
+		++total;
+		if (fn) {
+			fn(d, arg);
+		}
+	}
+	return total;
+}
+
+unsigned long long TimerWheel::now() const noexcept {
+	return clock;
+}
+
+unsigned int TimerWheel::size() const noexcept {
+	return count;
+}
+
+void TimerWheel::clear() noexcept {
+	for (auto &level : slots) {
+		for (auto &head : level) {
+			while (head.next != &head) {
+				unlink(*head.next);
+			}
+		}
+	}
+	count = 0;
+}
+
+void TimerWheel::place(Deadline &d) noexcept {
+	auto delta = (d.expiry > clock) ? (d.expiry - clock) : 0;
+	unsigned int level = 0;
+	while ((level + 1) < LEVELS && delta >= (1ULL << ((level + 1) * BITS))) {
+		++level;
+	}
+
+	auto index = (d.expiry >> (level * BITS)) & (SLOTS - 1);
+	link(slots[level][index], d);
+}
+
+void TimerWheel::cascade(unsigned int level) noexcept {
+	auto &head = slots[level][(clock >> (level * BITS)) & (SLOTS - 1)];
+	Deadline list;
+	reset(list);
+	splice(head, list);
+	while (list.next != &list) {
+		auto d = list.next;
+		unlink(*d);
+		place(*d);
+	}
+}
+
+void TimerWheel::reset(Deadline &head) noexcept {
+	head.prev = &head;
+	head.next = &head;
+}
+
+void TimerWheel::link(Deadline &head, Deadline &d) noexcept {
+	d.prev = head.prev;
+	d.next = &head;
+	head.prev->next = &d;
+	head.prev = &d;
+}
+
+void TimerWheel::unlink(Deadline &d) noexcept {
+	d.prev->next = d.next;
+	d.next->prev = d.prev;
+	d.prev = nullptr;
+	d.next = nullptr;
+}
+
+void TimerWheel::splice(Deadline &from, Deadline &to) noexcept {
+	if (from.next != &from) {
+		from.next->prev = to.prev;
+		to.prev->next = from.next;
+		from.prev->next = &to;
+		to.prev = from.prev;
+		reset(from);
+	}
+}
+
+} /* namespace wanhive */
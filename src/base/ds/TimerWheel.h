@@ -0,0 +1,126 @@
+/**
+ * @file TimerWheel.h
+ *
+ * Hierarchical timing wheel
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_BASE_DS_TIMERWHEEL_H_
+#define WH_BASE_DS_TIMERWHEEL_H_
+#include "../common/NonCopyable.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Timing wheel's entry, embed it into the object which requires a timeout.
+ */
+struct Deadline {
+	/*! Previous entry in the list (nullptr if not scheduled) */
+	Deadline *prev { };
+	/*! Next entry in the list */
+	Deadline *next { };
+	/*! Expiration tick */
+	unsigned long long expiry { };
+	/*! Tick of the owner's last activity (maintained by the user) */
+	unsigned long long touched { };
+	/*! The owner */
+	void *owner { };
+};
+//-----------------------------------------------------------------
+/**
+ * Hashed and hierarchical timing wheel with constant time scheduling and
+ * cancellation. Expired entries are delivered on advancement of the clock.
+ * @ref Varghese and Lauck, "Hashed and Hierarchical Timing Wheels" (1987)
+ */
+class TimerWheel: private NonCopyable {
+public:
+	/**
+	 * Constructor: creates an empty timing wheel.
+	 */
+	TimerWheel() noexcept;
+	/**
+	 * Destructor: drops all the scheduled entries.
+	 */
+	~TimerWheel();
+	//-----------------------------------------------------------------
+	/**
+	 * Schedules an entry (reschedules if the entry was already scheduled).
+	 * @param d the entry
+	 * @param ticks expiration in ticks from now (minimum one tick, capped at
+	 * TimerWheel::RANGE).
+	 */
+	void schedule(Deadline &d, unsigned long long ticks) noexcept;
+	/**
+	 * Cancels a scheduled entry, no-op if the entry is not scheduled.
+	 * @param d the entry
+	 */
+	void cancel(Deadline &d) noexcept;
+	/**
+	 * Checks whether an entry is scheduled.
+	 * @param d the entry
+	 * @return true if the entry is scheduled, false otherwise
+	 */
+	static bool scheduled(const Deadline &d) noexcept;
+	/**
+	 * Records the owner's activity in an entry (see Deadline::touched).
+	 * @param d the entry
+	 */
+	void touch(Deadline &d) const noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Advances the clock and delivers the expired entries to a callback
+	 * function. An expired entry is removed from the timing wheel before the
+	 * delivery, the callback function may reschedule it. The callback function
+	 * may also cancel the other entries.
+	 * @param ticks number of ticks to advance the clock by
+	 * @param fn callback function, receives an expired entry as it's first
+	 * argument, and a generic pointer as it's second argument.
+	 * @param arg callback function's second argument
+	 * @return number of expired entries
+	 */
+	unsigned int advance(unsigned long long ticks,
+			void (*fn)(Deadline*, void*), void *arg);
+	/**
+	 * Returns the current tick.
+	 * @return the clock's value
+	 */
+	unsigned long long now() const noexcept;
+	/**
+	 * Returns the number of scheduled entries.
+	 * @return scheduled entries count
+	 */
+	unsigned int size() const noexcept;
+	/**
+	 * Cancels all the scheduled entries.
+	 */
+	void clear() noexcept;
+public:
+	/*! Number of levels */
+	static constexpr unsigned int LEVELS = 4;
+	/*! Number of bits for indexing a level's slots */
+	static constexpr unsigned int BITS = 6;
+	/*! Number of slots in each level */
+	static constexpr unsigned int SLOTS = (1U << BITS);
+	/*! Maximum expiration in ticks */
+	static constexpr unsigned long long RANGE = (1ULL << (LEVELS * BITS)) - 1;
+private:
+	void place(Deadline &d) noexcept;
+	void cascade(unsigned int level) noexcept;
+	static void reset(Deadline &head) noexcept;
+	static void link(Deadline &head, Deadline &d) noexcept;
+	static void unlink(Deadline &d) noexcept;
+	static void splice(Deadline &from, Deadline &to) noexcept;
+private:
+	unsigned long long clock { };
+	unsigned int count { };
+	Deadline slots[LEVELS][SLOTS];
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_BASE_DS_TIMERWHEEL_H_ */
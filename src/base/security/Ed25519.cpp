@@ -20,20 +20,23 @@ Ed25519::Ed25519() noexcept :
 }
 
 Ed25519::~Ed25519() {
-	EVP_MD_CTX_free(mdctx);
+
 }
 
 bool Ed25519::sign(const unsigned char *data, unsigned int dataLength,
-		unsigned char *signature, unsigned int &signatureLength) noexcept {
+		unsigned char *signature,
+		unsigned int &signatureLength) const noexcept {
 	if (getPrivateKey() && (!dataLength || data)) {
 		size_t len { signatureLength };
-		auto ctx = mdContext();
+		//Per-call context keeps the shared keys usable from multiple threads
+		auto ctx = EVP_MD_CTX_new();
 		//Sign the data in a single shot
 		auto success = (ctx != nullptr)
 				&& (EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr,
 						getPrivateKey()) == 1)
 				&& (EVP_DigestSign(ctx, signature, &len, data, dataLength) == 1)
 				&& (signatureLength = len);
+		EVP_MD_CTX_free(ctx);
 		return success;
 	} else {
 		return false;
@@ -41,15 +44,17 @@ bool Ed25519::sign(const unsigned char *data, unsigned int dataLength,
 }
 
 bool Ed25519::verify(const unsigned char *data, unsigned int dataLength,
-		const unsigned char *signature, unsigned int signatureLength) noexcept {
+		const unsigned char *signature,
+		unsigned int signatureLength) const noexcept {
 	if (getPublicKey() && (!dataLength || data) && signature) {
-		auto ctx = mdContext();
+		auto ctx = EVP_MD_CTX_new();
 		//Verify the data in a single shot
 		auto success = (ctx != nullptr)
 				&& (EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr,
 						getPublicKey()) == 1)
 				&& (EVP_DigestVerify(ctx, signature, signatureLength, data,
 						dataLength) == 1);
+		EVP_MD_CTX_free(ctx);
 		return success;
 	} else {
 		return false;
@@ -61,14 +66,4 @@ bool Ed25519::generate(const char *privateKey, const char *publicKey,
 	return KeyPair::generate(privateKey, publicKey, 0, secret, nullptr);
 }
 
-EVP_MD_CTX* Ed25519::mdContext() noexcept {
-	if (mdctx) {
-		EVP_MD_CTX_reset(mdctx);
-	} else {
-		mdctx = EVP_MD_CTX_new();
-	}
-
-	return mdctx;
-}
-
 } /* namespace wanhive */
@@ -41,7 +41,8 @@ public:
 	 * @return true on success, false on error
 	 */
 	bool sign(const unsigned char *data, unsigned int dataLength,
-			unsigned char *signature, unsigned int &signatureLength) noexcept;
+			unsigned char *signature,
+			unsigned int &signatureLength) const noexcept;
 	/**
 	 * Verifies the given data.
 	 * @param verifiable data
@@ -52,7 +53,7 @@ public:
 	 */
 	bool verify(const unsigned char *data, unsigned int dataLength,
 			const unsigned char *signature,
-			unsigned int signatureLength) noexcept;
+			unsigned int signatureLength) const noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Generates PEM encoded key pair.
@@ -63,15 +64,11 @@ public:
 	 */
 	bool generate(const char *privateKey, const char *publicKey, char *secret =
 			nullptr) noexcept;
-private:
-	EVP_MD_CTX* mdContext() noexcept;
 public:
 	/*! Private and public key sizes in bytes */
 	static constexpr unsigned int KEY_SIZE = 32;
 	/*! Signature size in bytes */
 	static constexpr unsigned int SIGNATURE_SIZE = 64;
-private:
-	EVP_MD_CTX *mdctx { };
 };
 
 } /* namespace wanhive */
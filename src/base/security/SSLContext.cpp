@@ -11,16 +11,28 @@
  */
 
 #include "SSLContext.h"
+#include "CSPRNG.h"
 #include "CryptoUtils.h"
 #include "../common/Exception.h"
+#include <openssl/core_names.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+//Session ID context (required for the server-side session caching)
+const unsigned char SESSION_CONTEXT[] = "wanhive";
+
+}  // namespace
 
 namespace wanhive {
 
 SSLContext::SSLContext() noexcept {
-
+	mutex = PTHREAD_MUTEX_INITIALIZER;
 }
 
 SSLContext::SSLContext(const char *certificate, const char *key) {
+	mutex = PTHREAD_MUTEX_INITIALIZER;
 	try {
 		setup(certificate, key);
 	} catch (const BaseException &e) {
@@ -31,6 +43,9 @@ SSLContext::SSLContext(const char *certificate, const char *key) {
 
 SSLContext::~SSLContext() {
 	clear();
+	if (pthread_mutex_destroy(&mutex) != 0) {
+		abort();
+	}
 }
 
 void SSLContext::setup(const char *certificate, const char *key) {
@@ -40,6 +55,7 @@ void SSLContext::setup(const char *certificate, const char *key) {
 				SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3 | SSL_OP_NO_TLSv1
 						| SSL_OP_NO_TLSv1_1);
 		SSL_CTX_set_quiet_shutdown(ctx, 1);
+		SSL_CTX_set_app_data(ctx, this);
 	}
 
 	if (!install(certificate, key)) {
@@ -60,6 +76,72 @@ void SSLContext::trust(const char *file, const char *path) {
 	}
 }
 
+bool SSLContext::offload(bool enable) noexcept {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+	if (!ctx) {
+		return false;
+	} else if (enable) {
+		SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+	} else {
+		SSL_CTX_clear_options(ctx, SSL_OP_ENABLE_KTLS);
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SSLContext::resume(unsigned int sessions, unsigned int rotation) {
+	if (!ctx) {
+		throw Exception(EX_RESOURCE);
+	}
+
+	lock();
+	forget();
+	tickets.rotation = 0;
+	unlock();
+
+	if (!sessions) {
+		SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+		SSL_CTX_sess_set_new_cb(ctx, nullptr);
+		SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, nullptr);
+		SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+		SSL_CTX_set_num_tickets(ctx, 0);
+		return;
+	}
+
+	if (SSL_CTX_set_session_id_context(ctx, SESSION_CONTEXT,
+			sizeof(SESSION_CONTEXT) - 1) != 1) {
+		throw Exception(EX_SECURITY);
+	}
+	SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_BOTH);
+	SSL_CTX_sess_set_cache_size(ctx, sessions);
+	SSL_CTX_sess_set_new_cb(ctx, onSession);
+	if (rotation) {
+		lock();
+		tickets.rotation = rotation;
+		unlock();
+		if (!rotate()) {
+			throw Exception(EX_SECURITY);
+		}
+		//The previous key remains valid for one more rotation period
+		SSL_CTX_set_timeout(ctx, 2L * rotation);
+		SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, onTicket);
+		SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
+	} else {
+		//Stateful tickets (TLS 1.3) backed by the session cache
+		SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, nullptr);
+		SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+	}
+}
+
+bool SSLContext::rotate() noexcept {
+	lock();
+	auto success = renew();
+	unlock();
+	return success;
+}
+
 SSL* SSLContext::create(int fd, bool server) {
 	SSL *ssl = nullptr;
 	if (!ctx) {
@@ -73,6 +155,7 @@ SSL* SSLContext::create(int fd, bool server) {
 		if (server) {
 			SSL_set_accept_state(ssl);
 		} else {
+			recall(ssl, fd);
 			SSL_set_connect_state(ssl);
 		}
 		return ssl;
@@ -117,6 +200,24 @@ void SSLContext::destroy(SSL *ssl) noexcept {
 	SSL_free(ssl);
 }
 
+bool SSLContext::offloaded(SSL *ssl, bool send) noexcept {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+	if (!ssl) {
+		return false;
+	} else if (send) {
+		return BIO_get_ktls_send(SSL_get_wbio(ssl));
+	} else {
+		return BIO_get_ktls_recv(SSL_get_rbio(ssl));
+	}
+#else
+	return false;
+#endif
+}
+
+bool SSLContext::resumed(const SSL *ssl) noexcept {
+	return ssl && SSL_session_reused(ssl) == 1;
+}
+
 size_t SSLContext::receive(SSL *ssl, unsigned char *buf, size_t bytes) {
 	if (!ssl || (!buf && bytes)) {
 		throw Exception(EX_ARGUMENT);
@@ -175,9 +276,177 @@ bool SSLContext::install(const char *certificate, const char *key) noexcept {
 }
 
 void SSLContext::clear() noexcept {
+	lock();
+	forget();
+	OPENSSL_cleanse(&tickets.keys, sizeof(tickets.keys));
+	tickets.rotation = 0;
+	unlock();
 	SSL_CTX_free(ctx);
 	ctx = nullptr;
 }
 
+void SSLContext::recall(SSL *ssl, int fd) noexcept {
+	sockaddr_storage address;
+	socklen_t length = sizeof(address);
+	if (getpeername(fd, (sockaddr*) &address, &length) != 0) {
+		return;
+	}
+
+	lock();
+	for (auto &entry : sessions) {
+		if (entry.session && entry.length == length
+				&& !memcmp(&entry.address, &address, length)) {
+			SSL_set_session(ssl, entry.session);
+			break;
+		}
+	}
+	unlock();
+}
+
+bool SSLContext::remember(SSL *ssl, SSL_SESSION *session) noexcept {
+	sockaddr_storage address;
+	socklen_t length = sizeof(address);
+	if (!SSL_SESSION_is_resumable(session)
+			|| getpeername(SSL_get_fd(ssl), (sockaddr*) &address, &length)
+					!= 0) {
+		return false;
+	}
+
+	lock();
+	//Replace the peer's existing session, otherwise the oldest entry
+	auto index = victim;
+	for (unsigned int i = 0; i < SESSIONS; ++i) {
+		if (sessions[i].session && sessions[i].length == length
+				&& !memcmp(&sessions[i].address, &address, length)) {
+			index = i;
+			break;
+		}
+	}
+
+	if (index == victim) {
+		victim = (victim + 1) % SESSIONS;
+	}
+	SSL_SESSION_free(sessions[index].session);
+	memcpy(&sessions[index].address, &address, length);
+	sessions[index].length = length;
+	sessions[index].session = session;
+	unlock();
+	return true;
+}
+
+void SSLContext::forget() noexcept {
+	for (auto &entry : sessions) {
+		SSL_SESSION_free(entry.session);
+		entry.session = nullptr;
+		entry.length = 0;
+	}
+	victim = 0;
+}
+
+bool SSLContext::renew() noexcept {
+	TicketKey key;
+	key.valid = CSPRNG::bytes(key.name, sizeof(key.name))
+			&& CSPRNG::bytes(key.cipher, sizeof(key.cipher))
+			&& CSPRNG::bytes(key.mac, sizeof(key.mac));
+	auto success = key.valid;
+	if (success) {
+		tickets.keys[1] = tickets.keys[0];
+		tickets.keys[0] = key;
+		tickets.timer.now();
+	}
+	OPENSSL_cleanse(&key, sizeof(key));
+	return success;
+}
+
+int SSLContext::unseal(unsigned char *name, unsigned char *iv,
+		EVP_CIPHER_CTX *cctx, EVP_MAC_CTX *hctx, int enc) noexcept {
+	if (enc && tickets.rotation
+			&& tickets.timer.elapsed() >= tickets.rotation) {
+		renew();
+	}
+
+	const TicketKey *key = nullptr;
+	int status = 1;
+	if (enc) {
+		key = tickets.keys[0].valid ? &tickets.keys[0] : nullptr;
+		if (key) {
+			memcpy(name, key->name, sizeof(key->name));
+		}
+	} else {
+		for (unsigned int i = 0; i < 2; ++i) {
+			if (tickets.keys[i].valid
+					&& !memcmp(name, tickets.keys[i].name,
+							sizeof(tickets.keys[i].name))) {
+				key = &tickets.keys[i];
+				//Renew the tickets encrypted with the previous key
+				status = (i == 0) ? 1 : 2;
+				break;
+			}
+		}
+	}
+
+	if (!key) {
+		//Unknown key: full handshake
+		return enc ? -1 : 0;
+	}
+
+	OSSL_PARAM params[] = {
+			OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY,
+					(void*) key->mac, sizeof(key->mac)),
+			OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+					(char*) "SHA256", 0), OSSL_PARAM_construct_end() };
+	auto cipher = EVP_aes_256_cbc();
+	if (enc && !CSPRNG::bytes(iv, EVP_CIPHER_get_iv_length(cipher))) {
+		return -1;
+	} else if (EVP_CipherInit_ex(cctx, cipher, nullptr, key->cipher, iv, enc)
+			!= 1) {
+		return -1;
+	} else if (EVP_MAC_CTX_set_params(hctx, params) != 1) {
+		return -1;
+	} else {
+		return status;
+	}
+}
+
+void SSLContext::lock() noexcept {
+	if (pthread_mutex_lock(&mutex) != 0) {
+		abort();
+	}
+}
+
+void SSLContext::unlock() noexcept {
+	if (pthread_mutex_unlock(&mutex) != 0) {
+		abort();
+	}
+}
+
+int SSLContext::onSession(SSL *ssl, SSL_SESSION *session) noexcept {
+	auto sc = (SSLContext*) SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl));
+	if (!sc || SSL_is_server(ssl)) {
+		return 0;
+	} else {
+		//Return value 1: this object holds the session's reference
+		return sc->remember(ssl, session) ? 1 : 0;
+	}
+}
+
+int SSLContext::onTicket(SSL *ssl, unsigned char *name, unsigned char *iv,
+		EVP_CIPHER_CTX *cctx, EVP_MAC_CTX *hctx, int enc) noexcept {
+	auto sc = (SSLContext*) SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl));
+	if (!sc) {
+		return enc ? -1 : 0;
+	} else {
+		sc->lock();
+		auto status = sc->unseal(name, iv, cctx, hctx, enc);
+		sc->unlock();
+		if (!enc && status == 1 && SSL_version(ssl) >= TLS1_3_VERSION) {
+			//TLS 1.3 tickets are single-use, issue a fresh one
+			return 2;
+		} else {
+			return status;
+		}
+	}
+}
+
 } /* namespace wanhive */
 
@@ -12,8 +12,11 @@
 
 #ifndef WH_BASE_SECURITY_SSLCONTEXT_H_
 #define WH_BASE_SECURITY_SSLCONTEXT_H_
+#include "../Timer.h"
 #include "../common/NonCopyable.h"
 #include <openssl/ssl.h>
+#include <pthread.h>
+#include <sys/socket.h>
 
 /*! @namespace wanhive */
 namespace wanhive {
@@ -51,9 +54,34 @@ public:
 	 * @param path trusted CA certificates' directory name
 	 */
 	void trust(const char *file, const char *path);
+	/**
+	 * Enables or disables the kernel TLS (kTLS) offload for the new secure
+	 * connections. On completion of the handshake, the kernel takes over the
+	 * record encryption and decryption if it supports the negotiated cipher.
+	 * @param enable true to enable the offload, false to disable it
+	 * @return true on success, false if the offload is not supported
+	 */
+	bool offload(bool enable) noexcept;
+	/**
+	 * Configures the session resumption. The server side keeps a bounded
+	 * session cache and issues session tickets encrypted with periodically
+	 * rotated keys (a ticket remains valid for up to two rotation periods). The
+	 * client side reuses the last session of each peer address.
+	 * @param sessions session cache's capacity, 0 to disable the resumption
+	 * @param rotation session ticket keys' rotation period in seconds, 0 to
+	 * disable the session tickets (the session cache is used instead)
+	 */
+	void resume(unsigned int sessions, unsigned int rotation);
+	/**
+	 * Replaces the session ticket encryption key. Tickets encrypted with the
+	 * previous key remain acceptable (and get renewed) until the next rotation.
+	 * @return true on success, false on error
+	 */
+	bool rotate() noexcept;
 	//-----------------------------------------------------------------
 	/**
-	 * Creates a new secure connection.
+	 * Creates a new secure connection. A client-side connection attempts to
+	 * resume the peer's cached session.
 	 * @param fd socket file descriptor
 	 * @param server true for server-side configuration, false for client
 	 * @return secure connection
@@ -103,6 +131,20 @@ public:
 	 * @param ssl secure connection
 	 */
 	static void destroy(SSL *ssl) noexcept;
+	/**
+	 * Checks whether the kernel has taken over a secure connection's record
+	 * layer, in which case the plain socket IO carries the application data.
+	 * @param ssl secure connection
+	 * @param send true to check the transmission, false to check the reception
+	 * @return true if the given direction is offloaded, false otherwise
+	 */
+	static bool offloaded(SSL *ssl, bool send) noexcept;
+	/**
+	 * Checks whether a secure connection resumed a previous session.
+	 * @param ssl secure connection
+	 * @return true if the session was resumed, false otherwise
+	 */
+	static bool resumed(const SSL *ssl) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Reads specified number of bytes from a blocking secure connection.
@@ -129,8 +171,44 @@ protected:
 private:
 	bool install(const char *certificate, const char *key) noexcept;
 	void clear() noexcept;
+	//-----------------------------------------------------------------
+	void recall(SSL *ssl, int fd) noexcept;
+	bool remember(SSL *ssl, SSL_SESSION *session) noexcept;
+	void forget() noexcept;
+	bool renew() noexcept;
+	int unseal(unsigned char *name, unsigned char *iv, EVP_CIPHER_CTX *cctx,
+			EVP_MAC_CTX *hctx, int enc) noexcept;
+	void lock() noexcept;
+	void unlock() noexcept;
+	static int onSession(SSL *ssl, SSL_SESSION *session) noexcept;
+	static int onTicket(SSL *ssl, unsigned char *name, unsigned char *iv,
+			EVP_CIPHER_CTX *cctx, EVP_MAC_CTX *hctx, int enc) noexcept;
 private:
 	SSL_CTX *ctx { };
+	pthread_mutex_t mutex;
+	//-----------------------------------------------------------------
+	//Session ticket keys: current and previous
+	struct TicketKey {
+		unsigned char name[16];
+		unsigned char cipher[32];
+		unsigned char mac[32];
+		bool valid;
+	};
+
+	struct {
+		TicketKey keys[2];
+		unsigned int rotation;
+		Timer timer;
+	} tickets { };
+	//-----------------------------------------------------------------
+	//Client-side sessions indexed by the peer address
+	static constexpr unsigned int SESSIONS = 32;
+	struct {
+		sockaddr_storage address;
+		socklen_t length;
+		SSL_SESSION *session;
+	} sessions[SESSIONS] { };
+	unsigned int victim { };
 };
 
 } /* namespace wanhive */
@@ -95,6 +95,15 @@ bool Time::now(clockid_t id, long long &milliseconds) noexcept {
 	}
 }
 
+unsigned long long Time::microseconds(clockid_t id) noexcept {
+	timespec ts;
+	if (now(id, ts)) {
+		return microseconds(ts);
+	} else {
+		return 0;
+	}
+}
+
 void Time::future(timespec &ts, unsigned int offset) noexcept {
 	ts.tv_sec += offset / 1000;
 	ts.tv_nsec += (offset % 1000) * 1000000L;
@@ -124,4 +133,12 @@ long long Time::milliseconds(const timespec &ts) noexcept {
 	return ((ts.tv_sec * 1000LL) + (ts.tv_nsec / 1000000LL));
 }
 
+long long Time::microseconds(const timespec &ts) noexcept {
+	return ((ts.tv_sec * 1000000LL) + (ts.tv_nsec / 1000LL));
+}
+
+long long Time::nanoseconds(const timespec &ts) noexcept {
+	return ((ts.tv_sec * 1000000000LL) + ts.tv_nsec);
+}
+
 } /* namespace wanhive */
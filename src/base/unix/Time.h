@@ -96,6 +96,12 @@ public:
 	 * @return true on success, false on error
 	 */
 	static bool now(clockid_t id, long long &milliseconds) noexcept;
+	/**
+	 * Wrapper for clock_gettime(2): retrieves time of a clock in microseconds.
+	 * @param id clock's identifier
+	 * @return microseconds value, zero (0) on error
+	 */
+	static unsigned long long microseconds(clockid_t id) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Calculates a future time value.
@@ -123,6 +129,18 @@ public:
 	 * @return milliseconds value
 	 */
 	static long long milliseconds(const timespec &ts) noexcept;
+	/**
+	 * Converts a time value to microseconds.
+	 * @param ts time value
+	 * @return microseconds value
+	 */
+	static long long microseconds(const timespec &ts) noexcept;
+	/**
+	 * Converts a time value to nanoseconds.
+	 * @param ts time value
+	 * @return nanoseconds value
+	 */
+	static long long nanoseconds(const timespec &ts) noexcept;
 private:
 	timespec ts;
 };
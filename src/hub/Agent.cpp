@@ -49,6 +49,7 @@ void Agent::expel(Watcher *w) noexcept {
 	} else if (w == bs.node) {
 		bs.node = nullptr;
 		bs.connected = false;
+		flush(); //Discards the outgoing batch
 	}
 
 	Hub::expel(w);
@@ -110,6 +111,8 @@ void Agent::maintain() noexcept {
 	case WHC_REGISTERED:
 		if (!bs.node) {
 			setStage(WHC_ERROR);
+		} else {
+			flush();
 		}
 		break;
 	default:
@@ -186,6 +189,46 @@ void Agent::setPassword(const unsigned char *password, unsigned int length,
 	}
 }
 
+bool Agent::batch(Message *message) noexcept {
+	if (!message || !message->validate() || !isConnected()
+			|| message->getCommand() == WH_CMD_BATCH
+			|| message->getLength() > (Message::MTU - Message::RECORD_SIZE)) {
+		return false;
+	}
+
+	MessageHeader header { message->buffer() };
+	if (!outgoing || !outgoing->batch(header, message->payload())) {
+		//Start a new batch
+		flush();
+		MessageHeader h;
+		h.setAddress(0, 0);
+		h.setControl(Message::HEADER_SIZE, 0, 0);
+		h.setContext(WH_CMD_BATCH, WH_QLF_NULL, WH_AQLF_REQUEST);
+		outgoing = Message::create();
+		if (!outgoing || !outgoing->putHeader(h)
+				|| !outgoing->batch(header, message->payload())) {
+			Message::recycle(outgoing);
+			outgoing = nullptr;
+			return false;
+		}
+	}
+
+	Message::recycle(message);
+	return true;
+}
+
+void Agent::flush() noexcept {
+	if (outgoing && bs.node) {
+		outgoing->setDestination(bs.node->getUid());
+		if (!Hub::forward(outgoing)) {
+			Message::recycle(outgoing);
+		}
+	} else {
+		Message::recycle(outgoing);
+	}
+	outgoing = nullptr;
+}
+
 void Agent::connectToAuthenticator() noexcept {
 	Socket *s { };
 	try {
@@ -483,7 +526,7 @@ void Agent::processTokenResponse(const Message *msg) noexcept {
 		setStage(WHC_ERROR);
 	} else if (!bs.node || msg->getOrigin() != bs.node->getUid()) {
 		setStage(WHC_ERROR);
-	} else if (!msg->verify((verifyHost() ? getPKI() : nullptr))) {
+	} else if (!msg->verify((verifyHost() ? getPKI() : nullptr), true)) {
 		setStage(WHC_ERROR);
 	} else if (!Protocol::processTokenResponse(msg, &bs.nonce)) {
 		setStage(WHC_ERROR);
@@ -602,6 +645,8 @@ void Agent::clearIdentifiers() noexcept {
 
 void Agent::clear() noexcept {
 	memset(&ctx, 0, sizeof(ctx));
+	Message::recycle(outgoing);
+	outgoing = nullptr;
 
 	clearIdentifiers();
 	bs.auth = nullptr;
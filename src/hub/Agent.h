@@ -53,6 +53,20 @@ protected:
 	 */
 	void setPassword(const unsigned char *password, unsigned int length,
 			unsigned int rounds) noexcept;
+	/**
+	 * Appends a message to the outgoing batch bound for the overlay hub (see
+	 * Packet::batch()). The batch is forwarded when it fills up or at the end
+	 * of the event loop's turn (see Agent::flush()).
+	 * @param message the message to append, it is recycled on success
+	 * @return true on success, false on error (not connected or the message
+	 * doesn't fit inside a batch), the caller retains the message.
+	 */
+	bool batch(Message *message) noexcept;
+	/**
+	 * Forwards the outgoing batch to the overlay hub. Agent::maintain() calls
+	 * it at the end of every turn, an override should do the same.
+	 */
+	void flush() noexcept;
 private:
 	void connectToAuthenticator() noexcept;
 	void connectToOverlay() noexcept;
@@ -100,6 +114,9 @@ private:
 		int stage;
 		bool connected;
 	} bs;
+	//-----------------------------------------------------------------
+	//The outgoing batch (see Agent::batch())
+	Message *outgoing { };
 };
 
 } /* namespace wanhive */
@@ -0,0 +1,223 @@
+/*
+ * FairQueue.cpp
+ *
+ * Deficit round robin scheduler of the outgoing messages
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "FairQueue.h"
+#include "../base/common/Exception.h"
+
+namespace wanhive {
+
+FairQueue::FairQueue() noexcept {
+	clear();
+}
+
+FairQueue::~FairQueue() {
+	release();
+}
+
+void FairQueue::initialize(unsigned int capacity) {
+	release();
+	try {
+		messages = new Message*[capacity];
+		links = new unsigned int[capacity];
+		flows = new Flow[capacity];
+		limit = capacity;
+		clear();
+	} catch (...) {
+		release();
+		throw Exception(EX_MEMORY);
+	}
+}
+
+void FairQueue::clear() noexcept {
+	//Every slot is vacant
+	for (unsigned int i = 0; i < limit; ++i) {
+		links[i] = i + 1;
+	}
+	vacant = limit ? 0 : NIL;
+	if (limit) {
+		links[limit - 1] = NIL;
+	}
+
+	created = 0;
+	pending = 0;
+	for (unsigned int i = 0; i < CLASSES; ++i) {
+		rounds[i].head = NIL;
+		rounds[i].tail = NIL;
+		index[i].clear();
+	}
+	idle.head = NIL;
+	idle.tail = NIL;
+}
+
+bool FairQueue::put(Message *message, unsigned int priority,
+		unsigned long long flow) noexcept {
+	if (!message || priority >= CLASSES || pending == limit) {
+		return false;
+	}
+
+	unsigned int id;
+	if (index[priority].hmGet(flow, id)) {
+		if (flows[id].head == NIL) {
+			unpark(id);
+		}
+	} else if (!allocate(priority, flow, id)) {
+		return false;
+	}
+
+	auto slot = vacant;
+	vacant = links[slot];
+	messages[slot] = message;
+	links[slot] = NIL;
+
+	auto &f = flows[id];
+	if (f.head == NIL) {
+		f.head = slot;
+		append(priority, id);
+	} else {
+		links[f.tail] = slot;
+	}
+	f.tail = slot;
+	++pending;
+	return true;
+}
+
+bool FairQueue::get(Message *&message) noexcept {
+	for (unsigned int i = 0; i < CLASSES; ++i) {
+		while (rounds[i].head != NIL) {
+			auto &f = flows[rounds[i].head];
+			auto length = messages[f.head]->getLength();
+			if (f.deficit < length) {
+				//Flow's turn is over, it earns a quantum for the next one
+				f.deficit += QUANTUM;
+				auto id = rounds[i].head;
+				remove(i);
+				append(i, id);
+				continue;
+			}
+
+			f.deficit -= length;
+			auto slot = f.head;
+			message = messages[slot];
+			f.head = links[slot];
+			links[slot] = vacant;
+			vacant = slot;
+			if (f.head == NIL) {
+				//An idle flow doesn't accumulate the credits
+				f.deficit = 0;
+				auto id = rounds[i].head;
+				remove(i);
+				park(id);
+			}
+
+			--pending;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FairQueue::isEmpty() const noexcept {
+	return pending == 0;
+}
+
+unsigned int FairQueue::readSpace() const noexcept {
+	return pending;
+}
+
+unsigned int FairQueue::capacity() const noexcept {
+	return limit;
+}
+
+void FairQueue::release() noexcept {
+	delete[] messages;
+	messages = nullptr;
+	delete[] links;
+	links = nullptr;
+	delete[] flows;
+	flows = nullptr;
+	limit = 0;
+	clear();
+}
+
+bool FairQueue::allocate(unsigned int priority, unsigned long long key,
+		unsigned int &id) noexcept {
+	/*
+	 * The active flows hold at least one message each, hence an idle flow is
+	 * always available once all the flows have been handed out.
+	 */
+	auto candidate = (created < limit) ? created : idle.head;
+	if (!index[priority].hmPut(key, candidate)) {
+		return false;
+	}
+
+	if (candidate == created) {
+		++created;
+	} else {
+		//Reuse the least recently idle flow
+		unpark(candidate);
+		index[flows[candidate].priority].removeKey(flows[candidate].key);
+	}
+
+	id = candidate;
+	flows[id] = { key, priority, NIL, NIL, 0, NIL, NIL };
+	return true;
+}
+
+void FairQueue::append(unsigned int priority, unsigned int flow) noexcept {
+	auto &r = rounds[priority];
+	flows[flow].next = NIL;
+	if (r.head == NIL) {
+		r.head = flow;
+	} else {
+		flows[r.tail].next = flow;
+	}
+	r.tail = flow;
+}
+
+void FairQueue::remove(unsigned int priority) noexcept {
+	auto &r = rounds[priority];
+	r.head = flows[r.head].next;
+	if (r.head == NIL) {
+		r.tail = NIL;
+	}
+}
+
+void FairQueue::park(unsigned int flow) noexcept {
+	auto &f = flows[flow];
+	f.next = NIL;
+	f.prev = idle.tail;
+	if (idle.tail == NIL) {
+		idle.head = flow;
+	} else {
+		flows[idle.tail].next = flow;
+	}
+	idle.tail = flow;
+}
+
+void FairQueue::unpark(unsigned int flow) noexcept {
+	auto &f = flows[flow];
+	if (f.prev == NIL) {
+		idle.head = f.next;
+	} else {
+		flows[f.prev].next = f.next;
+	}
+
+	if (f.next == NIL) {
+		idle.tail = f.prev;
+	} else {
+		flows[f.next].prev = f.prev;
+	}
+	f.next = NIL;
+	f.prev = NIL;
+}
+
+} /* namespace wanhive */
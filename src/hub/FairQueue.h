@@ -0,0 +1,130 @@
+/**
+ * @file FairQueue.h
+ *
+ * Deficit round robin scheduler of the outgoing messages
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_HUB_FAIRQUEUE_H_
+#define WH_HUB_FAIRQUEUE_H_
+#include "../base/common/NonCopyable.h"
+#include "../base/ds/Swiss.h"
+#include "../util/Message.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Weighted fair queue of messages. Messages are sorted into flows and every
+ * flow belongs to a priority class. The classes are served in strict priority
+ * order, the flows within a class are served in deficit round robin order.
+ * Every turn a flow earns a quantum of Message::MTU bytes, hence each flow
+ * gets an equal share of the bandwidth irrespective of its messages' sizes.
+ * The flows outlive their messages, the least recently idle flow makes room
+ * for a new one.
+ */
+class FairQueue: private NonCopyable {
+public:
+	/**
+	 * Constructor: creates an empty queue of zero capacity.
+	 */
+	FairQueue() noexcept;
+	/**
+	 * Destructor
+	 */
+	~FairQueue();
+	//-----------------------------------------------------------------
+	/**
+	 * Allocates the storage and empties the queue.
+	 * @param capacity maximum number of messages the queue can hold
+	 */
+	void initialize(unsigned int capacity);
+	/**
+	 * Empties the queue. The messages are not recycled.
+	 */
+	void clear() noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Inserts a message at the tail of the given flow.
+	 * @param message the message to insert
+	 * @param priority message's priority class, smaller values have higher
+	 * priority (see FairQueue::CLASSES).
+	 * @param flow flow's identifier
+	 * @return true on success, false on error (queue is full or the priority
+	 * class is invalid).
+	 */
+	bool put(Message *message, unsigned int priority,
+			unsigned long long flow) noexcept;
+	/**
+	 * Removes the next message in the service order.
+	 * @param message object for storing the removed message
+	 * @return true on success, false if the queue is empty
+	 */
+	bool get(Message *&message) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Checks whether the queue is empty.
+	 * @return true if the queue is empty, false otherwise
+	 */
+	bool isEmpty() const noexcept;
+	/**
+	 * Returns the number of messages in the queue.
+	 * @return messages count
+	 */
+	unsigned int readSpace() const noexcept;
+	/**
+	 * Returns the maximum number of messages the queue can hold.
+	 * @return queue's capacity
+	 */
+	unsigned int capacity() const noexcept;
+public:
+	/*! Number of priority classes */
+	static constexpr unsigned int CLASSES = 3;
+private:
+	void release() noexcept;
+	bool allocate(unsigned int priority, unsigned long long key,
+			unsigned int &id) noexcept;
+	void append(unsigned int priority, unsigned int flow) noexcept;
+	void remove(unsigned int priority) noexcept;
+	void park(unsigned int flow) noexcept;
+	void unpark(unsigned int flow) noexcept;
+private:
+	struct Flow {
+		unsigned long long key;
+		unsigned int priority;
+		unsigned int head;
+		unsigned int tail;
+		unsigned int deficit;
+		//Next flow in the round (active) or in the idle list
+		unsigned int next;
+		//Previous flow in the idle list
+		unsigned int prev;
+	};
+
+	struct Round {
+		unsigned int head;
+		unsigned int tail;
+	};
+
+	static constexpr unsigned int NIL = 0xffffffff;
+	static constexpr unsigned int QUANTUM = Message::MTU;
+
+	Message **messages { };
+	unsigned int *links { };
+	Flow *flows { };
+	unsigned int limit { };
+	unsigned int vacant { };
+	unsigned int created { };
+	unsigned int pending { };
+	Round rounds[CLASSES];
+	Round idle;
+	Smap<unsigned long long, unsigned int> index[CLASSES];
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_HUB_FAIRQUEUE_H_ */
@@ -13,8 +13,32 @@
 #include "Hub.h"
 #include "../base/common/Logger.h"
 #include "../base/Signal.h"
+#include "../base/unix/Time.h"
+#include "../util/commands.h"
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 
+namespace {
+
+//Returns the pool's size limit (factor 0 or 1 = fixed size)
+unsigned int scale(unsigned int size, unsigned int factor) noexcept {
+	auto limit = ((unsigned long long) size) * (factor ? factor : 1);
+	return (limit < UINT_MAX) ? limit : UINT_MAX;
+}
+
+//Summarizes a histogram
+wanhive::DistributionInfo summarize(const wanhive::Histogram &h) noexcept {
+	auto clip = [](unsigned long long value) -> unsigned int {
+		return (value < UINT_MAX) ? value : UINT_MAX;
+	};
+	return { h.count(), clip(h.percentile(50)), clip(h.percentile(90)), clip(
+			h.percentile(99)), clip(h.max()) };
+}
+
+}  // namespace
+
 namespace wanhive {
 
 Hub::Hub(unsigned long long uid, const char *path) noexcept :
@@ -79,9 +103,18 @@ void Hub::metrics(HubInfo &info) const noexcept {
 	info.setUptime(uptime.elapsed());
 	info.setReceived(traffic.received);
 	info.setDropped(traffic.dropped);
-	info.setConnections( { Socket::poolSize(), Socket::allocated() });
-	info.setMessages( { Message::poolSize(), Message::allocated() });
+	info.setConnections( { Socket::poolLimit(), Socket::allocated() });
+	info.setMessages( { Message::poolLimit(), Message::allocated() });
 	info.setMTU(Message::MTU);
+	info.setPageType(Message::pageType());
+	info.setErrands( { offload.capacity(), offload.load() });
+	info.setLatency(
+			errands.completed ? (errands.delay / errands.completed) : 0);
+	info.setDelay(summarize(profile.io.delay));
+	info.setTurn(summarize(profile.turn));
+	info.setInflow(summarize(profile.inflow));
+	info.setOutflow(summarize(profile.io.messages));
+	info.setVolume(summarize(profile.io.bytes));
 }
 
 bool Hub::redact() const noexcept {
@@ -121,6 +154,16 @@ Watcher* Hub::move(unsigned long long from, unsigned long long to,
 			disable(w[0]);
 		}
 		w[1]->setFlags(WATCHER_ACTIVE);
+		//Lease is over, start tracking the inactivity (if required)
+		if (ctx.idle) {
+			schedule(w[1], ctx.idle);
+		} else {
+			unschedule(w[1]);
+		}
+		//Keep track of the held back output under the new key
+		if (ctx.coalesce && w[1]->push()) {
+			recork(from, to);
+		}
 		return w[1];
 	} else {
 		disable(w[0]);
@@ -164,6 +207,23 @@ unsigned int Hub::reap(unsigned int target, bool force) noexcept {
 	return count;
 }
 
+bool Hub::schedule(Watcher *w, unsigned int milliseconds) noexcept {
+	if (w && prime.alarm && ctx.interval) {
+		auto &d = w->getDeadline();
+		wheel.touch(d);
+		wheel.schedule(d, ticks(milliseconds));
+		return true;
+	} else {
+		return false;
+	}
+}
+
+void Hub::unschedule(Watcher *w) noexcept {
+	if (w) {
+		wheel.cancel(w->getDeadline());
+	}
+}
+
 bool Hub::collect(Message *message) noexcept {
 	if (message && !message->isMarked() && message->validate()
 			&& in.put(message)) {
@@ -185,6 +245,52 @@ bool Hub::forward(Message *message) noexcept {
 	}
 }
 
+bool Hub::withhold(Message *message) noexcept {
+	if (message && !message->testFlags(MSG_DEFERRED)) {
+		message->setFlags(MSG_DEFERRED);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool Hub::resume(Message *message) noexcept {
+	if (!message) {
+		return false;
+	}
+
+	message->clearFlags(MSG_DEFERRED);
+	if (out.put(message)) {
+		message->setFlags(MSG_PROCESSED);
+		message->setMarked();
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool Hub::delegate(unsigned int type, Message *message, void *arg) noexcept {
+	if (!message || message->testFlags(MSG_DEFERRED)) {
+		return false;
+	}
+
+	Errand errand { type, message, arg, 0, 0 };
+	Time::now(CLOCK_MONOTONIC, errand.posted);
+	//Set before the handover, the worker owns the message afterwards
+	message->setFlags(MSG_DEFERRED);
+	if (offload.post(errand)) {
+		return true;
+	} else {
+		message->clearFlags(MSG_DEFERRED);
+		return false;
+	}
+}
+
+void Hub::settle() noexcept {
+	offload.settle();
+	deliver();
+}
+
 void Hub::admit(Watcher *w) {
 	if (w->getReference() == nullptr) {
 		w->start();
@@ -206,6 +312,7 @@ void Hub::expel(Watcher *w) noexcept {
 	if (!w->testFlags(WATCHER_CRITICAL)) {
 		auto id = w->getUid();
 		watchers.remove(id);
+		wheel.cancel(w->getDeadline());
 		w->stop();
 		delete w;
 		WH_LOG_DEBUG("Watcher %llu recycled", id);
@@ -236,33 +343,48 @@ void Hub::configure(void *arg) {
 		ctx.interval = conf.getNumber("HUB", "interval");
 		ctx.semaphore = conf.getBoolean("HUB", "semaphore");
 		ctx.signal = conf.getBoolean("HUB", "signal");
+		ctx.uring = conf.getBoolean("HUB", "uring");
+		ctx.workers = conf.getNumber("HUB", "workers");
+		ctx.errands = conf.getNumber("HUB", "errands", 256);
 
 		ctx.connections = conf.getNumber("HUB", "connections");
 		ctx.messages = conf.getNumber("HUB", "messages");
+		ctx.ceiling = conf.getNumber("HUB", "ceiling");
+		//Pools can grow up to <ceiling> times their initial size
+		ctx.maxConnections = scale(ctx.connections, ctx.ceiling);
+		ctx.maxMessages = scale(ctx.messages, ctx.ceiling);
 		//Take care of the "special" cases: [1, 2, power-of-two]
-		if (ctx.messages == 1 || ctx.messages == 2) {
-			ctx.messages = 3;
-		} else if (Twiddler::isPower2(ctx.messages)) { //false for 0
-			ctx.messages -= 1;
+		if (ctx.maxMessages == 1 || ctx.maxMessages == 2) {
+			ctx.maxMessages = 3;
+		} else if (Twiddler::isPower2(ctx.maxMessages)) { //false for 0
+			ctx.maxMessages -= 1;
 		}
+		ctx.messages = Twiddler::min(ctx.messages, ctx.maxMessages);
+		ctx.hugepages = conf.getBoolean("HUB", "hugepages");
 
 		ctx.guests = conf.getNumber("HUB", "guests");
 		//Take care of the special case: Hub not listening
 		if (ctx.listen) {
-			ctx.guests = Twiddler::min(ctx.guests, ctx.connections);
+			ctx.guests = Twiddler::min(ctx.guests, ctx.maxConnections);
 		} else {
 			ctx.guests = 0;
 		}
 		ctx.lease = conf.getNumber("HUB", "lease");
+		ctx.idle = conf.getNumber("HUB", "idle");
 
 		ctx.inward = conf.getNumber("HUB", "inward");
 		ctx.outward = conf.getNumber("HUB", "outward");
 		ctx.outward = Twiddler::min(ctx.outward, (Socket::OUT_QUEUE_SIZE - 1));
+		ctx.coalesce = conf.getNumber("HUB", "coalesce");
+		ctx.coalesce = Twiddler::min(ctx.coalesce, 1000U);
+		ctx.sojourn = conf.getNumber("HUB", "sojourn");
+		ctx.sojourn = Twiddler::min(ctx.sojourn, 1000U);
 
 		ctx.regulate = conf.getBoolean("HUB", "regulate");
+		ctx.fair = conf.getBoolean("HUB", "fair", false);
 
 		ctx.reserved = conf.getNumber("HUB", "reserved");
-		ctx.reserved = Twiddler::min(ctx.reserved, ctx.messages);
+		ctx.reserved = Twiddler::min(ctx.reserved, ctx.maxMessages);
 		ctx.ttl = conf.getNumber("HUB", "TTL");
 
 		ctx.answer = conf.getDouble("HUB", "answer", 0.5);
@@ -271,18 +393,35 @@ void Hub::configure(void *arg) {
 		ctx.logging = conf.getNumber("HUB", "logging", WH_LOGLEVEL_DEBUG);
 		Logger::getDefault().setLevel(ctx.logging);
 		ctx.logging = Logger::getDefault().getLevel();
+		auto logfile = conf.getPathName("HUB", "logfile");
+		if (logfile && !Logger::getDefault().setFile(logfile)) {
+			WH_LOG_WARNING("Could not open the log file");
+		}
+		::free(logfile);
+		ctx.journal = conf.getNumber("HUB", "journal");
+		if (!Logger::getDefault().setAsync(ctx.journal)) {
+			WH_LOG_WARNING("Asynchronous logging disabled");
+			ctx.journal = 0;
+		}
 		ctx.redact = conf.getBoolean("OPT", "redact", true);
+		ctx.profile = conf.getBoolean("HUB", "profile");
 		//-----------------------------------------------------------------
 		WH_LOG_DEBUG(
-				"\nLISTEN=%s, BACKLOG=%d, SERVICE_NAME='%s', SERVICE_TYPE='%s',\n" "IO_EVENTS=%u, TIMER_EXPIRATION=%ums, TIMER_INTERVAL=%ums, SEMAPHORE=%s,\n" "SYNCHRONOUS_SIGNAL=%s, CONNECTIONS=%u, MESSAGES=%u,\n" "NEW_CONNECTIONS=%u, NEW_CONNECTION_TIMEOUT=%ums, CYCLE_IN_LIMIT=%u,\n" "OUT_QUEUE_LIMIT=%u, TRAFFIC_CONTROL=%s, RESERVED_MESSAGES=%u,\n" "MESSAGE_TTL=%u, ANSWER_RATIO=%f, FORWARD_RATIO=%f,\n" "LOG_LEVEL=%s, REDACT=%s\n",
-				WH_BOOLF(ctx.listen), ctx.backlog, ctx.name, ctx.type,
-				ctx.events, ctx.expiration, ctx.interval,
-				WH_BOOLF(ctx.semaphore), WH_BOOLF(ctx.signal), ctx.connections,
-				ctx.messages, ctx.guests, ctx.lease, ctx.inward, ctx.outward,
-				WH_BOOLF(ctx.regulate), ctx.reserved, ctx.ttl, ctx.answer,
-				ctx.forward,
+				"\nLISTEN=%s, BACKLOG=%d, SERVICE_NAME='%s', SERVICE_TYPE='%s',\n" "IO_EVENTS=%u, TIMER_EXPIRATION=%ums, TIMER_INTERVAL=%ums,\n" "SEMAPHORE=%s, SYNCHRONOUS_SIGNAL=%s, IO_URING=%s, WORKERS=%u [%u],\n" "CONNECTIONS=%u/%u, MESSAGES=%u/%u, HUGE_PAGES=%s, NEW_CONNECTIONS=%u,\n" "NEW_CONNECTION_TIMEOUT=%ums, IDLE_TIMEOUT=%ums, CYCLE_IN_LIMIT=%u, OUT_QUEUE_LIMIT=%u, COALESCE=%ums,\n" "TARGET_DELAY=%ums, " "TRAFFIC_CONTROL=%s, FAIR_QUEUING=%s,\n" "RESERVED_MESSAGES=%u, MESSAGE_TTL=%u, ANSWER_RATIO=%f, FORWARD_RATIO=%f,\n" "LOG_LEVEL=%s, LOG_TARGET=%s, LOG_QUEUE=%u, REDACT=%s, PROFILE=%s\n",
+				WH_BOOLF(ctx.listen), ctx.backlog,
+				ctx.name, ctx.type, ctx.events, ctx.expiration, ctx.interval,
+				WH_BOOLF(ctx.semaphore), WH_BOOLF(ctx.signal),
+				WH_BOOLF(ctx.uring), ctx.workers, ctx.errands,
+				ctx.connections, ctx.maxConnections,
+				ctx.messages, ctx.maxMessages, WH_BOOLF(ctx.hugepages),
+				ctx.guests,
+				ctx.lease, ctx.idle, ctx.inward, ctx.outward, ctx.coalesce,
+				ctx.sojourn,
+				WH_BOOLF(ctx.regulate), WH_BOOLF(ctx.fair),
+				ctx.reserved, ctx.ttl, ctx.answer, ctx.forward,
 				Logger::levelString(Logger::getDefault().getLevel()),
-				WH_BOOLF(ctx.redact));
+				Logger::targetString(Logger::getDefault().getTarget()),
+				ctx.journal, WH_BOOLF(ctx.redact), WH_BOOLF(ctx.profile));
 		//-----------------------------------------------------------------
 		/*
 		 * Initialization of the core data structures
@@ -294,6 +433,7 @@ void Hub::configure(void *arg) {
 		initEvent();
 		initInotifier();
 		initInterrupt();
+		initOffload();
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		throw;
@@ -308,18 +448,28 @@ void Hub::cleanup() noexcept {
 	try {
 		WH_LOG_INFO("Shutdown initiated....");
 		//-----------------------------------------------------------------
-		//1. Wait for the worker
+		//1. Wait for the worker and stop the offload workers
 		await();
+		offload.stop();
 		//-----------------------------------------------------------------
 		//2. Disconnect: recycle all watchers
+		wheel.clear();
 		iterate(deleteWatchers, nullptr);
 		//-----------------------------------------------------------------
 		//3. Clean up all the containers
 		guests.clear();
+		corked.clear();
+		Errand errand;
+		while (offload.collect(errand)) {
+			Message::recycle(errand.message);
+		}
 		Message *msg;
 		while (out.get(msg)) {
 			Message::recycle(msg);
 		}
+		while (outbound.get(msg)) {
+			Message::recycle(msg);
+		}
 		while (in.get(msg)) {
 			Message::recycle(msg);
 		}
@@ -327,6 +477,7 @@ void Hub::cleanup() noexcept {
 		//4. Destroy all the memory pools
 		Socket::destroyPool();
 		Message::destroyPool();
+		Socket::setProfile(nullptr);
 		//-----------------------------------------------------------------
 		//5. Clear the internal structures
 		clear();
@@ -362,10 +513,43 @@ void Hub::route(Message *message) noexcept {
 
 }
 
+void Hub::perform(Errand &errand) noexcept {
+
+}
+
+void Hub::onCompletion(Errand &errand) noexcept {
+
+}
+
 void Hub::onAlarm(unsigned long long uid, unsigned long long ticks) noexcept {
 
 }
 
+void Hub::onTimeout(Watcher *w) noexcept {
+	if (w->testFlags(WATCHER_CRITICAL)) {
+		return;
+	} else if (!w->testFlags(WATCHER_ACTIVE)) {
+		//Temporary connection: enforce the lease
+		if (w->hasTimedOut(ctx.lease)) {
+			WH_LOG_DEBUG("Lease of connection %llu has expired", w->getUid());
+			disable(w);
+		} else {
+			schedule(w, 0);
+		}
+	} else if (ctx.idle) {
+		//Registered connection: evict if idle for too long
+		auto &d = w->getDeadline();
+		auto limit = ticks(ctx.idle);
+		auto elapsed = wheel.now() - d.touched;
+		if (elapsed >= limit) {
+			WH_LOG_DEBUG("Connection %llu is idle, evicting", w->getUid());
+			disable(w);
+		} else {
+			wheel.schedule(d, limit - elapsed);
+		}
+	}
+}
+
 void Hub::onEvent(unsigned long long uid, unsigned long long events) noexcept {
 
 }
@@ -401,6 +585,13 @@ bool Hub::handle(Alarm *alarm) noexcept {
 		//-----------------------------------------------------------------
 		if (count) {
 			auto uid = (alarm == prime.alarm ? 0 : alarm->getUid());
+			if (alarm == prime.alarm) {
+				//Deliver the expired timeouts
+				wheel.advance(count, expire, this);
+				//Gradually shrink the idle pools
+				Socket::trimPool();
+				Message::trimPool();
+			}
 			onAlarm(uid, count);
 		}
 		return alarm->isReady();
@@ -421,7 +612,11 @@ bool Hub::handle(Event *event) noexcept {
 			return disable(event);
 		}
 		//-----------------------------------------------------------------
-		if (count) {
+		if (!count) {
+			//Nothing to do
+		} else if (event == prime.offload) {
+			deliver();
+		} else {
 			auto uid = (event == prime.event ? 0 : event->getUid());
 			onEvent(uid, count);
 		}
@@ -551,10 +746,16 @@ void Hub::setup(void *arg) {
 void Hub::loop() {
 	while (running) {
 		poll(out.isEmpty());
+		auto start = ctx.profile ? Time::microseconds(CLOCK_MONOTONIC) : 0;
 		publish();
 		dispatch();
 		process();
+		push();
 		maintain();
+		if (start) {
+			auto finish = Time::microseconds(CLOCK_MONOTONIC);
+			profile.turn.record(finish > start ? (finish - start) : 0);
+		}
 	}
 }
 
@@ -562,16 +763,22 @@ void Hub::initBuffers() {
 	try {
 		//Set up SSL/TLS
 		Socket::setSSLContext(getSSLContext());
+		//Set up the transmission profile
+		Socket::setProfile(ctx.profile ? &profile.io : nullptr);
 		//Initialize the connections pool
-		Socket::initPool(ctx.connections);
+		Socket::initPool(ctx.connections, ctx.hugepages, ctx.maxConnections);
 		//Initialize the message Pool
-		Message::initPool(ctx.messages);
+		Message::initPool(ctx.messages, ctx.hugepages, ctx.maxMessages);
 		//Stores incoming messages for processing
-		in.initialize(ctx.messages);
+		in.initialize(ctx.maxMessages);
 		//Stores messages ready for publishing
-		out.initialize(ctx.messages);
+		out.initialize(ctx.maxMessages);
+		//Schedules the messages ready for publishing
+		outbound.initialize(ctx.fair ? ctx.maxMessages : 0);
 		//Stores temporary connection identifiers
 		guests.initialize(ctx.guests);
+		//Stores the identifiers of connections holding back their output
+		corked.initialize(ctx.coalesce ? ctx.maxConnections : 0);
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		throw;
@@ -580,7 +787,7 @@ void Hub::initBuffers() {
 
 void Hub::initReactor() {
 	try {
-		Reactor::initialize(ctx.events, !ctx.signal);
+		Reactor::initialize(ctx.events, !ctx.signal, ctx.uring);
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		throw;
@@ -701,6 +908,35 @@ void Hub::initInterrupt() {
 	}
 }
 
+void Hub::initOffload() {
+	Event *event = nullptr;
+	try {
+		if (ctx.workers && ctx.errands) {
+			event = new Event(false);
+			attach(event, IO_READ, (WATCHER_ACTIVE | WATCHER_CRITICAL));
+			prime.offload = event;
+			offload.start(ctx.workers, ctx.errands, work, this, event);
+			WH_LOG_DEBUG("%u offload workers started", ctx.workers);
+		} else {
+			WH_LOG_DEBUG("Offload workers disabled");
+			prime.offload = nullptr;
+			return;
+		}
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+		if (!prime.offload) {
+			delete event;
+		}
+		throw;
+	} catch (...) {
+		WH_LOG_EXCEPTION_U();
+		if (!prime.offload) {
+			delete event;
+		}
+		throw Exception(EX_MEMORY);
+	}
+}
+
 void Hub::async(void *arg) {
 	try {
 		if (Job::start(arg)) {
@@ -724,6 +960,30 @@ void Hub::await() {
 	}
 }
 
+void Hub::deliver() noexcept {
+	Errand errand;
+	while (offload.collect(errand)) {
+		complete(errand);
+	}
+}
+
+void Hub::complete(Errand &errand) noexcept {
+	errands.completed += 1;
+	double now = 0;
+	if (Time::now(CLOCK_MONOTONIC, now) && now > errand.posted) {
+		errands.delay += (now - errand.posted);
+	}
+	//The message returns to the event loop
+	auto message = errand.message;
+	message->clearFlags(MSG_DEFERRED);
+	onCompletion(errand);
+	if (!resume(message)) {
+		//Outgoing queue is full
+		countDropped(message->getLength());
+		Message::recycle(message);
+	}
+}
+
 void Hub::publish() noexcept {
 	//-----------------------------------------------------------------
 	/*
@@ -737,26 +997,27 @@ void Hub::publish() noexcept {
 	//-----------------------------------------------------------------
 	Message *msg = nullptr;
 	Watcher *w = nullptr;
-	while (out.get(msg)) {
-		//-----------------------------------------------------------------
-		//Sanity check
-		if (!msg->validate()) {
-			Message::recycle(msg);
-			continue;
-		}
-
-		//Trap the message (e.g. registration request)
-		if (msg->testFlags(MSG_PROBE) && probe(msg)) {
-			//Do not forward
-			Message::recycle(msg);
-			continue;
+	/*
+	 * Weighted Fair Queuing (WFQ): sort the messages into flows, one per
+	 * origin, so that a chatty source cannot starve the others. The flows are
+	 * served in deficit round robin order within their priority classes.
+	 */
+	if (ctx.fair) {
+		while (out.get(msg)) {
+			if ((w = admit(msg))) {
+				outbound.put(msg, classify(msg, w), msg->getOrigin());
+			}
 		}
+	}
 
-		//Verify the destination
-		if (msg->getDestination() == getUid()
-				|| !(w = find(msg->getDestination()))
-				|| w->testGroup(msg->getGroup())) {
-			//Destination is sink or not found or group conflict
+	while (ctx.fair ? outbound.get(msg) : out.get(msg)) {
+		//-----------------------------------------------------------------
+		if (!ctx.fair) {
+			if (!(w = admit(msg))) {
+				continue;
+			}
+		} else if (!(w = find(msg->getDestination()))) {
+			//Destination disappeared in the meantime
 			Message::recycle(msg);
 			continue;
 		}
@@ -776,23 +1037,198 @@ void Hub::publish() noexcept {
 		}
 		//-----------------------------------------------------------------
 		if (!w->publish(msg)) {
-			//Recipient's queue is full, retry later
-			in.put(msg);
+			if (w->testFlags(SOCKET_CONGESTED)
+					&& !msg->testFlags(MSG_PRIORITY)) {
+				//Recipient's queue is shedding the load
+				countDropped(msg->getLength());
+				Message::recycle(msg);
+			} else {
+				//Recipient's queue is full, retry later
+				in.put(msg);
+			}
 		} else if (w->testEvents(IO_WRITE)) {
 			retain(w);
 		}
 	}
 }
 
+Watcher* Hub::admit(Message *message) noexcept {
+	//Sanity check
+	if (!message->validate()) {
+		Message::recycle(message);
+		return nullptr;
+	}
+
+	//Trap the message (e.g. registration request)
+	if (message->testFlags(MSG_PROBE) && probe(message)) {
+		//Do not forward
+		Message::recycle(message);
+		return nullptr;
+	}
+
+	//Verify the destination
+	auto w = recipient(message);
+	if (!w) {
+		Message::recycle(message);
+	}
+	return w;
+}
+
+Watcher* Hub::recipient(const Message *message) const noexcept {
+	Watcher *w = nullptr;
+	if (message->getDestination() == getUid()
+			|| !(w = find(message->getDestination()))
+			|| w->testGroup(message->getGroup())) {
+		//Destination is sink or not found or group conflict
+		return nullptr;
+	} else {
+		return w;
+	}
+}
+
+unsigned int Hub::classify(const Message *message,
+		const Watcher *w) const noexcept {
+	if (message->testFlags(MSG_PRIORITY)) {
+		return 0;
+	} else if (w->testFlags(SOCKET_OVERLAY)) {
+		return 1;
+	} else {
+		return 2;
+	}
+}
+
 void Hub::process() noexcept {
 	Message *message;
 	while (in.get(message)) {
 		if (!message->testFlags(MSG_PROCESSED)) {
-			//All the other flags are cleared
-			message->putFlags(MSG_PROCESSED);
+			//All the other flags except the priority are cleared
+			message->putFlags(
+					MSG_PROCESSED | (message->getFlags() & MSG_PRIORITY));
+			if (message->getCommand() == WH_CMD_BATCH && !unbatch(message)) {
+				//Empty or malformed batch
+				Message::recycle(message);
+				continue;
+			}
 			route(message);
 		}
-		out.put(message);
+
+		if (!message->testFlags(MSG_DEFERRED)) {
+			out.put(message);
+		}
+	}
+}
+
+bool Hub::unbatch(Message *message) noexcept {
+	/*
+	 * The records are routed in order straight from the batch. A record keeps
+	 * its message only if it is queued up for delivery, an undeliverable
+	 * record's message is reused for the next record. The last record takes
+	 * over the batch's message.
+	 */
+	MessageHeader header;
+	const unsigned char *data = nullptr;
+	unsigned int offset = 0;
+	Message *record = nullptr;
+	while (message->unbatch(offset, header, data)) {
+		auto size = header.getLength() - Message::HEADER_SIZE;
+		if (header.getCommand() == WH_CMD_BATCH) {
+			//Batches don't nest
+			countDropped(header.getLength());
+			continue;
+		} else if (offset == message->getPayloadLength()) {
+			Message::recycle(record);
+			return message->adopt(header, data);
+		}
+
+		//Unpacking doesn't eat into the messages reserved for the overlay
+		if (!record && ((Message::unallocated() <= ctx.reserved
+				&& !message->testFlags(MSG_PRIORITY))
+				|| !(record = Message::create(message->getOrigin())))) {
+			countDropped(header.getLength());
+			continue;
+		}
+
+		record->clear();
+		record->setType(message->getType());
+		record->putTrace(message->getTrace());
+		record->setGroup(message->getGroup());
+		record->setStamp(message->getStamp());
+		record->putFlags(message->getFlags());
+		record->setMarked();
+		if (!record->putHeader(header)) {
+			continue;
+		}
+
+		memcpy(record->payload(), data, size);
+		route(record);
+		if (record->testFlags(MSG_DEFERRED)) {
+			//Withheld by the hub
+			record = nullptr;
+		} else if (record->testFlags(MSG_PROBE) || record->isLinked()
+				|| recipient(record)) {
+			//Queued up or shared (e.g. multicast)
+			out.put(record);
+			record = nullptr;
+		}
+	}
+	Message::recycle(record);
+	return false;
+}
+
+void Hub::push() noexcept {
+	if (!ctx.coalesce) {
+		return;
+	}
+
+	auto count = corked.readSpace();
+	unsigned long long id;
+	while (count-- && corked.get(id)) { //postfix --
+		auto w = find(id);
+		if (w && w->push()) {
+			corked.put(id);
+		}
+	}
+	//-----------------------------------------------------------------
+	//Wake up often enough to push out the held back output in time
+	auto timeout = getTimeout();
+	if (wakeup.shortened && timeout != wakeup.shortened) {
+		//The derived hub has set a new timeout in the meantime
+		wakeup.shortened = 0;
+	}
+
+	if (!wakeup.shortened) {
+		wakeup.configured = timeout;
+	}
+
+	auto interval = (int) ((ctx.coalesce + 3) / 4);
+	if (corked.isEmpty()
+			|| (wakeup.configured >= 0 && wakeup.configured <= interval)) {
+		//Restore the configured timeout
+		setTimeout(wakeup.configured);
+		wakeup.shortened = 0;
+	} else {
+		setTimeout(interval);
+		wakeup.shortened = interval;
+	}
+}
+
+void Hub::recork(unsigned long long from, unsigned long long to) noexcept {
+	//Replace the stale key in place, every key must appear only once
+	auto count = corked.readSpace();
+	auto found = false;
+	unsigned long long id;
+	while (count-- && corked.get(id)) { //postfix --
+		if (id == to) {
+			continue;
+		} else if (id == from) {
+			id = to;
+			found = true;
+		}
+		corked.put(id);
+	}
+
+	if (!found && !corked.put(to)) {
+		WH_LOG_WARNING("Held back output of %llu not tracked", to);
 	}
 }
 
@@ -821,6 +1257,9 @@ bool Hub::acceptConnection(Socket *listener) noexcept {
 		if (guests.put(newConn->getUid())) {
 			attach(newConn, IO_WR, 0);
 			newConn->setOption(WATCHER_OUTBOUND_MAX, ctx.outward);
+			newConn->setOption(WATCHER_COALESCE, ctx.coalesce);
+			newConn->setOption(WATCHER_SOJOURN, ctx.sojourn);
+			schedule(newConn, ctx.lease);
 		} else {
 			throw Exception(EX_OVERFLOW);
 		}
@@ -838,12 +1277,20 @@ bool Hub::processConnection(Socket *connection) noexcept {
 		//First drain out all the messages
 		if (connection->testEvents(IO_WRITE)
 				&& connection->testFlags(WATCHER_OUT)) {
+			auto held = connection->held();
 			connection->write();
+			if (!held && connection->held()) {
+				//If there is no room then the kernel pushes it out eventually
+				corked.put(connection->getUid());
+			}
 		}
 
 		//Read from the socket
-		if (connection->testEvents(IO_READ) && (connection->read() == -1)) {
-			return disable(connection);
+		if (connection->testEvents(IO_READ)) {
+			if (connection->read() == -1) {
+				return disable(connection);
+			}
+			wheel.touch(connection->getDeadline());
 		}
 		//-----------------------------------------------------------------
 		/*
@@ -865,15 +1312,28 @@ bool Hub::processConnection(Socket *connection) noexcept {
 		while (msgCount < cycleLimit) {
 			Message *message = connection->obtain();
 			if (message) {
+				//Priority class of the fair queue (see Hub::classify())
+				if (ctx.fair && connection->testFlags(SOCKET_PRIORITY)) {
+					message->setFlags(MSG_PRIORITY);
+				}
 				in.put(message);
 				countReceived(message->getLength());
-				msgCount++;
+				//A batch counts as the messages it carries
+				if (message->getCommand() == WH_CMD_BATCH) {
+					msgCount += Twiddler::max(message->records(), 1);
+				} else {
+					msgCount++;
+				}
 			} else {
 				break;
 			}
 		}
+
+		if (ctx.profile && msgCount) {
+			profile.inflow.record(msgCount);
+		}
 		//-----------------------------------------------------------------
-		return connection->isReady() || (ctx.inward && (msgCount == cycleLimit));
+		return connection->isReady() || (ctx.inward && (msgCount >= cycleLimit));
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		return disable(connection);
@@ -946,10 +1406,30 @@ void Hub::countDropped(unsigned int bytes) noexcept {
 void Hub::clear() noexcept {
 	running = 0;
 	memset(&traffic, 0, sizeof(traffic));
+	memset(&errands, 0, sizeof(errands));
+	memset(&wakeup, 0, sizeof(wakeup));
+	profile.io.delay.reset();
+	profile.io.messages.reset();
+	profile.io.bytes.reset();
+	profile.turn.reset();
+	profile.inflow.reset();
 	memset(&prime, 0, sizeof(prime));
 	memset(&ctx, 0, sizeof(ctx));
 }
 
+unsigned long long Hub::ticks(unsigned int milliseconds) const noexcept {
+	return ((unsigned long long) milliseconds + ctx.interval - 1) / ctx.interval;
+}
+
+void Hub::expire(Deadline *d, void *arg) noexcept {
+	auto hub = static_cast<Hub*>(arg);
+	hub->onTimeout(static_cast<Watcher*>(d->owner));
+}
+
+void Hub::work(Errand &errand, void *arg) noexcept {
+	static_cast<Hub*>(arg)->perform(errand);
+}
+
 int Hub::deleteWatchers(Watcher *w, void *arg) noexcept {
 	delete w;
 	return 1; // Remove the key from the hash table
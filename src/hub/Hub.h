@@ -14,12 +14,14 @@
 #define WH_HUB_HUB_H_
 #include "Alarm.h"
 #include "Event.h"
+#include "FairQueue.h"
 #include "HubInfo.h"
 #include "Identity.h"
 #include "Inotifier.h"
 #include "Interrupt.h"
 #include "Job.h"
 #include "Logic.h"
+#include "Offload.h"
 #include "Socket.h"
 #include "Stream.h"
 #include "Watchers.h"
@@ -27,6 +29,7 @@
 #include "../base/Thread.h"
 #include "../base/ds/Buffer.h"
 #include "../base/ds/CircularBuffer.h"
+#include "../base/ds/TimerWheel.h"
 #include "../reactor/Handler.h"
 #include "../reactor/Reactor.h"
 
@@ -174,6 +177,21 @@ protected:
 	 * @return purged connections count
 	 */
 	unsigned int reap(unsigned int target = 0, bool force = false) noexcept;
+	/**
+	 * Watcher management: schedules (or reschedules) a watcher's timeout. The
+	 * timeouts are driven by the periodic internal timer, hence the resolution
+	 * is one timer interval. Hub::onTimeout() is invoked on expiration.
+	 * @param w the watcher
+	 * @param milliseconds the timeout value in milliseconds
+	 * @return true on success, false if the periodic internal timer is not
+	 * available.
+	 */
+	bool schedule(Watcher *w, unsigned int milliseconds) noexcept;
+	/**
+	 * Watcher management: cancels a watcher's timeout (if scheduled).
+	 * @param w the watcher
+	 */
+	void unschedule(Watcher *w) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Message queuing: puts a message directly into the incoming queue.
@@ -187,6 +205,41 @@ protected:
 	 * @return true on success, false on error
 	 */
 	bool forward(Message *message) noexcept;
+	/**
+	 * Message queuing: withholds a message during Hub::route() instead of
+	 * putting it into the outgoing queue. The caller owns the message until
+	 * it hands the message back with Hub::resume() (or recycles it).
+	 * @param message a message to withhold
+	 * @return true on success, false if the message is already withheld
+	 */
+	bool withhold(Message *message) noexcept;
+	/**
+	 * Message queuing: puts a message which was withheld (see Hub::withhold())
+	 * into the outgoing queue.
+	 * @param message a withheld message
+	 * @return true on success, false on error
+	 */
+	bool resume(Message *message) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Offloading: hands over a message to the worker threads for a CPU
+	 * intensive operation (see Hub::perform()). The message is withheld until
+	 * the operation's completion (see Hub::onCompletion()), after that it is
+	 * put into the outgoing queue. Call it during Hub::route() or with a
+	 * message which doesn't belong to any queue.
+	 * @param type operation's type (defined by the derived class)
+	 * @param message the message to work on
+	 * @param arg additional argument
+	 * @return true on success, false if the worker threads are disabled or
+	 * busy (carry out the operation synchronously).
+	 */
+	bool delegate(unsigned int type, Message *message,
+			void *arg = nullptr) noexcept;
+	/**
+	 * Offloading: waits for the completion of all the delegated operations
+	 * and delivers their results.
+	 */
+	void settle() noexcept;
 	//-----------------------------------------------------------------
 	/*
 	 * Reactor interface implementation
@@ -222,7 +275,27 @@ private:
 	 * @param message incoming message
 	 */
 	virtual void route(Message *message) noexcept;
+	/**
+	 * Adapter: carries out a delegated operation (see Hub::delegate()). This
+	 * method is called by a worker thread, it should only modify the message
+	 * and the errand.
+	 * @param errand the delegated operation
+	 */
+	virtual void perform(Errand &errand) noexcept;
+	/**
+	 * Adapter: callback for the completion of a delegated operation.
+	 * @param errand the completed operation
+	 */
+	virtual void onCompletion(Errand &errand) noexcept;
 	//-----------------------------------------------------------------
+	/**
+	 * Adapter: handles a watcher's timeout (see Hub::schedule()). The default
+	 * implementation disables the temporary connections whose lease has
+	 * expired and the registered connections which stayed idle for longer
+	 * than the configured limit.
+	 * @param w the watcher whose timeout has expired
+	 */
+	virtual void onTimeout(Watcher *w) noexcept;
 	/**
 	 * Adapter: callback for periodic timer expiration.
 	 * @param uid source identifier
@@ -299,6 +372,7 @@ private:
 	void initEvent();
 	void initInotifier();
 	void initInterrupt();
+	void initOffload();
 	//-----------------------------------------------------------------
 	/*
 	 * Job (asynchronous task) management
@@ -306,11 +380,24 @@ private:
 	void async(void *arg);
 	void await();
 	//-----------------------------------------------------------------
+	/*
+	 * Offloaded operations management
+	 */
+	void deliver() noexcept;
+	void complete(Errand &errand) noexcept;
+	static void work(Errand &errand, void *arg) noexcept;
+	//-----------------------------------------------------------------
 	/*
 	 * Message processing
 	 */
 	void publish() noexcept;
+	Watcher* admit(Message *message) noexcept;
+	Watcher* recipient(const Message *message) const noexcept;
+	unsigned int classify(const Message *message, const Watcher *w) const noexcept;
 	void process() noexcept;
+	bool unbatch(Message *message) noexcept;
+	void push() noexcept;
+	void recork(unsigned long long from, unsigned long long to) noexcept;
 	//-----------------------------------------------------------------
 	/*
 	 * Connection and stream management
@@ -332,6 +419,11 @@ private:
 	 */
 	void clear() noexcept;
 	static int deleteWatchers(Watcher *w, void *arg) noexcept;
+	/*
+	 * Timeout helpers
+	 */
+	unsigned long long ticks(unsigned int milliseconds) const noexcept;
+	static void expire(Deadline *d, void *arg) noexcept;
 private:
 	const unsigned long long uid;
 	bool healthy;
@@ -340,13 +432,31 @@ private:
 	Watchers watchers;
 	CircularBuffer<Message*> in;
 	CircularBuffer<Message*> out;
+	FairQueue outbound;
+	CircularBuffer<unsigned long long> corked;
+	//Poll's timeout is shortened while some output is held back
+	struct {
+		int configured; //Set by the derived hub
+		int shortened; //Zero (0) if not in effect
+	} wakeup;
 	Buffer<unsigned long long> guests;
+	TimerWheel wheel;
+	Offload offload;
 	//-----------------------------------------------------------------
 	Timer uptime;
 	struct {
 		TrafficInfo received;
 		TrafficInfo dropped;
 	} traffic;
+	struct {
+		unsigned long long completed;
+		double delay;
+	} errands;
+	struct {
+		SocketProfile io; //Queueing delay and transmission batches
+		Histogram turn; //Event loop's turn duration in microseconds
+		Histogram inflow; //Messages received per connection per IO cycle
+	} profile;
 	//-----------------------------------------------------------------
 	struct {
 		Socket *listener;
@@ -354,6 +464,7 @@ private:
 		Event *event;
 		Inotifier *inotifier;
 		Interrupt *interrupt;
+		Event *offload;
 	} prime;
 	//-----------------------------------------------------------------
 	struct {
@@ -366,19 +477,32 @@ private:
 		unsigned int interval;
 		bool semaphore;
 		bool signal;
+		bool uring;
+		unsigned int workers;
+		unsigned int errands;
 		unsigned int connections;
 		unsigned int messages;
+		unsigned int ceiling;
+		unsigned int maxConnections;
+		unsigned int maxMessages;
+		bool hugepages;
 		unsigned int guests;
 		unsigned int lease;
+		unsigned int idle;
 		unsigned int inward;
 		unsigned int outward;
+		unsigned int coalesce;
+		unsigned int sojourn;
 		bool regulate;
+		bool fair;
 		unsigned int reserved;
 		unsigned int ttl;
 		double answer;
 		double forward;
 		unsigned int logging;
+		unsigned int journal;
 		bool redact;
+		bool profile;
 	} ctx;
 };
 
@@ -11,13 +11,56 @@
  */
 
 #include "HubInfo.h"
+#include "../base/ds/MemoryPool.h"
 #include "../base/ds/Serializer.h"
 #include <cstdio>
 
 namespace {
 
 constexpr unsigned int infoBytes() noexcept {
-	return (6 * sizeof(uint64_t)) + (5 * sizeof(uint32_t));
+	return (12 * sizeof(uint64_t)) + (28 * sizeof(uint32_t));
+}
+
+unsigned int packDistribution(unsigned char *buffer, unsigned int size,
+		const wanhive::DistributionInfo &d) noexcept {
+	return wanhive::Serializer::pack(buffer, size, "QLLLL", d.count, d.p50,
+			d.p90, d.p99, d.max);
+}
+
+unsigned int unpackDistribution(const unsigned char *buffer,
+		wanhive::DistributionInfo &d) noexcept {
+	using wanhive::Serializer;
+	unsigned int index = 0;
+	d.count = Serializer::unpacku64(buffer + index);
+	index += sizeof(uint64_t);
+	d.p50 = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+	d.p90 = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+	d.p99 = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+	d.max = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+	return index;
+}
+
+void printDistribution(const char *name,
+		const wanhive::DistributionInfo &d) noexcept {
+	printf("%-16s %12llu %10u %10u %10u %10u\n", name, d.count, d.p50, d.p90,
+			d.p99, d.max);
+}
+
+const char* pageTypeString(unsigned int type) noexcept {
+	switch (type) {
+	case wanhive::PAGE_REGULAR:
+		return "regular";
+	case wanhive::PAGE_TRANSPARENT:
+		return "transparent huge";
+	case wanhive::PAGE_HUGE:
+		return "huge";
+	default:
+		return "unknown";
+	}
 }
 
 }  // namespace
@@ -40,6 +83,14 @@ void HubInfo::clear() noexcept {
 	connections = { 0, 0 };
 	messages = { 0, 0 };
 	mtu = 0;
+	pageType = 0;
+	errands = { 0, 0 };
+	latency = 0;
+	delay = { 0, 0, 0, 0, 0 };
+	turn = { 0, 0, 0, 0, 0 };
+	inflow = { 0, 0, 0, 0, 0 };
+	outflow = { 0, 0, 0, 0, 0 };
+	volume = { 0, 0, 0, 0, 0 };
 }
 
 unsigned long long HubInfo::getUid() const noexcept {
@@ -98,11 +149,86 @@ void HubInfo::setMTU(unsigned int mtu) noexcept {
 	this->mtu = mtu;
 }
 
+unsigned int HubInfo::getPageType() const noexcept {
+	return pageType;
+}
+
+void HubInfo::setPageType(unsigned int pageType) noexcept {
+	this->pageType = pageType;
+}
+
+const ResourceInfo& HubInfo::getErrands() const noexcept {
+	return errands;
+}
+
+void HubInfo::setErrands(const ResourceInfo &errands) noexcept {
+	this->errands = errands;
+}
+
+double HubInfo::getLatency() const noexcept {
+	return latency;
+}
+
+void HubInfo::setLatency(double latency) noexcept {
+	this->latency = latency;
+}
+
+const DistributionInfo& HubInfo::getDelay() const noexcept {
+	return delay;
+}
+
+void HubInfo::setDelay(const DistributionInfo &delay) noexcept {
+	this->delay = delay;
+}
+
+const DistributionInfo& HubInfo::getTurn() const noexcept {
+	return turn;
+}
+
+void HubInfo::setTurn(const DistributionInfo &turn) noexcept {
+	this->turn = turn;
+}
+
+const DistributionInfo& HubInfo::getInflow() const noexcept {
+	return inflow;
+}
+
+void HubInfo::setInflow(const DistributionInfo &inflow) noexcept {
+	this->inflow = inflow;
+}
+
+const DistributionInfo& HubInfo::getOutflow() const noexcept {
+	return outflow;
+}
+
+void HubInfo::setOutflow(const DistributionInfo &outflow) noexcept {
+	this->outflow = outflow;
+}
+
+const DistributionInfo& HubInfo::getVolume() const noexcept {
+	return volume;
+}
+
+void HubInfo::setVolume(const DistributionInfo &volume) noexcept {
+	this->volume = volume;
+}
+
 unsigned int HubInfo::pack(unsigned char *buffer,
 		unsigned int size) const noexcept {
-	return Serializer::pack(buffer, size, "QgQQQQLLLLL", uid, uptime,
+	if (!buffer || size < infoBytes()) {
+		return 0;
+	}
+
+	auto index = Serializer::pack(buffer, size, "QgQQQQLLLLLLLLg", uid, uptime,
 			received.units, received.bytes, dropped.units, dropped.bytes,
-			connections.max, connections.used, messages.max, messages.used, mtu);
+			connections.max, connections.used, messages.max, messages.used, mtu,
+			pageType, errands.max, errands.used, latency);
+	index += packDistribution(buffer + index, size - index, delay);
+	index += packDistribution(buffer + index, size - index, turn);
+	index += packDistribution(buffer + index, size - index, inflow);
+	index += packDistribution(buffer + index, size - index, outflow);
+	index += packDistribution(buffer + index, size - index, volume);
+	return index;
 }
 
 unsigned int HubInfo::unpack(const unsigned char *buffer,
@@ -137,6 +263,21 @@ unsigned int HubInfo::unpack(const unsigned char *buffer,
 
 	mtu = Serializer::unpacku32(buffer + index);
 	index += sizeof(uint32_t);
+	pageType = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+
+	errands.max = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+	errands.used = Serializer::unpacku32(buffer + index);
+	index += sizeof(uint32_t);
+	latency = Serializer::unpackf64(buffer + index);
+	index += sizeof(uint64_t);
+
+	index += unpackDistribution(buffer + index, delay);
+	index += unpackDistribution(buffer + index, turn);
+	index += unpackDistribution(buffer + index, inflow);
+	index += unpackDistribution(buffer + index, outflow);
+	index += unpackDistribution(buffer + index, volume);
 	return index;
 }
 
@@ -148,6 +289,8 @@ void HubInfo::print() const noexcept {
 	printf("--------------\n");
 	printf("Connections (%%): [%u / %u]\n", connections.used, connections.max);
 	printf("Messages (%%):    [%u / %u]\n", messages.used, messages.max);
+	printf("Memory pages:    %s\n", pageTypeString(pageType));
+	printf("Offloaded:       [%u / %u]\n", errands.used, errands.max);
 
 	printf("\nPERFORMANCE DATA\n");
 	printf("----------------\n");
@@ -159,11 +302,25 @@ void HubInfo::print() const noexcept {
 	} else {
 		printf("%.2fhr\n", (uptime / 3600));
 	}
+	printf("Offload latency: %.3fms\n", (latency * 1000));
 	printf("Incoming (packets): %20llu\n", received.units);
 	printf("Incoming (KB):      %20llu\n", (received.bytes / 1024));
 	printf("Outgoing (packets): %20llu\n", (received.units - dropped.units));
 	printf("Outgoing (KB):      %20llu\n",
 			((received.bytes - dropped.bytes) / 1024));
+
+	if (!delay.count && !turn.count && !inflow.count) {
+		return;
+	}
+	printf("\nPROFILE\n");
+	printf("-------\n");
+	printf("%-16s %12s %10s %10s %10s %10s\n", "", "SAMPLES", "P50", "P90",
+			"P99", "MAX");
+	printDistribution("Delay (us)", delay);
+	printDistribution("Turn (us)", turn);
+	printDistribution("Inflow (msgs)", inflow);
+	printDistribution("Outflow (msgs)", outflow);
+	printDistribution("Outflow (bytes)", volume);
 }
 
 } /* namespace wanhive */
@@ -34,6 +34,21 @@ struct TrafficInfo {
 	/*! Number of bytes */
 	unsigned long long bytes;
 };
+/**
+ * Summary of a distribution of values
+ */
+struct DistributionInfo {
+	/*! Number of samples */
+	unsigned long long count;
+	/*! Median value */
+	unsigned int p50;
+	/*! 90th percentile */
+	unsigned int p90;
+	/*! 99th percentile */
+	unsigned int p99;
+	/*! Maximum value */
+	unsigned int max;
+};
 //-----------------------------------------------------------------
 /**
  * Hub's runtime metrics
@@ -125,6 +140,94 @@ public:
 	 * @param mtu the new MTU value
 	 */
 	void setMTU(unsigned int mtu) noexcept;
+	/**
+	 * Returns the type of memory pages backing the message pool.
+	 * @return memory page type (see wanhive::MemoryPage)
+	 */
+	unsigned int getPageType() const noexcept;
+	/**
+	 * Sets the type of memory pages backing the message pool.
+	 * @param pageType memory page type (see wanhive::MemoryPage)
+	 */
+	void setPageType(unsigned int pageType) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns the offloaded operations' limit and the number in flight.
+	 * @return offloaded operations' data
+	 */
+	const ResourceInfo& getErrands() const noexcept;
+	/**
+	 * Sets the offloaded operations' limit and the number in flight.
+	 * @param errands the new offloaded operations' data
+	 */
+	void setErrands(const ResourceInfo &errands) noexcept;
+	/**
+	 * Returns the mean latency of the offloaded operations in seconds.
+	 * @return mean latency
+	 */
+	double getLatency() const noexcept;
+	/**
+	 * Sets the mean latency of the offloaded operations (in seconds).
+	 * @param latency the new mean latency value
+	 */
+	void setLatency(double latency) noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns the distribution of the messages' queueing delay (microseconds).
+	 * @return queueing delay's distribution
+	 */
+	const DistributionInfo& getDelay() const noexcept;
+	/**
+	 * Sets the distribution of the messages' queueing delay (microseconds).
+	 * @param delay the new queueing delay's distribution
+	 */
+	void setDelay(const DistributionInfo &delay) noexcept;
+	/**
+	 * Returns the distribution of the event loop's turn duration (microseconds).
+	 * @return turn duration's distribution
+	 */
+	const DistributionInfo& getTurn() const noexcept;
+	/**
+	 * Sets the distribution of the event loop's turn duration (microseconds).
+	 * @param turn the new turn duration's distribution
+	 */
+	void setTurn(const DistributionInfo &turn) noexcept;
+	/**
+	 * Returns the distribution of the number of messages received from a
+	 * connection per IO cycle.
+	 * @return incoming batch size's distribution
+	 */
+	const DistributionInfo& getInflow() const noexcept;
+	/**
+	 * Sets the distribution of the number of messages received from a
+	 * connection per IO cycle.
+	 * @param inflow the new incoming batch size's distribution
+	 */
+	void setInflow(const DistributionInfo &inflow) noexcept;
+	/**
+	 * Returns the distribution of the number of messages transmitted per write
+	 * operation.
+	 * @return outgoing batch size's distribution
+	 */
+	const DistributionInfo& getOutflow() const noexcept;
+	/**
+	 * Sets the distribution of the number of messages transmitted per write
+	 * operation.
+	 * @param outflow the new outgoing batch size's distribution
+	 */
+	void setOutflow(const DistributionInfo &outflow) noexcept;
+	/**
+	 * Returns the distribution of the number of bytes transmitted per write
+	 * operation.
+	 * @return outgoing bytes' distribution
+	 */
+	const DistributionInfo& getVolume() const noexcept;
+	/**
+	 * Sets the distribution of the number of bytes transmitted per write
+	 * operation.
+	 * @param volume the new outgoing bytes' distribution
+	 */
+	void setVolume(const DistributionInfo &volume) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Serializes this object.
@@ -147,7 +250,7 @@ public:
 	void print() const noexcept;
 public:
 	/*! Serialized data size in bytes */
-	static constexpr unsigned int BYTES = 68;
+	static constexpr unsigned int BYTES = 208;
 private:
 	unsigned long long uid { };
 	double uptime { };
@@ -156,6 +259,14 @@ private:
 	ResourceInfo connections { };
 	ResourceInfo messages { };
 	unsigned int mtu { };
+	unsigned int pageType { };
+	ResourceInfo errands { };
+	double latency { };
+	DistributionInfo delay { };
+	DistributionInfo turn { };
+	DistributionInfo inflow { };
+	DistributionInfo outflow { };
+	DistributionInfo volume { };
 };
 
 } /* namespace wanhive */
@@ -53,6 +53,8 @@ Identity::~Identity() {
 	free(paths.hostsFile);
 	free(paths.privateKey);
 	free(paths.publicKey);
+	free(paths.signingKey);
+	free(paths.verificationKey);
 	free(paths.sslRoot);
 	free(paths.sslCertificate);
 	free(paths.sslKey);
@@ -188,6 +190,10 @@ const char* Identity::getPath(int context) const noexcept {
 		return paths.sslCertificate;
 	case CTX_SSL_PRIVATE:
 		return paths.sslKey;
+	case CTX_SIGN_PRIVATE:
+		return paths.signingKey;
+	case CTX_SIGN_PUBLIC:
+		return paths.verificationKey;
 	default:
 		return nullptr;
 	}
@@ -219,6 +225,12 @@ void Identity::refresh(int context) {
 	case CTX_SSL_PRIVATE:
 		loadSSLKey();
 		break;
+	case CTX_SIGN_PRIVATE:
+		loadSigningKey();
+		break;
+	case CTX_SIGN_PUBLIC:
+		loadVerificationKey();
+		break;
 	default:
 		throw Exception(EX_ARGUMENT);
 		break;
@@ -295,13 +307,18 @@ void Identity::loadHosts() {
 void Identity::loadKeys() {
 	free(paths.privateKey);
 	free(paths.publicKey);
+	free(paths.signingKey);
+	free(paths.verificationKey);
 	paths.privateKey = options.getPathName("KEYS", "private");
 	paths.publicKey = options.getPathName("KEYS", "public");
+	paths.signingKey = options.getPathName("KEYS", "sign");
+	paths.verificationKey = options.getPathName("KEYS", "check");
 
 	auth.verify = options.getBoolean("KEYS", "verify");
 	if (!auth.verify) {
 		WH_LOG_WARNING("Host verification disabled");
-	} else if (!paths.publicKey) {
+	} else if (!paths.publicKey
+			|| (paths.signingKey && !paths.verificationKey)) {
 		WH_LOG_WARNING("Host verification enabled but no public key");
 		auth.verify = false;
 	} else {
@@ -314,11 +331,15 @@ void Identity::loadKeys() {
 			auth.enabled = false;
 			auth.verify = false;
 		} else {
-			auth.enabled = auth.pki.setup(paths.privateKey, paths.publicKey);
-			if (auth.enabled) {
-				WH_LOG_INFO("Public key infrastructure enabled");
-			} else {
+			auth.enabled = auth.pki.setup(paths.privateKey, paths.publicKey)
+					&& auth.pki.setupSignature(paths.signingKey,
+							paths.verificationKey);
+			if (!auth.enabled) {
 				throw Exception(EX_SECURITY);
+			} else if (auth.pki.isEd25519()) {
+				WH_LOG_INFO("Public key infrastructure enabled (Ed25519)");
+			} else {
+				WH_LOG_INFO("Public key infrastructure enabled");
 			}
 		}
 	} catch (const BaseException &e) {
@@ -329,6 +350,10 @@ void Identity::loadKeys() {
 		paths.privateKey = nullptr;
 		free(paths.publicKey);
 		paths.publicKey = nullptr;
+		free(paths.signingKey);
+		paths.signingKey = nullptr;
+		free(paths.verificationKey);
+		paths.verificationKey = nullptr;
 		throw;
 	}
 }
@@ -350,6 +375,11 @@ void Identity::loadSSL() {
 	try {
 		ssl.ctx.setup(paths.sslCertificate, paths.sslKey);
 		ssl.ctx.trust(paths.sslRoot, nullptr);
+		if (options.getBoolean("SSL", "offload") && !ssl.ctx.offload(true)) {
+			WH_LOG_WARNING("Kernel TLS offload not supported");
+		}
+		ssl.ctx.resume(options.getNumber("SSL", "sessions", 1024),
+				options.getNumber("SSL", "rotation", 3600));
 		WH_LOG_INFO("SSL/TLS enabled");
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
@@ -426,6 +456,39 @@ void Identity::loadPublicKey() {
 	}
 }
 
+void Identity::loadSigningKey() {
+	try {
+		if (!paths.signingKey) {
+			WH_LOG_WARNING("No signing key file");
+		} else if (auth.pki.loadSigningKey(paths.signingKey)) {
+			WH_LOG_DEBUG("Signing key loaded from %s", paths.signingKey);
+			return;
+		} else {
+			throw Exception(EX_SECURITY);
+		}
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+		throw;
+	}
+}
+
+void Identity::loadVerificationKey() {
+	try {
+		if (!paths.verificationKey) {
+			WH_LOG_WARNING("No verification key file");
+		} else if (auth.pki.loadVerificationKey(paths.verificationKey)) {
+			WH_LOG_DEBUG("Verification key loaded from %s",
+					paths.verificationKey);
+			return;
+		} else {
+			throw Exception(EX_SECURITY);
+		}
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+		throw;
+	}
+}
+
 void Identity::loadSSLRoot() {
 	try {
 		if (!ssl.enabled) {
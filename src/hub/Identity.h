@@ -130,6 +130,8 @@ private:
 	void loadHostsFile();
 	void loadPrivateKey();
 	void loadPublicKey();
+	void loadSigningKey();
+	void loadVerificationKey();
 	void loadSSLRoot();
 	void loadSSLCertificate();
 	void loadSSLKey();
@@ -153,7 +155,9 @@ public:
 		CTX_PKI_PUBLIC, /**< Public key */
 		CTX_SSL_ROOT, /**< Root CA certificate */
 		CTX_SSL_CERT, /**< SSL certificate */
-		CTX_SSL_PRIVATE /**< SSL private key */
+		CTX_SSL_PRIVATE, /**< SSL private key */
+		CTX_SIGN_PRIVATE, /**< Ed25519 signing key */
+		CTX_SIGN_PUBLIC /**< Ed25519 verification key */
 	};
 private:
 	InstanceID *instanceId { };
@@ -178,6 +182,8 @@ private:
 		char *hostsFile { };
 		char *privateKey { };
 		char *publicKey { };
+		char *signingKey { };
+		char *verificationKey { };
 		char *sslRoot { };
 		char *sslCertificate { };
 		char *sslKey { };
@@ -0,0 +1,214 @@
+/*
+ * Offload.cpp
+ *
+ * Worker threads for the CPU intensive operations
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "Offload.h"
+#include "../base/common/Exception.h"
+#include <cstdlib>
+
+namespace wanhive {
+
+Offload::Offload() noexcept {
+	mutex = PTHREAD_MUTEX_INITIALIZER;
+	idle = PTHREAD_COND_INITIALIZER;
+}
+
+Offload::~Offload() {
+	stop();
+	if (pthread_cond_destroy(&idle) != 0
+			|| pthread_mutex_destroy(&mutex) != 0) {
+		abort();
+	}
+}
+
+void Offload::start(unsigned int threads, unsigned int capacity,
+		void (*fn)(Errand &errand, void *arg), void *arg, Event *notifier) {
+	if (active()) {
+		throw Exception(EX_STATE);
+	} else if (!threads || !capacity || !fn || !notifier) {
+		throw Exception(EX_ARGUMENT);
+	}
+
+	try {
+		pending.initialize(capacity + 1);
+		done.initialize(capacity + 1);
+		gate = new Event(true, true);
+		crew = new Thread*[threads] { };
+		this->fn = fn;
+		this->arg = arg;
+		this->notifier = notifier;
+		this->limit = capacity;
+		this->inflight = 0;
+		this->stopping = false;
+		for (; this->threads < threads; ++this->threads) {
+			crew[this->threads] = new Thread(*this);
+		}
+	} catch (const BaseException &e) {
+		stop();
+		throw;
+	} catch (...) {
+		stop();
+		throw Exception(EX_MEMORY);
+	}
+}
+
+void Offload::stop() noexcept {
+	if (!crew) {
+		clear();
+		return;
+	}
+
+	try {
+		lock();
+		stopping = true;
+		unlock();
+		//Each worker exits after finding the queue empty
+		gate->write(threads);
+		for (unsigned int i = 0; i < threads; ++i) {
+			crew[i]->join();
+			delete crew[i];
+		}
+	} catch (const BaseException &e) {
+		//Resource leak, do not try to recover
+		abort();
+	}
+	delete[] crew;
+	crew = nullptr;
+	threads = 0;
+	clear();
+}
+
+bool Offload::active() const noexcept {
+	return threads != 0;
+}
+
+bool Offload::post(const Errand &errand) noexcept {
+	if (!active() || inflight >= limit) {
+		return false;
+	}
+
+	lock();
+	auto success = pending.put(errand);
+	unlock();
+	if (!success) {
+		return false;
+	}
+
+	try {
+		gate->write(1);
+		++inflight;
+		return true;
+	} catch (const BaseException &e) {
+		//The errand is already queued, cannot recover
+		abort();
+	}
+}
+
+bool Offload::collect(Errand &errand) noexcept {
+	lock();
+	auto success = done.get(errand);
+	unlock();
+	if (success) {
+		--inflight;
+	}
+	return success;
+}
+
+void Offload::settle() noexcept {
+	lock();
+	while (busy || !pending.isEmpty()) {
+		pthread_cond_wait(&idle, &mutex);
+	}
+	unlock();
+}
+
+unsigned int Offload::load() const noexcept {
+	return inflight;
+}
+
+unsigned int Offload::capacity() const noexcept {
+	return limit;
+}
+
+void Offload::run(void *arg) noexcept {
+	while (true) {
+		unsigned long long count = 0;
+		try {
+			gate->read(count);
+		} catch (const BaseException &e) {
+			abort();
+		}
+
+		Errand errand;
+		lock();
+		auto found = pending.get(errand);
+		if (found) {
+			++busy;
+		} else if (stopping) {
+			unlock();
+			break;
+		}
+		unlock();
+
+		if (!found) {
+			continue;
+		}
+
+		fn(errand, this->arg);
+
+		lock();
+		done.put(errand); //Cannot overflow
+		--busy;
+		if (!busy && pending.isEmpty()) {
+			pthread_cond_broadcast(&idle);
+		}
+		unlock();
+
+		try {
+			notifier->write(1);
+		} catch (const BaseException &e) {
+			abort();
+		}
+	}
+}
+
+int Offload::getStatus() const noexcept {
+	return 0;
+}
+
+void Offload::setStatus(int status) noexcept {
+
+}
+
+void Offload::lock() noexcept {
+	if (pthread_mutex_lock(&mutex) != 0) {
+		abort();
+	}
+}
+
+void Offload::unlock() noexcept {
+	if (pthread_mutex_unlock(&mutex) != 0) {
+		abort();
+	}
+}
+
+void Offload::clear() noexcept {
+	delete gate;
+	gate = nullptr;
+	notifier = nullptr;
+	fn = nullptr;
+	arg = nullptr;
+	limit = 0;
+	busy = 0;
+	stopping = false;
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,130 @@
+/**
+ * @file Offload.h
+ *
+ * Worker threads for the CPU intensive operations
+ *
+ *
+ * Copyright (C) 2025 Amit Kumar (amitkriit@gmail.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_HUB_OFFLOAD_H_
+#define WH_HUB_OFFLOAD_H_
+#include "Event.h"
+#include "../base/Thread.h"
+#include "../base/common/NonCopyable.h"
+#include "../base/ds/CircularBuffer.h"
+#include "../util/Message.h"
+#include <pthread.h>
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Unit of work carried out by a worker thread
+ */
+struct Errand {
+	/*! Operation's type (defined by the submitter) */
+	unsigned int type;
+	/*! The message to work on */
+	Message *message;
+	/*! Additional argument */
+	void *arg;
+	/*! Operation's outcome (set by the worker) */
+	int status;
+	/*! Submission time in seconds (monotonic clock) */
+	double posted;
+};
+//-----------------------------------------------------------------
+/**
+ * Pool of worker threads for the CPU intensive operations (e.g. cryptography)
+ * @note Errands are submitted and collected by a single (event loop) thread.
+ * Completions are reported to an events counter.
+ */
+class Offload: private NonCopyable, private Task {
+public:
+	/**
+	 * Constructor: creates an inactive pool.
+	 */
+	Offload() noexcept;
+	/**
+	 * Destructor: stops the worker threads.
+	 */
+	~Offload();
+	//-----------------------------------------------------------------
+	/**
+	 * Starts the worker threads.
+	 * @param threads number of worker threads
+	 * @param capacity maximum number of errands in flight
+	 * @param fn carries out an errand in a worker thread
+	 * @param arg additional argument of the above function
+	 * @param notifier events counter for reporting the completions
+	 */
+	void start(unsigned int threads, unsigned int capacity,
+			void (*fn)(Errand &errand, void *arg), void *arg, Event *notifier);
+	/**
+	 * Finishes the errands in flight and stops the worker threads. The results
+	 * remain available for collection.
+	 */
+	void stop() noexcept;
+	/**
+	 * Checks whether the worker threads are running.
+	 * @return true if the worker threads are running, false otherwise
+	 */
+	bool active() const noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Submits an errand.
+	 * @param errand the errand to carry out
+	 * @return true on success, false if the pool is inactive or full
+	 */
+	bool post(const Errand &errand) noexcept;
+	/**
+	 * Retrieves a completed errand.
+	 * @param errand stores the completed errand
+	 * @return true on success, false if no errand has been completed
+	 */
+	bool collect(Errand &errand) noexcept;
+	/**
+	 * Waits until the worker threads are done with all the submitted errands.
+	 */
+	void settle() noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns the number of errands in flight (submitted but not collected).
+	 * @return errands count
+	 */
+	unsigned int load() const noexcept;
+	/**
+	 * Returns the maximum number of errands in flight.
+	 * @return the limit on the errands in flight
+	 */
+	unsigned int capacity() const noexcept;
+private:
+	void run(void *arg) noexcept override;
+	int getStatus() const noexcept override;
+	void setStatus(int status) noexcept override;
+	void lock() noexcept;
+	void unlock() noexcept;
+	void clear() noexcept;
+private:
+	pthread_mutex_t mutex;
+	pthread_cond_t idle;
+	Event *gate { }; //Worker threads wait on it (semaphore)
+	Event *notifier { };
+	void (*fn)(Errand &errand, void *arg) { };
+	void *arg { };
+	Thread **crew { };
+	unsigned int threads { };
+	unsigned int limit { };
+	unsigned int inflight { }; //Accessed by the submitter only
+	unsigned int busy { };
+	bool stopping { };
+	CircularBuffer<Errand> pending;
+	CircularBuffer<Errand> done;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_HUB_OFFLOAD_H_ */
@@ -110,7 +110,7 @@ bool Protocol::tokenRequest(const MessageAddress &address, Digest *hc,
 	 * TOTAL: 32+64=96 bytes in Request; 32+128=160 bytes in Response
 	 */
 	return createTokenRequest(address, hc, verify)
-			&& executeRequest(false, verify) && processTokenResponse(hc);
+			&& executeRequest(false, verify, true) && processTokenResponse(hc);
 }
 
 unsigned int Protocol::createFindRootRequest(uint64_t host,
@@ -270,6 +270,39 @@ bool Protocol::unsubscribeRequest(uint64_t host, uint8_t topic) {
 			&& processUnsubscribeResponse(topic);
 }
 
+unsigned int Protocol::createBatchRequest(uint64_t host) noexcept {
+	clear();
+	header().setAddress(getSource(), host);
+	header().setControl(HEADER_SIZE, nextSequenceNumber(), 0);
+	header().setContext(WH_CMD_BATCH, WH_QLF_NULL, WH_AQLF_REQUEST);
+	packHeader();
+	return header().getLength();
+}
+
+unsigned int Protocol::appendBatchRequest(const MessageHeader &header,
+		const Data &data) noexcept {
+	if ((data.length && !data.base) || data.length > PAYLOAD_SIZE) {
+		return 0;
+	} else if (!checkContext(WH_CMD_BATCH, WH_QLF_NULL, WH_AQLF_REQUEST)) {
+		return 0;
+	} else {
+		auto record = header;
+		record.setLength(HEADER_SIZE + data.length);
+		return batch(record, data.base) ? this->header().getLength() : 0;
+	}
+}
+
+bool Protocol::batchRequest() {
+	/*
+	 * HEADER: SRC=0, DEST=X, ....CMD=127, QLF=0, AQLF=127
+	 * BODY: variable in Request (see Packet::batch()); no Response
+	 * TOTAL: at least 48 bytes in Request; no Response
+	 */
+	return getPayloadLength()
+			&& checkContext(WH_CMD_BATCH, WH_QLF_NULL, WH_AQLF_REQUEST)
+			&& (send(), true);
+}
+
 //-----------------------------------------------------------------
 Message* Protocol::createIdentificationRequest(const MessageAddress &address,
 		const Data &nonce, uint16_t seq) noexcept {
@@ -237,6 +237,29 @@ public:
 	 */
 	bool unsubscribeRequest(uint64_t host, uint8_t topic);
 	//-----------------------------------------------------------------
+	/**
+	 * Creates an empty batch request. A batch carries many small messages in
+	 * a single frame, the host unpacks and routes them individually.
+	 * @param host host's identifier (can be set to zero)
+	 * @return message length on success, 0 on error
+	 */
+	unsigned int createBatchRequest(uint64_t host) noexcept;
+	/**
+	 * Appends a message to the batch request (see Protocol::createBatchRequest()).
+	 * The message's source and label are replaced by the batch's.
+	 * @param header message's header (the length is ignored)
+	 * @param data message's payload
+	 * @return batch request's length on success, 0 on error (the batch is full
+	 * or the message is invalid).
+	 */
+	unsigned int appendBatchRequest(const MessageHeader &header,
+			const Data &data) noexcept;
+	/**
+	 * Executes the batch request (see Protocol::appendBatchRequest()).
+	 * @return true on success, false on error (the batch is empty)
+	 */
+	bool batchRequest();
+	//-----------------------------------------------------------------
 	/**
 	 * Creates an identification request.
 	 * @param address message's address
@@ -16,10 +16,21 @@
 #include "../base/ds/Twiddler.h"
 #include "../base/security/CryptoUtils.h"
 #include "../base/unix/SystemException.h"
+#include "../base/unix/Time.h"
+#include <cerrno>
+#include <cmath>
+
+namespace {
+
+//CoDel's interval as a multiple of the target delay (5ms:100ms)
+constexpr unsigned int AQM_INTERVAL = 20;
+
+}  // namespace
 
 namespace wanhive {
 
 SSLContext *Socket::sslCtx { };
+SocketProfile *Socket::profile { };
 
 Socket::Socket(int fd) noexcept :
 		Pooled { 0 }, Watcher { fd } {
@@ -81,6 +92,29 @@ Socket::~Socket() {
 	cleanup();
 }
 
+unsigned int Socket::publish(Message *message, Socket **targets,
+		unsigned int count) noexcept {
+	if (!message) {
+		return 0;
+	}
+
+	unsigned long long now = 0;
+	unsigned int accepted = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		auto target = targets[i];
+		if (!now && target->queued.capacity()) {
+			now = Time::microseconds(CLOCK_MONOTONIC);
+		}
+
+		if (target->enqueue(message, now)) {
+			targets[accepted++] = target;
+		}
+	}
+
+	message->link(accepted);
+	return accepted;
+}
+
 void* Socket::operator new(size_t size) {
 	auto p = Pooled::operator new(size);
 	if (p) {
@@ -130,17 +164,33 @@ bool Socket::callback(void *arg) noexcept {
 
 bool Socket::publish(void *arg) noexcept {
 	auto message = static_cast<Message*>(arg);
-	if (message && (!backlog || out.readSpace() < backlog)
-			&& out.put(message)) {
+	auto now = queued.capacity() ? Time::microseconds(CLOCK_MONOTONIC) : 0;
+	if (message && enqueue(message, now)) {
 		message->link();
-		setTrace(message->getTrace());
-		setFlags(WATCHER_OUT);
 		return true;
 	} else {
 		return false;
 	}
 }
 
+bool Socket::push() noexcept {
+	if (!coalesce.held) {
+		return false;
+	} else if (!coalesce.timer.hasTimedOut(coalesce.delay)) {
+		return true;
+	}
+
+	try {
+		//Uncork to push out the partial frames, and cork again
+		Network::setCork(Descriptor::get(), false);
+		Network::setCork(Descriptor::get(), true);
+	} catch (const BaseException &e) {
+		//Nothing to do, the connection will fail on the next IO
+	}
+	coalesce.held = false;
+	return false;
+}
+
 void Socket::setTopic(unsigned int index) noexcept {
 	if (subscriptions.set(index)) {
 		setFlags(WATCHER_MULTICAST);
@@ -164,6 +214,13 @@ unsigned long long Socket::getOption(int name) const noexcept {
 		return READ_BUFFER_SIZE;
 	case WATCHER_OUTBOUND_MAX:
 		return backlog;
+	case WATCHER_COALESCE:
+		return coalesce.delay;
+	case WATCHER_SOJOURN:
+		return aqm.target / 1000;
+	case WATCHER_STREAM:
+		//Plain data connections, the TLS library does its own IO
+		return !isType(SOCKET_LISTENER) && (!sslCtx || testFlags(SOCKET_LOCAL));
 	default:
 		return 0;
 	}
@@ -174,6 +231,12 @@ void Socket::setOption(int name, unsigned long long value) noexcept {
 	case WATCHER_OUTBOUND_MAX:
 		backlog = Twiddler::min(value, (OUT_QUEUE_SIZE - 1));
 		break;
+	case WATCHER_COALESCE:
+		cork(Twiddler::min(value, 1000ULL));
+		break;
+	case WATCHER_SOJOURN:
+		manage(Twiddler::min(value, 1000ULL));
+		break;
 	default:
 		break;
 	}
@@ -200,19 +263,37 @@ Socket* Socket::accept(bool blocking) {
 }
 
 ssize_t Socket::read() {
+	ssize_t bytes = 0;
 	if (!sslCtx || testFlags(SOCKET_LOCAL)) {
-		return socketRead();
+		bytes = socketRead();
 	} else {
-		return secureRead();
+		bytes = secureRead();
+	}
+
+	if (bytes > 0 && profile) {
+		arrival = Time::microseconds(CLOCK_MONOTONIC);
 	}
+	return bytes;
 }
 
 ssize_t Socket::write() {
+	ssize_t bytes = 0;
 	if (!sslCtx || testFlags(SOCKET_LOCAL)) {
-		return socketWrite();
+		bytes = socketWrite();
 	} else {
-		return secureWrite();
+		bytes = secureWrite();
+	}
+
+	if (bytes > 0 && coalesce.delay && !coalesce.held) {
+		//The kernel holds back the partial frame
+		coalesce.held = true;
+		coalesce.timer.now();
 	}
+	return bytes;
+}
+
+bool Socket::held() const noexcept {
+	return coalesce.held;
 }
 
 Message* Socket::obtain() {
@@ -234,6 +315,7 @@ Message* Socket::obtain() {
 		if (next->build(*this)) {
 			traffic.in += 1;
 			auto msg = next;
+			msg->setStamp(profile ? arrival : 0);
 			next = nullptr;
 			return msg;
 		} else {
@@ -278,17 +360,17 @@ void Socket::setSSLContext(SSLContext *ctx) noexcept {
 	sslCtx = ctx;
 }
 
+void Socket::setProfile(SocketProfile *profile) noexcept {
+	Socket::profile = profile;
+}
+
 ssize_t Socket::socketRead() {
 	ssize_t nRecv = 0;
-	CircularBufferVector<unsigned char> vector;
-	//Receive data into the read buffer
-	if (in.getWritable(vector)) {
-		auto count = (vector.part[1].length) ? 2 : 1;
-		iovec iovs[2] = { { vector.part[0].base, vector.part[0].length }, {
-				vector.part[1].base, vector.part[1].length } };
-		if ((nRecv = Descriptor::readv(iovs, count)) > 0) {
-			in.skipWrite(nRecv);
-		}
+	iovec iovs[3];
+	size_t direct = 0;
+	auto count = ingress(iovs, direct);
+	if (count && (nRecv = Descriptor::readv(iovs, count)) > 0) {
+		absorb(nRecv, direct);
 	}
 	return nRecv;
 }
@@ -314,17 +396,34 @@ ssize_t Socket::secureRead() {
 		return secureWrite();
 	}
 
+	if (secure.receive) {
+		/*
+		 * The kernel decrypts the application data. A control message (alert,
+		 * session ticket, key update) fails the plain read with EIO, let the
+		 * library consume it.
+		 */
+		try {
+			return socketRead();
+		} catch (const SystemException &e) {
+			if (e.errorCode() != EIO) {
+				throw;
+			}
+		}
+	}
+
 	ssize_t nRecv = 0;
-	CircularBufferVector<unsigned char> vector;
-	//Receive data into both the segments
-	if (in.getWritable(vector)) {
+	iovec iovs[3];
+	size_t direct = 0;
+	auto count = ingress(iovs, direct);
+	//Receive data into all the segments
+	if (count) {
 		CryptoUtils::clearErrors();
-		for (unsigned int i = 0; i < 2; i++) {
-			auto data = vector.part[i].base;
-			auto length = vector.part[i].length;
-			auto received = length ? sslRead(data, length) : 0;
+		for (unsigned int i = 0; i < count; i++) {
+			auto data = iovs[i].iov_base;
+			auto length = iovs[i].iov_len;
+			auto received = sslRead(data, length);
 			nRecv += received;
-			in.skipWrite(received);
+			absorb(received, (i == 0) ? direct : 0);
 			if ((size_t) received != length) { //Partial read
 				break;
 			}
@@ -340,6 +439,11 @@ ssize_t Socket::secureWrite() {
 		return secureRead();
 	}
 
+	if (secure.send) {
+		//The kernel encrypts the application data, write in batches
+		return socketWrite();
+	}
+
 	auto count = post();
 	if (count) {
 		CryptoUtils::clearErrors();
@@ -368,12 +472,15 @@ void Socket::initSSL() {
 		throw Exception(EX_STATE);
 	} else if (!secure.ssl) {
 		secure.ssl = sslCtx->create(Descriptor::get(), !isType(SOCKET_PROXY));
-	} else if (secure.verified || !isType(SOCKET_PROXY)) {
+	} else if (secure.verified) {
 		return;
 	} else if (!SSL_is_init_finished(secure.ssl)) {
 		return;
-	} else if (SSLContext::verify(secure.ssl)) {
+	} else if (!isType(SOCKET_PROXY) || SSLContext::verify(secure.ssl)) {
+		//Handshake completed, check for the kernel TLS offload
 		secure.verified = true;
+		secure.send = SSLContext::offloaded(secure.ssl, true);
+		secure.receive = SSLContext::offloaded(secure.ssl, false);
 	} else {
 		throw Exception(EX_SECURITY);
 	}
@@ -452,6 +559,44 @@ ssize_t Socket::sslWrite(const void *buf, size_t count) {
 	}
 }
 
+unsigned int Socket::ingress(iovec (&iovs)[3], size_t &direct) noexcept {
+	unsigned int count = 0;
+	direct = 0;
+	/*
+	 * Receive the remaining bytes of an incomplete message straight into its
+	 * frame. Preserve the order: the read buffer must not hold any data.
+	 */
+	unsigned int size = 0;
+	unsigned char *frame = nullptr;
+	if (next && in.isEmpty() && (frame = next->reserve(size))) {
+		iovs[count].iov_base = frame;
+		iovs[count].iov_len = size;
+		direct = size;
+		++count;
+	}
+
+	//Rest of the data goes into the read buffer
+	CircularBufferVector<unsigned char> vector;
+	if (in.getWritable(vector)) {
+		for (unsigned int i = 0; i < 2; ++i) {
+			if (vector.part[i].length) {
+				iovs[count].iov_base = vector.part[i].base;
+				iovs[count].iov_len = vector.part[i].length;
+				++count;
+			}
+		}
+	}
+	return count;
+}
+
+void Socket::absorb(size_t bytes, size_t direct) noexcept {
+	auto n = Twiddler::min(bytes, direct);
+	if (n) {
+		next->commit(n);
+	}
+	in.skipWrite(bytes - n);
+}
+
 unsigned int Socket::post() noexcept {
 	if (!egress.hasSpace()) {
 		CircularBufferVector<Message*> vector;
@@ -485,6 +630,7 @@ unsigned int Socket::post() noexcept {
 void Socket::offload(size_t bytes) noexcept {
 	size_t total = 0;
 	unsigned int sentMessages = 0;
+	auto now = profile ? Time::microseconds(CLOCK_MONOTONIC) : 0;
 	auto iovecs = egress.offset();
 	auto count = egress.space();
 	for (unsigned int index = 0; index < count; ++index) {
@@ -502,10 +648,122 @@ void Socket::offload(size_t bytes) noexcept {
 		//We have sent this message, recycle it
 		Message *msg = nullptr;
 		out.get(msg);
+		if (queued.capacity()) {
+			queued.skipRead(1);
+		}
+		if (now && msg->getStamp() && now >= msg->getStamp()) {
+			profile->delay.record(now - msg->getStamp());
+		}
 		Message::recycle(msg);
 		++sentMessages;
 	}
 	egress.setIndex(egress.getIndex() + sentMessages);
+
+	if (profile && bytes) {
+		profile->messages.record(sentMessages);
+		profile->bytes.record(bytes);
+	}
+}
+
+bool Socket::enqueue(Message *message, unsigned long long now) noexcept {
+	if (shed(now)) {
+		return false;
+	} else if ((!backlog || out.readSpace() < backlog) && out.put(message)) {
+		if (queued.capacity()) {
+			queued.put((uint32_t) now);
+		}
+		setTrace(message->getTrace());
+		setFlags(WATCHER_OUT);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool Socket::shed(unsigned long long now) noexcept {
+	/*
+	 * CoDel: tolerate a queueing delay above the target for an interval, then
+	 * drop with increasing frequency (interval / sqrt(drops)) until the delay
+	 * falls below the target. The oldest queued message's delay is tested
+	 * during enqueue because a stalled connection doesn't dequeue anything.
+	 */
+	if (!aqm.target) {
+		return false;
+	}
+
+	CircularBufferVector<uint32_t> vector;
+	if (!now || queued.getReadable(vector) <= 1
+			|| ((uint32_t) now - vector.part[0].base[0]) < aqm.target) {
+		//No standing queue
+		aqm.above = 0;
+		clearFlags(SOCKET_CONGESTED);
+		return false;
+	}
+
+	auto interval = (unsigned long long) aqm.target * AQM_INTERVAL;
+	if (!aqm.above) {
+		aqm.above = now + interval;
+		return false;
+	} else if (!testFlags(SOCKET_CONGESTED)) {
+		if (now < aqm.above) {
+			return false;
+		}
+		//Resume from the recent drop rate instead of starting over
+		if (aqm.count > 2 && now < aqm.next + (interval << 4)) {
+			aqm.count -= 2;
+		} else {
+			aqm.count = 1;
+		}
+		setFlags(SOCKET_CONGESTED);
+		aqm.next = now + (unsigned long long) (interval / std::sqrt(aqm.count));
+		return true;
+	} else if (now >= aqm.next) {
+		++aqm.count;
+		aqm.next += (unsigned long long) (interval / std::sqrt(aqm.count));
+		return true;
+	} else {
+		return false;
+	}
+}
+
+void Socket::manage(unsigned int target) noexcept {
+	aqm.target = target * 1000;
+	aqm.above = 0;
+	clearFlags(SOCKET_CONGESTED);
+	if (!aqm.target) {
+		return;
+	}
+
+	try {
+		if (!queued.capacity()) {
+			queued.initialize(OUT_QUEUE_SIZE);
+		}
+	} catch (const BaseException &e) {
+		aqm.target = 0;
+		return;
+	}
+
+	//The already queued messages start their sojourn now
+	queued.clear();
+	auto now = (uint32_t) Time::microseconds(CLOCK_MONOTONIC);
+	for (auto count = out.readSpace(); count; --count) {
+		queued.put(now);
+	}
+}
+
+void Socket::cork(unsigned int delay) noexcept {
+	if (testFlags(SOCKET_LOCAL) || isType(SOCKET_LISTENER)) {
+		return;
+	}
+
+	try {
+		Network::setCork(Descriptor::get(), delay != 0);
+		coalesce.delay = delay;
+		coalesce.held = false;
+	} catch (const BaseException &e) {
+		coalesce.delay = 0;
+		coalesce.held = false;
+	}
 }
 
 void Socket::cleanup() noexcept {
@@ -516,6 +774,7 @@ void Socket::cleanup() noexcept {
 	while ((out.get(message))) {
 		Message::recycle(message);
 	}
+	queued.clear();
 }
 
 } /* namespace wanhive */
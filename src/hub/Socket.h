@@ -14,7 +14,10 @@
 #define WH_HUB_SOCKET_H_
 #include "Topic.h"
 #include "../base/Network.h"
+#include "../base/Timer.h"
 #include "../base/common/Source.h"
+#include "../base/ds/CircularBuffer.h"
+#include "../base/ds/Histogram.h"
 #include "../base/ds/Pooled.h"
 #include "../base/ds/StaticBuffer.h"
 #include "../base/ds/StaticCircularBuffer.h"
@@ -25,13 +28,26 @@
 /*! @namespace wanhive */
 namespace wanhive {
 //-----------------------------------------------------------------
+/**
+ * Transmission profile of the sockets (see Socket::setProfile())
+ */
+struct SocketProfile {
+	/*! Queueing delay of the messages in microseconds (arrival to departure) */
+	Histogram delay;
+	/*! Number of messages transmitted per write operation */
+	Histogram messages;
+	/*! Number of bytes transmitted per write operation */
+	Histogram bytes;
+};
+//-----------------------------------------------------------------
 /**
  * Enumeration of socket flags, should not conflict with the watcher flags
  */
 enum SocketFlag : uint32_t {
 	SOCKET_PRIORITY = 1024, /**< Priority connection */
 	SOCKET_OVERLAY = 2048, /**< Overlay connection */
-	SOCKET_LOCAL = 4096 /**< Unix domain socket connection */
+	SOCKET_LOCAL = 4096, /**< Unix domain socket connection */
+	SOCKET_CONGESTED = 8192 /**< Outgoing queue is shedding the load */
 };
 
 /**
@@ -84,6 +100,19 @@ public:
 	 */
 	~Socket();
 	//-----------------------------------------------------------------
+	/**
+	 * Bulk enqueue: appends a message to the outgoing queues of a batch of
+	 * connections. The connections share the message (reference counted) and
+	 * a single clock reading.
+	 * @param message message to deliver
+	 * @param targets the connections, overwritten with the connections which
+	 * accepted the message (in order)
+	 * @param count connections count
+	 * @return number of the connections which accepted the message
+	 */
+	static unsigned int publish(Message *message, Socket **targets,
+			unsigned int count) noexcept;
+	//-----------------------------------------------------------------
 	/*
 	 * Custom allocator and deallocator
 	 */
@@ -105,6 +134,7 @@ public:
 	void stop() noexcept override;
 	bool callback(void *arg) noexcept override;
 	bool publish(void *arg) noexcept override;
+	bool push() noexcept override;
 	void setTopic(unsigned int index) noexcept override;
 	void clearTopic(unsigned int index) noexcept override;
 	bool testTopic(unsigned int index) const noexcept override;
@@ -131,6 +161,12 @@ public:
 	 * messages queue is empty.
 	 */
 	ssize_t write();
+	/**
+	 * Checks whether the written data is being held back for coalescing (see
+	 * WATCHER_COALESCE and Socket::push()).
+	 * @return true if some written data is held back, false otherwise
+	 */
+	bool held() const noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Obtains the next incoming message.
@@ -160,6 +196,12 @@ public:
 	 * @param ctx SSL/TLS context
 	 */
 	static void setSSLContext(SSLContext *ctx) noexcept;
+	/**
+	 * Sets the transmission profile's recorder, the recorder is updated during
+	 * every write operation. Profiling is disabled if the recorder is nullptr.
+	 * @param profile the recorder (nullptr to disable profiling)
+	 */
+	static void setProfile(SocketProfile *profile) noexcept;
 private:
 	ssize_t socketRead();
 	ssize_t socketWrite();
@@ -168,8 +210,14 @@ private:
 	void initSSL();
 	ssize_t sslRead(void *buf, size_t count);
 	ssize_t sslWrite(const void *buf, size_t count);
+	unsigned int ingress(iovec (&iovs)[3], size_t &direct) noexcept;
+	void absorb(size_t bytes, size_t direct) noexcept;
 	unsigned int post() noexcept;
 	void offload(size_t bytes) noexcept;
+	bool enqueue(Message *message, unsigned long long now) noexcept;
+	bool shed(unsigned long long now) noexcept;
+	void manage(unsigned int target) noexcept;
+	void cork(unsigned int delay) noexcept;
 	void cleanup() noexcept;
 public:
 	/*! Minimum value for active socket identifier */
@@ -188,20 +236,38 @@ private:
 		bool callRead { };
 		bool callWrite { };
 		bool verified { };
+		bool send { }; //Transmission offloaded to the kernel
+		bool receive { }; //Reception offloaded to the kernel
 	} secure;
 	//-----------------------------------------------------------------
+	struct {
+		unsigned int delay { }; //Maximum delay in milliseconds (0 = disabled)
+		bool held { }; //Some written data is held back
+		Timer timer; //Time of the first held back write
+	} coalesce;
+	//-----------------------------------------------------------------
+	struct {
+		unsigned int target { }; //Target delay in microseconds (0 = disabled)
+		unsigned int count { }; //Number of drops in the dropping state
+		unsigned long long above { }; //Delay remains above the target until
+		unsigned long long next { }; //Time of the next drop
+	} aqm;
+	//-----------------------------------------------------------------
 	struct {
 		unsigned long long in { };
 		unsigned long long out { };
 	} traffic;
 
 	unsigned int backlog { };
+	unsigned long long arrival { }; //Time of the last read (for profiling)
 	Message *next { };
 	StaticCircularBuffer<unsigned char, READ_BUFFER_SIZE> in;
 	StaticCircularBuffer<Message*, OUT_QUEUE_SIZE> out;
+	CircularBuffer<uint32_t> queued; //Enqueue times (allocated with the AQM)
 	StaticBuffer<iovec, OUT_QUEUE_SIZE> egress;
 	//-----------------------------------------------------------------
 	static SSLContext *sslCtx;
+	static SocketProfile *profile;
 };
 
 } /* namespace wanhive */
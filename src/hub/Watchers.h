@@ -12,7 +12,7 @@
 
 #ifndef WH_HUB_WATCHERS_H_
 #define WH_HUB_WATCHERS_H_
-#include "../base/ds/Khash.h"
+#include "../base/ds/Swiss.h"
 #include "../reactor/Watcher.h"
 
 /*! @namespace wanhive */
@@ -109,7 +109,7 @@ public:
 private:
 	static int _iterator(unsigned int index, void *arg);
 private:
-	Kmap<unsigned long long, Watcher*> watchers;
+	Smap<unsigned long long, Watcher*> watchers;
 	int (*itfn)(Watcher*, void*) {};
 	void *itfnarg { };
 };
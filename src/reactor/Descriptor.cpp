@@ -66,7 +66,12 @@ void Descriptor::setBlocking(bool block) {
 }
 
 ssize_t Descriptor::readv(const iovec *vectors, unsigned int count) {
-	auto nRead = ::readv(File::get(), vectors, count);
+	ssize_t nRead;
+	if (channel) {
+		nRead = channel->receive(File::get(), vectors, count);
+	} else {
+		nRead = ::readv(File::get(), vectors, count);
+	}
 	if (nRead > 0) {
 		return nRead;
 	} else if (nRead == 0) {
@@ -98,7 +103,12 @@ ssize_t Descriptor::read(void *buffer, size_t count) {
 }
 
 ssize_t Descriptor::writev(const iovec *vectors, unsigned int count) {
-	auto nWrite = ::writev(File::get(), vectors, count);
+	ssize_t nWrite;
+	if (channel) {
+		nWrite = channel->send(File::get(), vectors, count);
+	} else {
+		nWrite = ::writev(File::get(), vectors, count);
+	}
 	if (nWrite != -1) {
 		return nWrite;
 	} else if (errno == EAGAIN || errno == EWOULDBLOCK) {
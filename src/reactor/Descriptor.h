@@ -20,6 +20,8 @@
 
 /*! @namespace wanhive */
 namespace wanhive {
+class Reactor;
+class Selector;
 /**
  * File descriptor manager
  */
@@ -119,8 +121,11 @@ protected:
 	 */
 	ssize_t write(const void *buffer, size_t count);
 private:
+	friend class Reactor;
 	UID uid;
 	Timer timer;
+	//Completion-based stream IO (see Selector::receive and Selector::send)
+	Selector *channel { };
 };
 
 } /* namespace wanhive */
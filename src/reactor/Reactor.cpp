@@ -18,17 +18,17 @@ Reactor::Reactor() noexcept {
 
 }
 
-Reactor::Reactor(unsigned int events, bool signal) {
-	selector.initialize(events, signal);
+Reactor::Reactor(unsigned int events, bool signal, bool uring) {
+	selector.initialize(events, signal, uring);
 }
 
 Reactor::~Reactor() {
 
 }
 
-void Reactor::initialize(unsigned int events, bool signal) {
+void Reactor::initialize(unsigned int events, bool signal, bool uring) {
 	timeout = -1;
-	selector.initialize(events, signal);
+	selector.initialize(events, signal, uring);
 	readyList.initialize();
 }
 
@@ -37,7 +37,12 @@ void Reactor::add(Watcher *w, uint32_t events) {
 		admit(w);
 
 		events |= (IO_CLOSE | TRIGGER_EDGE);
+		auto stream = selector.streaming() && w->getOption(WATCHER_STREAM);
+		if (stream) {
+			events |= TRIGGER_STREAM;
+		}
 		selector.add(w->get(), events, w);
+		w->channel = stream ? &selector : nullptr;
 
 		w->setFlags(WATCHER_RUNNING);
 	} else {
@@ -48,6 +53,9 @@ void Reactor::add(Watcher *w, uint32_t events) {
 void Reactor::modify(Watcher *w, uint32_t events) {
 	if (w && w->testFlags(WATCHER_RUNNING)) {
 		events |= (IO_CLOSE | TRIGGER_EDGE);
+		if (w->channel) {
+			events |= TRIGGER_STREAM;
+		}
 		selector.modify(w->get(), events, w);
 	} else {
 		throw Exception(EX_ARGUMENT);
@@ -135,6 +143,7 @@ Watcher* Reactor::ready() noexcept {
 void Reactor::remove(Watcher *w) noexcept {
 	try {
 		selector.remove(w->get());
+		w->channel = nullptr;
 		w->clearFlags(WATCHER_RUNNING);
 		expel(w);
 	} catch (const BaseException &e) {
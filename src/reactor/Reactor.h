@@ -33,8 +33,10 @@ public:
 	 * @param events maximum number of IO events to report in each poll
 	 * @param signal set to true for handling the asynchronous signal delivery
 	 * atomically, i.e. a poll can be reliably interrupted by signals.
+	 * @param uring true to use io_uring for IO event notification, false to use
+	 * epoll (default).
 	 */
-	Reactor(unsigned int events, bool signal);
+	Reactor(unsigned int events, bool signal, bool uring = false);
 	/**
 	 * Destructor: releases the managed resources.
 	 */
@@ -45,8 +47,10 @@ public:
 	 * @param events maximum number of IO events to report in each poll
 	 * @param signal set to true for handling the asynchronous signal delivery
 	 * atomically, i.e. a poll can be reliably interrupted by signals.
+	 * @param uring true to use io_uring for IO event notification, false to use
+	 * epoll (default).
 	 */
-	void initialize(unsigned int events, bool signal);
+	void initialize(unsigned int events, bool signal, bool uring = false);
 	//-----------------------------------------------------------------
 	/**
 	 * Adds a watcher: a watcher must be added only once to only one reactor.
@@ -16,16 +16,22 @@ namespace wanhive {
 
 Watcher::Watcher() noexcept :
 		Descriptor() {
+	deadline.owner = this;
 }
 
 Watcher::Watcher(int fd) noexcept :
 		Descriptor(fd) {
+	deadline.owner = this;
 }
 
 Watcher::~Watcher() {
 
 }
 
+bool Watcher::push() noexcept {
+	return false;
+}
+
 void Watcher::setTopic(unsigned int index) noexcept {
 
 }
@@ -54,4 +60,8 @@ WatcherHandle Watcher::get() const noexcept {
 	return WatcherHandle { Descriptor::get() };
 }
 
+Deadline& Watcher::getDeadline() noexcept {
+	return deadline;
+}
+
 } /* namespace wanhive */
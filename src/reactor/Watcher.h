@@ -14,6 +14,7 @@
 #define WH_REACTOR_WATCHER_H_
 #include "Descriptor.h"
 #include "../base/ds/Handle.h"
+#include "../base/ds/TimerWheel.h"
 
 /*! @namespace wanhive */
 namespace wanhive {
@@ -38,7 +39,10 @@ enum WatcherFlag : uint32_t {
  */
 enum WatcherOption {
 	WATCHER_INBOUND_MAX, /**< Read buffer's maximum size */
-	WATCHER_OUTBOUND_MAX /**< Write buffer's maximum size */
+	WATCHER_OUTBOUND_MAX, /**< Write buffer's maximum size */
+	WATCHER_COALESCE, /**< Output coalescing delay in milliseconds */
+	WATCHER_SOJOURN, /**< Target queueing delay of the output in milliseconds */
+	WATCHER_STREAM /**< Non-zero for the completion-based IO (read-only) */
 };
 //-----------------------------------------------------------------
 class Reactor;
@@ -87,6 +91,12 @@ public:
 	 * @return true on success, false on error
 	 */
 	virtual bool publish(void *arg) noexcept = 0;
+	/**
+	 * Pushes out the output held back for coalescing (see WATCHER_COALESCE)
+	 * once it has waited long enough.
+	 * @return true if some output is still held back, false otherwise
+	 */
+	virtual bool push() noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Group communication: adds subscription to a given topic.
@@ -128,6 +138,13 @@ public:
 	 * @return the file handle
 	 */
 	WatcherHandle get() const noexcept;
+	/**
+	 * Returns the timing wheel's entry which tracks this watcher's timeout.
+	 * @return the timing wheel's entry
+	 */
+	Deadline& getDeadline() noexcept;
+private:
+	Deadline deadline;
 };
 
 } /* namespace wanhive */
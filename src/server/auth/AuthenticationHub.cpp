@@ -15,6 +15,20 @@
 #include "../../util/commands.h"
 #include <new>
 
+namespace {
+
+/* Operations delegated to the worker threads */
+enum Operation : unsigned int {
+	OP_IDENTIFY, OP_AUTHORIZE
+};
+
+/* Verifier's status flags */
+enum VerifierFlag : uint32_t {
+	VERIFIER_BUSY = 1, VERIFIER_ORPHAN = 2
+};
+
+}  // namespace
+
 namespace wanhive {
 
 AuthenticationHub::AuthenticationHub(unsigned long long uid,
@@ -28,13 +42,20 @@ AuthenticationHub::~AuthenticationHub() {
 }
 
 void AuthenticationHub::expel(Watcher *w) noexcept {
+	if (w == lookups.watcher) {
+		//The connection may have broken without a notice (socket error)
+		retry();
+		lookups.watcher = nullptr;
+		lookups.failed = true;
+	}
+
 	Verifier *verifier { };
 	auto index = waitlist.get(w->getUid());
 	if (index != waitlist.end()) {
 		waitlist.getValue(index, verifier);
 		waitlist.remove(index);
 	}
-	delete verifier;
+	release(verifier);
 	Hub::expel(w);
 }
 
@@ -44,6 +65,15 @@ void AuthenticationHub::configure(void *arg) {
 		auto &conf = Identity::getOptions();
 		dbi.info.name = conf.getString("AUTH", "database");
 		dbi.command = conf.getString("AUTH", "query");
+		dbi.depth = conf.getNumber("AUTH", "pipeline", PIPELINE_DEPTH);
+		dbi.backlog = conf.getNumber("AUTH", "backlog", LOOKUP_BACKLOG);
+		dbi.channel = conf.getString("AUTH", "channel");
+		//Revoked credentials must not linger in the cache unnoticed
+		auto size = conf.getNumber("AUTH", "cache",
+				dbi.channel ? CACHE_SIZE : 0);
+		auto ttl = conf.getNumber("AUTH", "ttl", CACHE_TTL);
+		auto miss = conf.getNumber("AUTH", "miss", CACHE_MISS);
+		cache.setup(size, ttl, miss);
 		conf.map("RDBMS", loadDatabaseParams, &dbi);
 		dbi.seed.base = (const unsigned char*) conf.getString("AUTH", "seed");
 		if (dbi.seed.base) {
@@ -53,9 +83,11 @@ void AuthenticationHub::configure(void *arg) {
 		}
 
 		auto mask = Hub::redact();
-		WH_LOG_DEBUG("\nDATABASE= '%s'\nQUERY= '%s'\nSEED= '%s'\n",
+		WH_LOG_DEBUG("\nDATABASE= '%s'\nQUERY= '%s'\nPIPELINE= %u [BACKLOG: %u]\n"
+				"CACHE= %u [TTL: %ums, MISS: %ums]\nCHANNEL= '%s'\nSEED= '%s'\n",
 				WH_MASK_STR(mask, dbi.info.name),
-				WH_MASK_STR(mask, dbi.command),
+				WH_MASK_STR(mask, dbi.command), dbi.depth, dbi.backlog, size,
+				ttl, miss, dbi.channel,
 				WH_MASK_STR(mask, (const char *)dbi.seed.base));
 		setup();
 	} catch (const BaseException &e) {
@@ -65,7 +97,19 @@ void AuthenticationHub::configure(void *arg) {
 }
 
 void AuthenticationHub::cleanup() noexcept {
+	//Take back the verifiers from the worker threads
+	settle();
 	waitlist.iterate(deleteVerifiers, this);
+	Message *request { };
+	while (lookups.requests.get(request)) {
+		Message::recycle(request);
+	}
+	while (lookups.backlog.get(request)) {
+		Message::recycle(request);
+	}
+	lookups.watcher = nullptr;
+	lookups.failed = false;
+	cache.setup(0, 0, 0);
 	things.close();
 	clear();
 	Hub::cleanup();
@@ -73,13 +117,20 @@ void AuthenticationHub::cleanup() noexcept {
 
 void AuthenticationHub::maintain() noexcept {
 	try {
-		auto status = things.health();
-		switch (status) {
-		case DBHealth::READY:
-			break;
-		default:
+		auto healthy = (things.health() == DBHealth::READY);
+		if (lookups.watcher) {
+			if (!healthy) {
+				abandon();
+			} else {
+				proceed();
+			}
+		} else if (!healthy || lookups.failed) {
+			//Reset the connection after the watcher's removal
 			things.reset(true);
-			break;
+			lookups.failed = false;
+		} else {
+			watch();
+			proceed();
 		}
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
@@ -107,6 +158,80 @@ void AuthenticationHub::route(Message *message) noexcept {
 	}
 }
 
+void AuthenticationHub::perform(Errand &errand) noexcept {
+	auto message = errand.message;
+	switch (errand.type) {
+	case OP_IDENTIFY: {
+		auto verifier = static_cast<Verifier*>(errand.arg);
+		Data nonce { message->getBytes(0), message->getPayloadLength() };
+		errand.status = verifier->identify(message->getSource(), nonce);
+		break;
+	}
+	case OP_AUTHORIZE:
+		errand.status = message->sign(getPKI());
+		break;
+	default:
+		errand.status = 0;
+		break;
+	}
+}
+
+void AuthenticationHub::onCompletion(Errand &errand) noexcept {
+	auto message = errand.message;
+	switch (errand.type) {
+	case OP_IDENTIFY: {
+		auto verifier = static_cast<Verifier*>(errand.arg);
+		verifier->clearFlags(VERIFIER_BUSY);
+		if (verifier->testFlags(VERIFIER_ORPHAN)) {
+			//The requester has left
+			delete verifier;
+			message->setDestination(getUid());
+		} else if (errand.status) {
+			acceptIdentification(message, verifier);
+		} else {
+			rejectIdentification(message);
+		}
+		break;
+	}
+	case OP_AUTHORIZE:
+		if (errand.status) {
+			message->setDestination(message->getOrigin());
+		} else {
+			handleInvalidRequest(message);
+		}
+		break;
+	default:
+		handleInvalidRequest(message);
+		break;
+	}
+}
+
+bool AuthenticationHub::handle(Backend *backend) noexcept {
+	try {
+		if (backend->testEvents(IO_CLOSE)) {
+			return abandon();
+		}
+
+		if (backend->testEvents(IO_WRITE) && backend->testFlags(WATCHER_OUT)) {
+			flush();
+		}
+
+		if (backend->testEvents(IO_READ)) {
+			things.consume();
+			if (!backend->pending()) {
+				backend->clearEvents(IO_READ);
+			}
+		}
+
+		complete();
+		invalidate();
+		return backend->isReady();
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+		return abandon();
+	}
+}
+
 int AuthenticationHub::handleIdentificationRequest(Message *message) noexcept {
 	/*
 	 * HEADER: SRC=<identity>, DEST=X, ....CMD=0, QLF=1, AQLF=0/1/127
@@ -122,39 +247,81 @@ int AuthenticationHub::handleIdentificationRequest(Message *message) noexcept {
 	}
 
 	Verifier *verifier { };
-	bool success = !isBanned(identity) && (verifier =
-			new (std::nothrow) Verifier(true))
-			&& loadIdentity(verifier, identity, nonce)
-			&& waitlist.hmPut(origin, verifier);
+	if (!isBanned(identity) && (verifier = new (std::nothrow) Verifier(true))) {
+		const Credential *credential { };
+		if (!waitlist.hmPut(origin, verifier)) {
+			delete verifier;
+		} else if ((credential = cache.get(identity))) {
+			return identify(message, credential);
+		} else if (lookup(message)) {
+			//Respond on completion of the lookup
+			return 0;
+		}
+	}
 	//-----------------------------------------------------------------
-	if (success) {
-		Data salt { nullptr, 0 };
+	return rejectIdentification(message);
+}
+
+int AuthenticationHub::identify(Message *message,
+		const Credential *credential) noexcept {
+	Verifier *verifier { };
+	Data nonce { message->getBytes(0), message->getPayloadLength() };
+	if (credential && credential->salt && nonce.base && nonce.length
+			&& waitlist.hmGet(message->getOrigin(), verifier) && verifier) {
+		verifier->setGroup(credential->group);
+		if (!verifier->prepare(credential->secret, credential->salt)) {
+			//Reject
+			return rejectIdentification(message);
+		}
+
+		//A worker thread may complete the computation before delegate() returns
+		verifier->setFlags(VERIFIER_BUSY);
+		if (delegate(OP_IDENTIFY, message, verifier)) {
+			//Respond on completion of the computation
+			return 0;
+		}
+
+		verifier->clearFlags(VERIFIER_BUSY);
+		if (verifier->identify(message->getSource(), nonce)) {
+			return acceptIdentification(message, verifier);
+		}
+	}
+	//-----------------------------------------------------------------
+	return rejectIdentification(message);
+}
+
+int AuthenticationHub::acceptIdentification(Message *message,
+		Verifier *verifier) noexcept {
+	Data salt { nullptr, 0 };
+	Data hostNonce { nullptr, 0 };
+
+	verifier->salt(salt);
+	verifier->nonce(hostNonce);
+	return generateIdentificationResponse(message, salt, hostNonce);
+}
+
+int AuthenticationHub::rejectIdentification(Message *message) noexcept {
+	//Free up the memory and stop the <origin> from making further requests
+	Verifier *verifier { };
+	if (waitlist.hmReplace(message->getOrigin(), nullptr, verifier)) {
+		release(verifier);
+	}
+	//-----------------------------------------------------------------
+	if (dbi.seed.base && dbi.seed.length) {
+		/*
+		 * Obfuscate the failed identification request. Salt associated
+		 * with an identity should not tend to change on new request.
+		 * Nonce should look like it was randomly generated.
+		 */
+		Data salt { dbi.seed };
 		Data hostNonce { nullptr, 0 };
 
-		verifier->salt(salt);
-		verifier->nonce(hostNonce);
+		fake.fakeSalt(message->getSource(), salt);
+		fake.fakeNonce(hostNonce);
+		salt.length = Twiddler::min(salt.length, 16);
 		return generateIdentificationResponse(message, salt, hostNonce);
 	} else {
-		//Free up the memory and stop the <origin> from making further requests
-		delete verifier;
-		waitlist.hmPut(origin, nullptr);
-
-		if (dbi.seed.base && dbi.seed.length) {
-			/*
-			 * Obfuscate the failed identification request. Salt associated
-			 * with an identity should not tend to change on new request.
-			 * Nonce should look like it was randomly generated.
-			 */
-			Data salt { dbi.seed };
-			Data hostNonce { nullptr, 0 };
-
-			fake.fakeSalt(identity, salt);
-			fake.fakeNonce(hostNonce);
-			salt.length = Twiddler::min(salt.length, 16);
-			return generateIdentificationResponse(message, salt, hostNonce);
-		} else {
-			return handleInvalidRequest(message);
-		}
+		return handleInvalidRequest(message);
 	}
 }
 
@@ -165,7 +332,8 @@ int AuthenticationHub::handleAuthenticationRequest(Message *message) noexcept {
 	 * TOTAL: at least 32 bytes in Request and Response
 	 */
 	Verifier *verifier { };
-	if (!waitlist.hmGet(message->getOrigin(), verifier) || !verifier) {
+	if (!waitlist.hmGet(message->getOrigin(), verifier) || !verifier
+			|| verifier->testFlags(VERIFIER_BUSY)) {
 		return handleInvalidRequest(message);
 	}
 
@@ -193,14 +361,18 @@ int AuthenticationHub::handleAuthorizationRequest(Message *message) noexcept {
 	Verifier *verifier { };
 	waitlist.hmGet(origin, verifier);
 
-	if (!verifier || !verifier->verified()) {
+	if (!verifier || verifier->testFlags(VERIFIER_BUSY)
+			|| !verifier->verified()) {
 		return handleInvalidRequest(message);
 	}
 
 	//Message is signed on behalf of the authenticated client
 	message->writeSource(verifier->identity());
 	message->writeSession(verifier->getGroup());
-	if (message->sign(getPKI())) {
+	if (delegate(OP_AUTHORIZE, message)) {
+		//Respond on completion of the signing
+		return 0;
+	} else if (message->sign(getPKI())) {
 		message->setDestination(message->getOrigin());
 		return 0;
 	} else {
@@ -221,17 +393,179 @@ bool AuthenticationHub::isBanned(unsigned long long identity) const noexcept {
 	return false;
 }
 
-bool AuthenticationHub::loadIdentity(Verifier *verifier,
-		unsigned long long identity, const Data &nonce) noexcept {
-	try {
-		things.get(identity, nonce, verifier);
+bool AuthenticationHub::lookup(Message *message) noexcept {
+	//The request itself waits for the result
+	if (!withhold(message)) {
+		return false;
+	} else if (lookups.backlog.isEmpty() && submit(message)) {
+		try {
+			flush();
+		} catch (const BaseException &e) {
+			WH_LOG_EXCEPTION(e);
+			abandon();
+		}
+		return true;
+	} else if (lookups.backlog.put(message)) {
+		//Submitted when a slot becomes available
 		return true;
+	} else {
+		message->clearFlags(MSG_DEFERRED);
+		return false;
+	}
+}
+
+bool AuthenticationHub::submit(Message *request) noexcept {
+	if (!lookups.watcher || lookups.failed || lookups.requests.isFull()) {
+		return false;
+	}
+
+	try {
+		things.request(request->getSource());
+		return lookups.requests.put(request);
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		return false;
-	} catch (...) {
-		WH_LOG_EXCEPTION_U();
-		return false;
+	}
+}
+
+void AuthenticationHub::proceed() noexcept {
+	unsigned int count = 0;
+	CircularBufferVector<Message*> vector;
+	while (lookups.backlog.getReadable(vector)) {
+		auto request = vector.part[0].base[0];
+		Verifier *verifier { };
+		if (!waitlist.hmGet(request->getOrigin(), verifier) || !verifier) {
+			//The requester has left or has been rejected already
+			Message::recycle(request);
+		} else if (submit(request)) {
+			++count;
+		} else {
+			break;
+		}
+		lookups.backlog.skipRead(1);
+	}
+
+	if (!count) {
+		return;
+	}
+
+	try {
+		flush();
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+		abandon();
+	}
+}
+
+void AuthenticationHub::complete() {
+	CircularBufferVector<Message*> vector;
+	while (lookups.requests.getReadable(vector)) {
+		auto request = vector.part[0].base[0];
+		Credential credential;
+		auto status = things.response(credential);
+		if (status == 0) {
+			//Wait for more data
+			break;
+		}
+
+		lookups.requests.skipRead(1);
+		if (status != -2) {
+			//Remember the unknown identities too
+			cache.put(request->getSource(), credential);
+		}
+		respond(request, (status == 1) ? &credential : nullptr);
+	}
+
+	if (lookups.requests.isEmpty()) {
+		//Let the notifications through
+		things.settle();
+	}
+}
+
+void AuthenticationHub::respond(Message *request,
+		const Credential *credential) noexcept {
+	Verifier *verifier { };
+	if (!waitlist.hmGet(request->getOrigin(), verifier) || !verifier) {
+		//The requester has left or has been rejected already
+		Message::recycle(request);
+		return;
+	}
+
+	//The request returns to the event loop
+	request->clearFlags(MSG_DEFERRED);
+	identify(request, credential);
+	if (request->testFlags(MSG_DEFERRED)) {
+		//Forwarded on completion of the computation
+		return;
+	} else if (!resume(request)) {
+		Message::recycle(request);
+	}
+}
+
+void AuthenticationHub::release(Verifier *verifier) noexcept {
+	if (verifier && verifier->testFlags(VERIFIER_BUSY)) {
+		//Deleted on completion of the computation
+		verifier->setFlags(VERIFIER_ORPHAN);
+	} else {
+		delete verifier;
+	}
+}
+
+bool AuthenticationHub::abandon() noexcept {
+	lookups.failed = true;
+	return disable(lookups.watcher);
+}
+
+void AuthenticationHub::retry() noexcept {
+	//Results of the lookups in flight will never arrive, retry them first
+	auto waiting = lookups.backlog.readSpace();
+	Message *request { };
+	while (lookups.requests.get(request)) {
+		if (!lookups.backlog.put(request)) {
+			respond(request, nullptr);
+		}
+	}
+	while (waiting-- && lookups.backlog.get(request)) { //postfix --
+		lookups.backlog.put(request);
+	}
+}
+
+void AuthenticationHub::invalidate() noexcept {
+	unsigned long long identity { };
+	while (things.notification(identity)) {
+		if (identity) {
+			cache.invalidate(identity);
+		} else {
+			cache.clear();
+		}
+	}
+}
+
+void AuthenticationHub::flush() {
+	auto backend = lookups.watcher;
+	if (things.flush()) {
+		backend->clearFlags(WATCHER_OUT);
+	} else {
+		//Wait for the socket to become writable
+		backend->setFlags(WATCHER_OUT);
+		backend->clearEvents(IO_WRITE);
+	}
+}
+
+void AuthenticationHub::watch() {
+	//Stale entries may have been missed during the reconnection
+	if (dbi.channel) {
+		cache.clear();
+		things.listen(dbi.channel);
+	}
+	things.pipeline();
+	auto backend = new Backend(things.socket());
+	try {
+		attach(backend, IO_WR, WATCHER_ACTIVE);
+		lookups.watcher = backend;
+	} catch (const BaseException &e) {
+		delete backend;
+		throw;
 	}
 }
 
@@ -267,6 +601,9 @@ void AuthenticationHub::setup() {
 		dbi.info.ctx.values[dbi.index] = nullptr;
 		things.setCommand(dbi.command);
 		things.open(dbi.info);
+		lookups.requests.initialize(dbi.depth);
+		lookups.backlog.initialize(dbi.backlog);
+		watch();
 	} else {
 		throw Exception(EX_INDEX);
 	}
@@ -276,6 +613,9 @@ void AuthenticationHub::clear() noexcept {
 	dbi.info = DBInfo { };
 	dbi.index = 0;
 	dbi.command = nullptr;
+	dbi.depth = 0;
+	dbi.backlog = 0;
+	dbi.channel = nullptr;
 	dbi.seed = { nullptr, 0 };
 }
 
@@ -12,15 +12,27 @@
 
 #ifndef WH_SERVER_AUTH_AUTHENTICATIONHUB_H_
 #define WH_SERVER_AUTH_AUTHENTICATIONHUB_H_
+#include "Backend.h"
+#include "Credentials.h"
 #include "Things.h"
+#include "../../base/ds/CircularBuffer.h"
+#include "../../base/ds/Khash.h"
 #include "../../hub/Hub.h"
+#include "../../util/Verifier.h"
 
 /*! @namespace wanhive */
 namespace wanhive {
 /**
  * Authentication hub implementation
+ * @note Identity lookups are pipelined, the event loop never waits for the
+ * database server. A lookup waits in a bounded queue while the pipeline is
+ * full or the connection is being restored. Recently used credentials are
+ * served from a cache (by default, only if the notifications are enabled). The SRP computations and signing are delegated to the
+ * worker threads (if enabled).
+ * @warning The pipelined lookups have not been tested against a live
+ * database server (compile-checked only).
  */
-class AuthenticationHub final: public Hub {
+class AuthenticationHub final: public Hub, public Handler<Backend> {
 public:
 	/**
 	 * Constructor: creates a new hub.
@@ -39,6 +51,9 @@ private:
 	void cleanup() noexcept override;
 	void maintain() noexcept override;
 	void route(Message *message) noexcept override;
+	void perform(Errand &errand) noexcept override;
+	void onCompletion(Errand &errand) noexcept override;
+	bool handle(Backend *backend) noexcept override;
 	//-----------------------------------------------------------------
 	int handleIdentificationRequest(Message *message) noexcept;
 	int handleAuthenticationRequest(Message *message) noexcept;
@@ -46,8 +61,20 @@ private:
 	int handleInvalidRequest(Message *message) noexcept;
 	//-----------------------------------------------------------------
 	bool isBanned(unsigned long long identity) const noexcept;
-	bool loadIdentity(Verifier *verifier, unsigned long long identity,
-			const Data &nonce) noexcept;
+	bool lookup(Message *message) noexcept;
+	bool submit(Message *request) noexcept;
+	void proceed() noexcept;
+	void complete();
+	void respond(Message *request, const Credential *credential) noexcept;
+	void release(Verifier *verifier) noexcept;
+	void invalidate() noexcept;
+	bool abandon() noexcept;
+	void retry() noexcept;
+	void flush();
+	void watch();
+	int identify(Message *message, const Credential *credential) noexcept;
+	int acceptIdentification(Message *message, Verifier *verifier) noexcept;
+	int rejectIdentification(Message *message) noexcept;
 	int generateIdentificationResponse(Message *message, const Data &salt,
 			const Data &nonce) noexcept;
 	void setup();
@@ -56,14 +83,35 @@ private:
 	static int loadDatabaseParams(const char *option, const char *value,
 			void *arg) noexcept;
 	static int deleteVerifiers(unsigned int index, void *arg) noexcept;
+	//-----------------------------------------------------------------
+	/*! Default limit on the identity lookups in flight */
+	static constexpr unsigned int PIPELINE_DEPTH = 256;
+	/*! Default limit on the identity lookups waiting for a free slot */
+	static constexpr unsigned int LOOKUP_BACKLOG = 4096;
+	/*! Default capacity of the credentials cache (with notifications) */
+	static constexpr unsigned int CACHE_SIZE = 16384;
+	/*! Default lifetime of a cached credential in milliseconds */
+	static constexpr unsigned int CACHE_TTL = 60000;
+	/*! Default lifetime of a cached unknown identity in milliseconds */
+	static constexpr unsigned int CACHE_MISS = 5000;
 private:
 	Kmap<unsigned long long, Verifier*> waitlist;
 	Verifier fake { true };
 	Things things;
+	Credentials cache;
+	struct {
+		Backend *watcher { }; //Database connection's watcher
+		CircularBuffer<Message*> requests; //Lookups in flight (FIFO)
+		CircularBuffer<Message*> backlog; //Lookups waiting for a slot (FIFO)
+		bool failed { }; //Connection requires a reset
+	} lookups;
 	struct DBConnection {
 		DBInfo info;
 		unsigned int index { };
 		const char *command { };
+		unsigned int depth { };
+		unsigned int backlog { };
+		const char *channel { };
 		Data seed { };
 	} dbi;
 };
@@ -0,0 +1,55 @@
+/*
+ * Backend.cpp
+ *
+ * Database connection watcher
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "Backend.h"
+#include "AuthenticationHub.h"
+#include "../../base/unix/Fcntl.h"
+#include <sys/socket.h>
+
+namespace wanhive {
+
+Backend::Backend(int fd) :
+		Watcher { Fcntl::duplicate(fd, true) } {
+}
+
+Backend::~Backend() {
+
+}
+
+void Backend::start() {
+
+}
+
+void Backend::stop() noexcept {
+
+}
+
+bool Backend::callback(void *arg) noexcept {
+	if (getReference() != nullptr) {
+		Handler<Backend> *h = static_cast<AuthenticationHub*>(
+				static_cast<Hub*>(getReference()));
+		return h->handle(this);
+	} else {
+		return false;
+	}
+}
+
+bool Backend::publish(void *arg) noexcept {
+	return false;
+}
+
+bool Backend::pending() noexcept {
+	char c;
+	return ::recv(Descriptor::get(), &c, 1, MSG_PEEK | MSG_DONTWAIT) > 0;
+}
+
+} /* namespace wanhive */
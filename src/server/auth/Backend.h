@@ -0,0 +1,56 @@
+/**
+ * @file Backend.h
+ *
+ * Database connection watcher
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_SERVER_AUTH_BACKEND_H_
+#define WH_SERVER_AUTH_BACKEND_H_
+#include "../../reactor/Watcher.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Database connection watcher: delivers the IO events of a database
+ * connection's socket to the hub. The database client library retains the
+ * ownership of the connection.
+ */
+class Backend final: public Watcher {
+public:
+	/**
+	 * Constructor: watches a database connection's socket. The watcher works
+	 * on a duplicate file descriptor, hence remains valid even after the
+	 * database client library closes the original.
+	 * @param fd database connection's socket file descriptor
+	 */
+	Backend(int fd);
+	/**
+	 * Destructor
+	 */
+	~Backend();
+	//-----------------------------------------------------------------
+	/*
+	 * Watcher interface implementation
+	 */
+	void start() override;
+	void stop() noexcept override;
+	bool callback(void *arg) noexcept override;
+	bool publish(void *arg) noexcept override;
+	//-----------------------------------------------------------------
+	/**
+	 * Checks whether some incoming data is waiting to be read. Required
+	 * because the database client library doesn't drain the socket.
+	 * @return true if some data is available, false otherwise
+	 */
+	bool pending() noexcept;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_SERVER_AUTH_BACKEND_H_ */
@@ -0,0 +1,182 @@
+/*
+ * Credentials.cpp
+ *
+ * Cache of the credentials
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "Credentials.h"
+#include "../../base/Timer.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace wanhive {
+
+struct Credentials::Entry {
+	unsigned long long identity; //Thing's identity
+	Timer timer; //Creation time
+	unsigned int lifetime; //Milliseconds
+	Credential credential; //Points into the trailing storage
+	Entry *prev; //Towards the most recently used
+	Entry *next; //Towards the least recently used
+};
+
+Credentials::Credentials() noexcept {
+
+}
+
+Credentials::~Credentials() {
+	clear();
+}
+
+void Credentials::setup(unsigned int capacity, unsigned int ttl,
+		unsigned int miss) noexcept {
+	clear();
+	this->capacity = ttl ? capacity : 0;
+	this->ttl = ttl;
+	this->miss = miss;
+}
+
+const Credential* Credentials::get(unsigned long long identity) noexcept {
+	Entry *entry { };
+	if (!entries.hmGet(identity, entry)) {
+		return nullptr;
+	} else if (entry->timer.hasTimedOut(entry->lifetime)) {
+		remove(entry);
+		return nullptr;
+	} else {
+		unlink(entry);
+		link(entry);
+		return &entry->credential;
+	}
+}
+
+bool Credentials::put(unsigned long long identity,
+		const Credential &credential) noexcept {
+	if (!capacity || (!credential.salt && !miss)) {
+		return false;
+	}
+
+	invalidate(identity);
+	if (entries.size() >= capacity) {
+		remove(tail);
+	}
+
+	auto entry = create(identity, credential);
+	if (!entry) {
+		return false;
+	} else if (!entries.hmPut(identity, entry)) {
+		free(entry);
+		return false;
+	} else {
+		entry->lifetime = credential.salt ? ttl : miss;
+		link(entry);
+		return true;
+	}
+}
+
+bool Credentials::invalidate(unsigned long long identity) noexcept {
+	Entry *entry { };
+	if (entries.hmGet(identity, entry)) {
+		remove(entry);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+void Credentials::clear() noexcept {
+	while (head) {
+		remove(head);
+	}
+}
+
+unsigned int Credentials::size() const noexcept {
+	return entries.size();
+}
+
+void Credentials::link(Entry *entry) noexcept {
+	entry->prev = nullptr;
+	entry->next = head;
+	if (head) {
+		head->prev = entry;
+	} else {
+		tail = entry;
+	}
+	head = entry;
+}
+
+void Credentials::unlink(Entry *entry) noexcept {
+	if (entry->prev) {
+		entry->prev->next = entry->next;
+	} else {
+		head = entry->next;
+	}
+
+	if (entry->next) {
+		entry->next->prev = entry->prev;
+	} else {
+		tail = entry->prev;
+	}
+
+	entry->prev = nullptr;
+	entry->next = nullptr;
+}
+
+void Credentials::remove(Entry *entry) noexcept {
+	if (entry) {
+		unlink(entry);
+		entries.removeKey(entry->identity);
+		//Don't leave the secrets behind
+		auto bytes = sizeof(Entry);
+		if (entry->credential.salt) {
+			bytes += strlen(entry->credential.salt) + 1;
+			bytes += strlen(entry->credential.secret) + 1;
+		}
+		memset((void*) entry, 0, bytes);
+		free(entry);
+	}
+}
+
+Credentials::Entry* Credentials::create(unsigned long long identity,
+		const Credential &credential) noexcept {
+	size_t saltLength = 0;
+	size_t secretLength = 0;
+	if (credential.salt) {
+		saltLength = strlen(credential.salt) + 1;
+		secretLength = strlen(credential.secret ? credential.secret : "") + 1;
+	}
+
+	auto p = malloc(sizeof(Entry) + saltLength + secretLength);
+	if (!p) {
+		return nullptr;
+	}
+
+	auto entry = new (p) Entry;
+	entry->identity = identity;
+	entry->lifetime = 0;
+	entry->credential.group = credential.group;
+	entry->prev = nullptr;
+	entry->next = nullptr;
+	if (credential.salt) {
+		auto salt = (char*) (entry + 1);
+		auto secret = salt + saltLength;
+		memcpy(salt, credential.salt, saltLength);
+		memcpy(secret, credential.secret ? credential.secret : "",
+				secretLength);
+		entry->credential.salt = salt;
+		entry->credential.secret = secret;
+	} else {
+		entry->credential.salt = nullptr;
+		entry->credential.secret = nullptr;
+	}
+	return entry;
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,106 @@
+/**
+ * @file Credentials.h
+ *
+ * Cache of the credentials
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_SERVER_AUTH_CREDENTIALS_H_
+#define WH_SERVER_AUTH_CREDENTIALS_H_
+#include "../../base/common/NonCopyable.h"
+#include "../../base/ds/Khash.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Thing's credential
+ */
+struct Credential {
+	/*! Salt (hexadecimal), nullptr if the identity doesn't exist */
+	const char *salt { nullptr };
+	/*! Password verifier (hexadecimal) */
+	const char *secret { nullptr };
+	/*! Thing's group (type) */
+	unsigned int group { };
+};
+//-----------------------------------------------------------------
+/**
+ * Bounded cache of the credentials with least-recently-used (LRU) eviction
+ * and time-to-live (TTL) expiration. Records the unknown identities too
+ * (negative caching).
+ */
+class Credentials: private NonCopyable {
+public:
+	/**
+	 * Constructor: creates a disabled cache.
+	 */
+	Credentials() noexcept;
+	/**
+	 * Destructor
+	 */
+	~Credentials();
+	//-----------------------------------------------------------------
+	/**
+	 * Empties and reconfigures the cache.
+	 * @param capacity maximum number of entries (0 disables the cache)
+	 * @param ttl lifetime of an entry in milliseconds (0 disables the cache)
+	 * @param miss lifetime of an unknown identity's entry in milliseconds (0
+	 * disables the negative caching).
+	 */
+	void setup(unsigned int capacity, unsigned int ttl,
+			unsigned int miss) noexcept;
+	/**
+	 * Looks up an identity's credential.
+	 * @param identity thing's identity
+	 * @return pointer to the credential (valid until the next modification of
+	 * the cache), nullptr if not found or expired.
+	 */
+	const Credential* get(unsigned long long identity) noexcept;
+	/**
+	 * Stores a copy of an identity's credential, replaces the existing one.
+	 * Evicts the least recently used entry if the cache is full.
+	 * @param identity thing's identity
+	 * @param credential thing's credential (Credential::salt is nullptr if the
+	 * identity doesn't exist).
+	 * @return true on success, false otherwise
+	 */
+	bool put(unsigned long long identity, const Credential &credential) noexcept;
+	/**
+	 * Removes an identity's credential.
+	 * @param identity thing's identity
+	 * @return true if the identity was found, false otherwise
+	 */
+	bool invalidate(unsigned long long identity) noexcept;
+	/**
+	 * Removes all the entries.
+	 */
+	void clear() noexcept;
+	/**
+	 * Returns the number of entries.
+	 * @return entries count
+	 */
+	unsigned int size() const noexcept;
+private:
+	struct Entry;
+	void link(Entry *entry) noexcept;
+	void unlink(Entry *entry) noexcept;
+	void remove(Entry *entry) noexcept;
+	static Entry* create(unsigned long long identity,
+			const Credential &credential) noexcept;
+private:
+	Kmap<unsigned long long, Entry*> entries;
+	Entry *head { nullptr }; //Most recently used
+	Entry *tail { nullptr }; //Least recently used
+	unsigned int capacity { };
+	unsigned int ttl { }; //Milliseconds
+	unsigned int miss { }; //Milliseconds
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_SERVER_AUTH_CREDENTIALS_H_ */
@@ -13,6 +13,7 @@
 #include "Things.h"
 #include "../../base/common/Exception.h"
 #include <arpa/inet.h>
+#include <cstdlib>
 #include <cstring>
 
 namespace {
@@ -33,20 +34,14 @@ Things::Things(const DBInfo &info) :
 }
 
 Things::~Things() {
-
+	PQclear(result);
 }
 
 void Things::setCommand(const char *command) noexcept {
 	this->command = command;
 }
 
-void Things::get(unsigned long long identity, const Data &nonce,
-		Verifier *verifier) {
-	if (!verifier || !nonce.base || !nonce.length) {
-		throw Exception(EX_ARGUMENT);
-	}
-
-	//-----------------------------------------------------------------
+void Things::request(unsigned long long identity) {
 	if (DataStore::health() != DBHealth::READY) {
 		throw Exception(EX_RESOURCE);
 	}
@@ -60,28 +55,115 @@ void Things::get(unsigned long long identity, const Data &nonce,
 
 	auto conn = DataStore::connection();
 	auto query = command ? command : DEF_QUERY;
-	auto res = PQexecParams(conn, query, 1, nullptr, paramValues, nullptr,
-			nullptr, 1);
-	if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) == 0) {
-		PQclear(res);
-		throw Exception(EX_OPERATION);
+	if (!PQsendQueryParams(conn, query, 1, nullptr, paramValues, nullptr,
+			nullptr, 1)) {
+		throw Exception(EX_RESOURCE);
+	}
+	//Isolates the failures, an error shows up in the connection's health
+	PQpipelineSync(conn);
+}
+
+int Things::response(Credential &credential) {
+	auto conn = DataStore::connection();
+	if (DataStore::health() != DBHealth::READY) {
+		throw Exception(EX_RESOURCE);
+	}
+
+	/*
+	 * Skip the end-of-results marker and the synchronization point of the
+	 * previous lookup. Anything else indicates a broken pipeline.
+	 */
+	PGresult *res = nullptr;
+	for (unsigned int skipped = 0; !res; ++skipped) {
+		if (skipped > 2) {
+			throw Exception(EX_STATE);
+		} else if (PQisBusy(conn)) {
+			return 0;
+		} else if ((res = PQgetResult(conn))
+				&& PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+			PQclear(res);
+			res = nullptr;
+		}
 	}
-	//-----------------------------------------------------------------
-	auto salt = PQgetvalue(res, 0, 1);
-	auto secret = PQgetvalue(res, 0, 2);
 
+	PQclear(result);
+	result = res;
+	settle();
+	credential = Credential { };
+	if (PQresultStatus(res) != PGRES_TUPLES_OK || PQnfields(res) < 4) {
+		return -2;
+	} else if (PQntuples(res) == 0) {
+		return -1;
+	}
+	//-----------------------------------------------------------------
+	credential.salt = PQgetvalue(res, 0, 1);
+	credential.secret = PQgetvalue(res, 0, 2);
 	if (PQgetlength(res, 0, 3) == sizeof(uint32_t)) {
-		verifier->setGroup(ntohl(*((uint32_t*) PQgetvalue(res, 0, 3))));
+		credential.group = ntohl(*((uint32_t*) PQgetvalue(res, 0, 3)));
 	} else {
-		verifier->setGroup(0xff);
+		credential.group = 0xff;
 	}
+	return 1;
+}
 
-	auto status = verifier->identify(identity, secret, salt, nonce);
+void Things::settle() {
+	auto conn = DataStore::connection();
+	for (unsigned int i = 0; i < 2 && conn && !PQisBusy(conn); ++i) {
+		auto res = PQgetResult(conn);
+		if (!res) {
+			continue;
+		}
+
+		auto status = PQresultStatus(res);
+		PQclear(res);
+		if (status == PGRES_PIPELINE_SYNC) {
+			break;
+		} else {
+			throw Exception(EX_STATE);
+		}
+	}
+}
+
+void Things::listen(const char *channel) {
+	auto conn = DataStore::connection();
+	if (!channel || !conn || PQpipelineStatus(conn) != PQ_PIPELINE_OFF) {
+		return;
+	}
+
+	auto name = PQescapeIdentifier(conn, channel, strlen(channel));
+	if (!name) {
+		throw Exception(EX_ARGUMENT);
+	}
+
+	char command[256];
+	auto n = snprintf(command, sizeof(command), "LISTEN %s", name);
+	PQfreemem(name);
+	if (n < 0 || (size_t) n >= sizeof(command)) {
+		throw Exception(EX_OVERFLOW);
+	}
+
+	auto res = PQexec(conn, command);
+	auto status = PQresultStatus(res);
 	PQclear(res);
+	if (status != PGRES_COMMAND_OK) {
+		throw Exception(EX_RESOURCE);
+	}
+}
+
+bool Things::notification(unsigned long long &identity) noexcept {
+	auto conn = DataStore::connection();
+	auto notice = conn ? PQnotifies(conn) : nullptr;
+	if (!notice) {
+		return false;
+	}
 
-	if (!status) {
-		throw Exception(EX_SECURITY);
+	char *end = nullptr;
+	identity = strtoull(notice->extra, &end, 10);
+	if (end == notice->extra || *end) {
+		identity = 0;
 	}
+	PQfreemem(notice);
+	return true;
 }
 
 } /* namespace wanhive */
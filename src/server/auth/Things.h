@@ -12,8 +12,8 @@
 
 #ifndef WH_SERVER_AUTH_THINGS_H_
 #define WH_SERVER_AUTH_THINGS_H_
+#include "Credentials.h"
 #include "../../base/db/DataStore.h"
-#include "../../util/Verifier.h"
 
 /*! @namespace wanhive */
 namespace wanhive {
@@ -43,15 +43,45 @@ public:
 	 */
 	void setCommand(const char *command) noexcept;
 	/**
-	 * Initializes a mutual authenticator for a given identity.
+	 * Queues up the lookup of an identity (pipeline mode, see
+	 * DataStore::pipeline()). Call DataStore::flush() to send the queued
+	 * lookups to the database server.
 	 * @param identity thing's identity
-	 * @param nonce cryptographic nonce
-	 * @param verifier mutual authenticator
 	 */
-	void get(unsigned long long identity, const Data &nonce,
-			Verifier *verifier);
+	void request(unsigned long long identity);
+	/**
+	 * Returns the result of the oldest pending lookup (see Things::request()).
+	 * Call DataStore::consume() to receive the results from the database
+	 * server.
+	 * @param credential stores the thing's credential, remains valid until the
+	 * next call.
+	 * @return 1 on success, 0 if the result is not available yet, -1 if the
+	 * identity doesn't exist, -2 if the lookup failed.
+	 */
+	int response(Credential &credential);
+	/**
+	 * Consumes the end-of-results marker and the synchronization point of the
+	 * last lookup if they have arrived. The notifications received after them
+	 * can't be fetched until then. Things::response() calls it after every
+	 * result, call it again when no lookup is in flight.
+	 */
+	void settle();
+	/**
+	 * Subscribes to the notifications on a channel (LISTEN). Call before
+	 * entering the pipeline mode, no-op afterwards.
+	 * @param channel channel's name
+	 */
+	void listen(const char *channel);
+	/**
+	 * Fetches the next received notification. The notification's payload
+	 * must be a thing's identity (decimal), anything else is reported as zero.
+	 * @param identity stores the identity
+	 * @return true if a notification was available, false otherwise
+	 */
+	bool notification(unsigned long long &identity) noexcept;
 private:
 	const char *command { nullptr };
+	PGresult *result { nullptr };
 };
 
 } /* namespace wanhive */
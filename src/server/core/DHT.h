@@ -30,7 +30,9 @@ public:
 	~DHT();
 	/**
 	 * Returns the maximum key length in bits. This is an architectural limit
-	 * and the implementations should not use a larger value.
+	 * and the implementations should not use a larger value. The identifiers
+	 * above the key space are available to the clients, hence the key length
+	 * is capped at 32 bits.
 	 * @return maximum identifier length in bits
 	 */
 	static constexpr unsigned int keyLength() noexcept {
@@ -42,7 +44,7 @@ public:
 #endif
 	/*! The maximum key length in bits */
 	static constexpr unsigned int KEY_LENGTH =
-			(WH_DHT_KEYLEN > 16 || WH_DHT_KEYLEN <= 0) ? 16 : WH_DHT_KEYLEN;
+			(WH_DHT_KEYLEN > 32 || WH_DHT_KEYLEN <= 0) ? 32 : WH_DHT_KEYLEN;
 #undef WH_DHT_KEYLEN
 };
 
@@ -53,6 +53,14 @@ void Finger::setConnected(bool connected) noexcept {
 	this->connected = connected;
 }
 
+unsigned int Finger::getRtt() const noexcept {
+	return rtt;
+}
+
+void Finger::setRtt(unsigned int rtt) noexcept {
+	this->rtt = rtt;
+}
+
 bool Finger::isConsistent() const noexcept {
 	return getId() == getPrior();
 }
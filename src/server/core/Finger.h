@@ -71,6 +71,16 @@ public:
 	 * @param connected true for connected, false for not connected
 	 */
 	void setConnected(bool connected) noexcept;
+	/**
+	 * Returns the smoothed round-trip time of the connection.
+	 * @return round-trip time in microseconds, 0 if unknown
+	 */
+	unsigned int getRtt() const noexcept;
+	/**
+	 * Sets the smoothed round-trip time of the connection.
+	 * @param rtt round-trip time in microseconds, 0 if unknown
+	 */
+	void setRtt(unsigned int rtt) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Checks whether the current index matches the prior index.
@@ -86,6 +96,7 @@ private:
 	unsigned int start { };
 	unsigned int id { };
 	unsigned int prior { };
+	unsigned int rtt { };
 	bool connected { };
 };
 
@@ -36,7 +36,7 @@ unsigned int Node::self() const noexcept {
 }
 
 const Finger* Node::getFinger(unsigned int index) const noexcept {
-	if (index < TABLESIZE) {
+	if (index < ENTRIES) {
 		return &table[index];
 	} else {
 		return nullptr;
@@ -44,7 +44,7 @@ const Finger* Node::getFinger(unsigned int index) const noexcept {
 }
 
 unsigned int Node::get(unsigned int index) const noexcept {
-	if (index < TABLESIZE) {
+	if (index < ENTRIES) {
 		return table[index].getId();
 	} else {
 		return 0;
@@ -54,13 +54,16 @@ unsigned int Node::get(unsigned int index) const noexcept {
 bool Node::set(unsigned int index, unsigned int key) noexcept {
 	if (index < TABLESIZE) {
 		return setFinger(table[index], key);
+	} else if (index < ENTRIES
+			&& (key == self() || isInInterval(key, self(), index - TABLESIZE))) {
+		return setFinger(table[index], key);
 	} else {
 		return false;
 	}
 }
 
 bool Node::isConsistent(unsigned int index) const noexcept {
-	if (index < TABLESIZE) {
+	if (index < ENTRIES) {
 		return table[index].isConsistent();
 	} else {
 		return false;
@@ -68,7 +71,7 @@ bool Node::isConsistent(unsigned int index) const noexcept {
 }
 
 unsigned int Node::commit(unsigned int index) noexcept {
-	if (index < TABLESIZE) {
+	if (index < ENTRIES) {
 		return table[index].commit();
 	} else {
 		return 0;
@@ -76,7 +79,7 @@ unsigned int Node::commit(unsigned int index) noexcept {
 }
 
 bool Node::isConnected(unsigned int index) const noexcept {
-	if (index < TABLESIZE) {
+	if (index < ENTRIES) {
 		return table[index].isConnected();
 	} else {
 		return false;
@@ -84,8 +87,24 @@ bool Node::isConnected(unsigned int index) const noexcept {
 }
 
 void Node::setConnected(unsigned int index, bool status) noexcept {
-	if (index < TABLESIZE) {
+	if (index < ENTRIES && table[index].isConnected() != status) {
 		table[index].setConnected(status);
+		table[index].setRtt(0);
+		routes.current = false;
+	}
+}
+
+void Node::setLatency(unsigned int key, unsigned int rtt) noexcept {
+	rtt = Twiddler::max(rtt, 1); //Zero stands for unknown
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
+		auto &f = table[i];
+		if (f.getId() != key || !f.isConnected()) {
+			continue;
+		}
+
+		auto srtt = (unsigned long) f.getRtt();
+		f.setRtt(srtt ? (unsigned int) ((7 * srtt + rtt) >> 3) : rtt);
+		routes.current = false;
 	}
 }
 
@@ -127,11 +146,65 @@ bool Node::isLocal(unsigned int key) const noexcept {
 }
 
 unsigned int Node::nextHop(unsigned int key) const noexcept {
-	auto n = localSuccessor(key);
-	if (n == 0) {
-		n = closestPredecessor(key, true);
+	if (!routes.current || key > MAX_ID) {
+		return lookup(key);
 	}
-	return n;
+
+	//Branch-free binary search for the arc containing the key
+	auto d = distance(key);
+	unsigned int low = 0;
+	for (auto n = routes.count; n > 1; n -= (n >> 1)) {
+		auto mid = low + (n >> 1);
+		low = (routes.bounds[mid] <= d) ? mid : low;
+	}
+	return routes.hops[low];
+}
+
+void Node::refresh() noexcept {
+	if (routes.current) {
+		return;
+	}
+
+	/*
+	 * The next hop changes only where a key crosses the successor or a
+	 * connected finger (clockwise from this node). Collect these boundaries,
+	 * sort them and merge the neighbouring arcs having the same next hop.
+	 */
+	unsigned long bounds[ROUTES];
+	unsigned int count = 0;
+	bounds[count++] = 1;
+	bounds[count++] = MAX_NODES; //This node's own key
+	bounds[count++] = (distance(getSuccessor()) % MAX_NODES) + 1;
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
+		auto d = distance(table[i].getId());
+		if (table[i].isConnected() && d != MAX_NODES) {
+			bounds[count++] = d + 1;
+		}
+	}
+
+	for (unsigned int i = 1; i < count; ++i) {
+		auto d = bounds[i];
+		auto j = i;
+		for (; j && bounds[j - 1] > d; --j) {
+			bounds[j] = bounds[j - 1];
+		}
+		bounds[j] = d;
+	}
+
+	routes.count = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		if (i && bounds[i] == bounds[i - 1]) {
+			continue;
+		}
+
+		auto hop = lookup((unsigned int) ((self() + bounds[i]) & MAX_ID));
+		if (!routes.count || routes.hops[routes.count - 1] != hop) {
+			routes.bounds[routes.count] = bounds[i];
+			routes.hops[routes.count] = hop;
+			++routes.count;
+		}
+	}
+	routes.current = true;
 }
 
 unsigned int Node::localSuccessor(unsigned int key) const noexcept {
@@ -185,9 +258,11 @@ bool Node::update(unsigned int key, bool joined) noexcept {
 	}
 
 	//Update the finger table
-	for (unsigned int i = 0; i < TABLESIZE; ++i) {
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
 		if (table[i].getId() == key) {
 			table[i].setConnected(joined);
+			table[i].setRtt(0);
+			routes.current = false;
 			found = true;
 		}
 	}
@@ -200,7 +275,7 @@ bool Node::isInRoute(unsigned int key) const noexcept {
 	}
 
 	//Check the finger table
-	for (unsigned int i = 0; i < TABLESIZE; ++i) {
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
 		if (table[i].getId() == key) {
 			return true;
 		}
@@ -213,11 +288,13 @@ void Node::print() noexcept {
 	fprintf(stderr, "PREDECESSOR: %u, SUCCESSOR: %u\n\n", getPredecessor(),
 			getSuccessor());
 	fprintf(stderr, "ROUTING TABLE [STABLE: %s]\n\n", WH_BOOLF(isStable()));
-	fprintf(stderr, " SN    START  CURRENT  HISTORY   CONNECTED\n");
-	for (unsigned int i = 0; i < TABLESIZE; ++i) {
+	fprintf(stderr,
+			" SN       START     CURRENT     HISTORY   CONNECTED    RTT(us)\n");
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
 		auto f = getFinger(i);
-		fprintf(stderr, "%3u%9u%9u%9u%12s\n", (i + 1), f->getStart(),
-				f->getId(), f->getPrior(), WH_BOOLF(f->isConnected()));
+		fprintf(stderr, "%3u%12u%12u%12u%12s%11u\n", (i + 1), f->getStart(),
+				f->getId(), f->getPrior(), WH_BOOLF(f->isConnected()),
+				f->getRtt());
 	}
 }
 
@@ -240,11 +317,20 @@ unsigned int Node::predecessor(unsigned int key, unsigned int index) noexcept {
 	return (key - (1UL << index)) & MAX_ID;
 }
 
+bool Node::isInInterval(unsigned int key, unsigned int uid,
+		unsigned int index) noexcept {
+	return (index < TABLESIZE)
+			&& isInRange(key, successor(uid, index),
+					predecessor(successor(uid, index + 1), 0));
+}
+
 void Node::initialize() noexcept {
 	//For correct routing on a stand-alone server (don't touch)
+	routes.current = false;
+	routes.count = 0;
 	setPredecessor(self());
-	for (unsigned int i = 0; i < TABLESIZE; ++i) {
-		table[i].setStart(successor(self(), i));
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
+		table[i].setStart(successor(self(), i % TABLESIZE));
 		table[i].setId(self());
 		table[i].commit();
 		table[i].setConnected(false);
@@ -252,11 +338,62 @@ void Node::initialize() noexcept {
 	setStable(true);
 }
 
+unsigned int Node::lookup(unsigned int key) const noexcept {
+	auto n = localSuccessor(key);
+	if (n == 0) {
+		n = nearest(key);
+	}
+	return n;
+}
+
+unsigned int Node::nearest(unsigned int key) const noexcept {
+	auto hop = closestPredecessor(key, true);
+	unsigned int cost = 0;
+	for (unsigned int i = 0; i < ENTRIES && !cost; ++i) {
+		if (table[i].getId() == hop && table[i].isConnected()) {
+			cost = table[i].getRtt();
+		}
+	}
+
+	if (hop == self() || !cost) {
+		return hop;
+	}
+
+	/*
+	 * A connected entry preceding the key and lying in the same power-of-two
+	 * interval (clockwise distance from this node) as the closest predecessor
+	 * makes at least half of its progress. Take the lowest round-trip time,
+	 * switch only if it is better by more than 1/8 (hysteresis).
+	 */
+	auto limit = distance(key);
+	auto d = distance(hop);
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
+		auto &f = table[i];
+		auto fd = distance(f.getId());
+		auto rtt = f.getRtt();
+		if (!f.isConnected() || !rtt || fd >= limit || (fd ^ d) > (fd & d)) {
+			continue;
+		} else if (rtt < (cost - (cost >> 3))) {
+			hop = f.getId();
+			cost = rtt;
+		}
+	}
+	return hop;
+}
+
+unsigned long Node::distance(unsigned int key) const noexcept {
+	auto d = (key - self()) & MAX_ID;
+	return d ? d : MAX_NODES;
+}
+
 bool Node::setFinger(Finger &f, unsigned int key, bool checkConsistent,
 		bool checkConnected) noexcept {
 	if ((key <= MAX_ID) && (!checkConsistent || f.isConsistent())) {
 		auto old = f.getId();
 		f.setId(key);
+		if (old != key) {
+			routes.current = false;
+		}
 
 		if (key && ((checkConnected && !f.isConnected()) || old != f.getId())) {
 			setStable(false);
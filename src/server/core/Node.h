@@ -18,7 +18,9 @@
 /*! @namespace wanhive */
 namespace wanhive {
 /**
- * Chord DHT (distributed hash table) implementation
+ * Chord DHT (distributed hash table) implementation. Besides the fingers, the
+ * table holds an alternative node for every finger's interval, the lookups
+ * prefer the entry with the lower round-trip time (proximity route selection).
  * @ref https://pdos.csail.mit.edu/papers/chord:sigcomm01/chord_sigcomm.pdf
  */
 class Node {
@@ -51,8 +53,11 @@ public:
 	 */
 	unsigned int get(unsigned int index) const noexcept;
 	/**
-	 * Sets a key in the finger table.
-	 * @param index finger table's index (should be less than Node::TABLESIZE)
+	 * Sets a key in the finger table. The indices from Node::TABLESIZE up to
+	 * Node::ENTRIES address the alternatives: the alternative at the index
+	 * (Node::TABLESIZE + i) must be either this node's identity (none) or a key
+	 * from the i-th finger's interval (see Node::isInInterval()).
+	 * @param index finger table's index (should be less than Node::ENTRIES)
 	 * @param key key's value (should not be greater than Node::MAX_ID)
 	 * @return true on successful update, false on error (invalid index or key)
 	 */
@@ -81,6 +86,13 @@ public:
 	 * @param status true to connect, false to disconnect
 	 */
 	void setConnected(unsigned int index, bool status) noexcept;
+	/**
+	 * Records a round-trip time sample of a connected key in the finger table.
+	 * The estimate is smoothed like TCP's SRTT (1/8 gain).
+	 * @param key key's value
+	 * @param rtt round-trip time in microseconds
+	 */
+	void setLatency(unsigned int key, unsigned int rtt) noexcept;
 	/**
 	 * Returns node's predecessor.
 	 * @return predecessor's identity
@@ -131,11 +143,18 @@ public:
 	 */
 	bool isLocal(unsigned int key) const noexcept;
 	/**
-	 * Recursive routing: calculates the next hop in lookup for a key.
+	 * Recursive routing: calculates the next hop in lookup for a key. Searches
+	 * the precomputed routing table if it is up to date (see Node::refresh()).
 	 * @param key key's value
 	 * @return next hop's identity on success, this node's identity on error
 	 */
 	unsigned int nextHop(unsigned int key) const noexcept;
+	/**
+	 * Recursive routing: rebuilds the precomputed routing table if the finger
+	 * table has changed since the last call. The table divides the identifier
+	 * ring into at most Node::ROUTES arcs of keys sharing the next hop.
+	 */
+	void refresh() noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Returns a key's local root.
@@ -225,8 +244,22 @@ public:
 	 */
 	static unsigned int predecessor(unsigned int key,
 			unsigned int index) noexcept;
+	/**
+	 * Checks whether a key belongs to a node's finger interval, i.e. the
+	 * half-open circular interval [Node::successor(uid, index),
+	 * Node::successor(uid, index + 1)).
+	 * @param key key's value
+	 * @param uid node's identity
+	 * @param index finger table's index (should be less than Node::TABLESIZE)
+	 * @return true if key is in the interval, false otherwise
+	 */
+	static bool isInInterval(unsigned int key, unsigned int uid,
+			unsigned int index) noexcept;
 private:
 	void initialize() noexcept;
+	unsigned int lookup(unsigned int key) const noexcept;
+	unsigned int nearest(unsigned int key) const noexcept;
+	unsigned long distance(unsigned int key) const noexcept;
 	bool setFinger(Finger &f, unsigned int key, bool checkConsistent = true,
 			bool checkConnected = true) noexcept;
 public:
@@ -242,11 +275,22 @@ public:
 	static constexpr unsigned int MAX_ID = ((1UL << KEYLENGTH) - 1);
 	/*! Number of finger table entries */
 	static constexpr unsigned int TABLESIZE = KEYLENGTH;
+	/*! Number of finger table entries including the alternatives */
+	static constexpr unsigned int ENTRIES = 2 * TABLESIZE;
+	/*! Maximum number of arcs in the routing table */
+	static constexpr unsigned int ROUTES = ENTRIES + 3;
 private:
 	const unsigned int _key;
 	Finger _predecessor;
-	Finger table[TABLESIZE];
+	Finger table[ENTRIES];
 	bool stable;
+	//Arcs of the identifier ring, valid only if current
+	struct {
+		bool current;
+		unsigned int count;
+		unsigned long bounds[ROUTES]; //Arc's first key (clockwise distance)
+		unsigned int hops[ROUTES]; //Next hop of the arc's keys
+	} routes;
 };
 
 } /* namespace wanhive */
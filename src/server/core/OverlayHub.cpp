@@ -13,6 +13,7 @@
 #include "OverlayHub.h"
 #include "commands.h"
 #include "../../base/common/Logger.h"
+#include "../../base/unix/Time.h"
 #include <cinttypes>
 
 namespace {
@@ -37,6 +38,14 @@ enum MessageTrace : uint32_t {
 /* Token bucket's default refill rate */
 constexpr unsigned int TOKEN_RATE = 100;
 
+/* Subscribers handed over to the bulk enqueue at once */
+constexpr unsigned int MULTICAST_BATCH = 64;
+//-----------------------------------------------------------------
+/* Operations delegated to the worker threads */
+enum Operation : unsigned int {
+	OP_REGISTER, OP_TOKEN
+};
+
 //-----------------------------------------------------------------
 }// namespace
 
@@ -70,6 +79,8 @@ void OverlayHub::configure(void *arg) {
 		auto hex = conf.getString("OVERLAY", "netmask", "0x0");
 		sscanf(hex, "%llx", &ctx.netmask);
 		ctx.group = conf.getNumber("OVERLAY", "group");
+		ctx.sojourn = conf.getNumber("OVERLAY", "sojourn");
+		ctx.successors = conf.getNumber("OVERLAY", "successors");
 
 		auto n = Identity::getIdentifiers("BOOTSTRAP", "nodes", ctx.nodes,
 				ArraySize(ctx.nodes) - 1);
@@ -80,10 +91,10 @@ void OverlayHub::configure(void *arg) {
 		ctx.nodes[n] = 0;
 
 		WH_LOG_DEBUG(
-				"\nENABLE_REGISTRATION=%s, AUTHENTICATE_CLIENTS=%s, TOKEN_RATE=%u,\n" "JOIN_OVERLAY=%s, UPDATE_CYCLE=%ums, IO_TIMEOUT=%ums, RETRY_INTERVAL=%ums,\n" "NETMASK=%#llx, GROUP_ID=%u\n",
+				"\nENABLE_REGISTRATION=%s, AUTHENTICATE_CLIENTS=%s, TOKEN_RATE=%u,\n" "JOIN_OVERLAY=%s, UPDATE_CYCLE=%ums, IO_TIMEOUT=%ums, RETRY_INTERVAL=%ums,\n" "NETMASK=%#llx, GROUP_ID=%u, TARGET_DELAY=%ums, SUCCESSORS=%u\n",
 				WH_BOOLF(ctx.enroll), WH_BOOLF(ctx.authenticate), ctx.refill,
 				WH_BOOLF(ctx.join), ctx.period, ctx.timeout, ctx.pause,
-				ctx.netmask, ctx.group);
+				ctx.netmask, ctx.group, ctx.sojourn, ctx.successors);
 		installService();
 		installTracker();
 	} catch (const BaseException &e) {
@@ -107,6 +118,8 @@ void OverlayHub::cleanup() noexcept {
 
 void OverlayHub::maintain() noexcept {
 	converge();
+	sound();
+	Node::refresh();
 }
 
 bool OverlayHub::probe(Message *message) noexcept {
@@ -118,6 +131,7 @@ void OverlayHub::route(Message *message) noexcept {
 	/*
 	 * [REGISTRATION]: Intercept and handle registration and session-key requests
 	 * because modification in the message will result in verification failure.
+	 * Responses to the round-trip time probes terminate here as well.
 	 */
 	if (intercept(message)) {
 		message->setGroup(0); //Ignore the group ID
@@ -152,6 +166,35 @@ void OverlayHub::route(Message *message) noexcept {
 	}
 }
 
+void OverlayHub::perform(Errand &errand) noexcept {
+	switch (errand.type) {
+	case OP_REGISTER:
+		errand.status = errand.message->verify(getPKI());
+		break;
+	case OP_TOKEN: {
+		Hash hash; //Not shared with the event loop
+		errand.status = generateSessionKey(errand.message, hash);
+		break;
+	}
+	default:
+		errand.status = 0;
+		break;
+	}
+}
+
+void OverlayHub::onCompletion(Errand &errand) noexcept {
+	switch (errand.type) {
+	case OP_REGISTER:
+		concludeRegistration(errand.message, errand.status);
+		break;
+	case OP_TOKEN:
+		break;
+	default:
+		handleInvalidRequest(errand.message);
+		break;
+	}
+}
+
 void OverlayHub::onAlarm(unsigned long long uid,
 		unsigned long long ticks) noexcept {
 	tokens.fill(ctx.refill);
@@ -199,7 +242,8 @@ void OverlayHub::installService() {
 	auto w = connect(fd, true, ctx.timeout);
 	worker.id = w->getUid(); //set here
 	onboard(w);
-	stabilizer.configure(fd, ctx.nodes, ctx.period, ctx.pause);
+	stabilizer.configure(fd, ctx.nodes, ctx.period, ctx.pause,
+			ctx.successors);
 }
 
 void OverlayHub::installTracker() {
@@ -246,6 +290,16 @@ void OverlayHub::installTracker() {
 			watchlist[7].context = Identity::CTX_SSL_PRIVATE;
 		}
 
+		if (auto path = getPath(Identity::CTX_SIGN_PRIVATE); path) {
+			watchlist[8].identifier = track(path, events);
+			watchlist[8].context = Identity::CTX_SIGN_PRIVATE;
+		}
+
+		if (auto path = getPath(Identity::CTX_SIGN_PUBLIC); path) {
+			watchlist[9].identifier = track(path, events);
+			watchlist[9].context = Identity::CTX_SIGN_PUBLIC;
+		}
+
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		throw;
@@ -300,6 +354,7 @@ void OverlayHub::refresh(unsigned int context) noexcept {
 		case Identity::CTX_PKI_PRIVATE:
 			if (watchlist[context].identifier != -1) {
 				WH_LOG_DEBUG("Private key file has been modified");
+				settle(); //The worker threads might be using the key
 				Identity::refresh(Identity::CTX_PKI_PRIVATE);
 			} else {
 				WH_LOG_DEBUG("Private key file has been ignored");
@@ -308,6 +363,7 @@ void OverlayHub::refresh(unsigned int context) noexcept {
 		case Identity::CTX_PKI_PUBLIC:
 			if (watchlist[context].identifier != -1) {
 				WH_LOG_DEBUG("Public key file has been modified");
+				settle(); //The worker threads might be using the key
 				Identity::refresh(Identity::CTX_PKI_PUBLIC);
 			} else {
 				WH_LOG_DEBUG("Public key file has been ignored");
@@ -337,6 +393,24 @@ void OverlayHub::refresh(unsigned int context) noexcept {
 				WH_LOG_DEBUG("SSL private key has been ignored");
 			}
 			break;
+		case Identity::CTX_SIGN_PRIVATE:
+			if (watchlist[context].identifier != -1) {
+				WH_LOG_DEBUG("Signing key file has been modified");
+				settle(); //The worker threads might be using the key
+				Identity::refresh(Identity::CTX_SIGN_PRIVATE);
+			} else {
+				WH_LOG_DEBUG("Signing key file has been ignored");
+			}
+			break;
+		case Identity::CTX_SIGN_PUBLIC:
+			if (watchlist[context].identifier != -1) {
+				WH_LOG_DEBUG("Verification key file has been modified");
+				settle(); //The worker threads might be using the key
+				Identity::refresh(Identity::CTX_SIGN_PUBLIC);
+			} else {
+				WH_LOG_DEBUG("Verification key file has been ignored");
+			}
+			break;
 		default:
 			WH_LOG_DEBUG("Martian attack!");
 			break;
@@ -356,12 +430,12 @@ bool OverlayHub::converge() noexcept {
 	setStable(true);
 
 	//First fix the connection to controller
-	if (!bridge(CONTROLLER, &sessions[TABLESIZE])) {
+	if (!bridge(CONTROLLER, &sessions[ENTRIES])) {
 		return false;
 	}
 
-	//Fall through the routing table and fix errors
-	for (unsigned int i = 0; i < TABLESIZE; i++) {
+	//Fall through the routing table (including the alternatives) and fix errors
+	for (unsigned int i = 0; i < ENTRIES; i++) {
 		if (!isConsistent(i)) {
 			auto old = commit(i);
 			if (!isInRoute(old)) {
@@ -374,7 +448,7 @@ bool OverlayHub::converge() noexcept {
 		}
 
 		//Update the connection status
-		setConnected(i, bridge(get(i), &sessions[i]));
+		setConnected(i, !isHost(get(i)) && bridge(get(i), &sessions[i]));
 	}
 
 	//If the predecessor has changed, certain connections need to be removed
@@ -398,6 +472,75 @@ bool OverlayHub::bridge(unsigned long long id, Digest *hc) noexcept {
 	}
 }
 
+void OverlayHub::sound() noexcept {
+	if (!isSuperNode() || !probes.hasTimedOut(ctx.period)) {
+		return;
+	}
+
+	/*
+	 * Ping every connected entry of the finger table once, the label carries
+	 * the departure time (see OverlayHub::echo()).
+	 */
+	probes.now();
+	for (unsigned int i = 0; i < ENTRIES; ++i) {
+		auto id = get(i);
+		auto duplicate = false;
+		for (unsigned int j = 0; j < i && !duplicate; ++j) {
+			duplicate = (get(j) == id);
+		}
+
+		if (duplicate || !isConnected(i) || isHost(id)) {
+			continue;
+		}
+
+		auto msg = Message::create();
+		if (!msg) {
+			return;
+		}
+
+		MessageHeader header;
+		header.setLabel(Time::microseconds(CLOCK_MONOTONIC));
+		header.setAddress(getUid(), id);
+		header.setControl(Message::HEADER_SIZE, 0, 0);
+		header.setContext(WH_DHT_CMD_OVERLAY, WH_DHT_QLF_PING,
+				WH_DHT_AQLF_REQUEST);
+		if (!msg->putHeader(header) || !forward(msg)) {
+			Message::recycle(msg);
+			return;
+		}
+	}
+}
+
+bool OverlayHub::echo(Message *message) noexcept {
+	auto origin = message->getOrigin();
+	if (message->getCommand() != WH_DHT_CMD_OVERLAY
+			|| message->getQualifier() != WH_DHT_QLF_PING
+			|| message->getStatus() == WH_DHT_AQLF_REQUEST
+			|| isController(origin) || !isInternal(origin)
+			|| !isHost(message->getDestination())
+			|| message->getSource() != origin) {
+		return false;
+	}
+
+	//Response to a probe (see OverlayHub::sound()), drop it after the reading
+	auto sent = message->getLabel();
+	auto now = Time::microseconds(CLOCK_MONOTONIC);
+	if (message->getStatus() == WH_DHT_AQLF_ACCEPTED && sent && sent <= now
+			&& (now - sent) < 1000ULL * ctx.timeout) {
+		setLatency(origin, (unsigned int) (now - sent));
+	}
+	message->setDestination(getUid());
+	return true;
+}
+
+bool OverlayHub::isProbe(const Message *message) const noexcept {
+	//Sent by a directly connected overlay peer on its own behalf
+	auto origin = message->getOrigin();
+	auto w = find(origin);
+	return message->getSource() == origin && w
+			&& w->testFlags(SOCKET_OVERLAY);
+}
+
 void OverlayHub::onboard(Watcher *w) noexcept {
 	auto id = w->getUid();
 	if (!isSuperNode()) {
@@ -405,9 +548,11 @@ void OverlayHub::onboard(Watcher *w) noexcept {
 	} else if (isController(id) || isWorker(id)) {
 		w->setFlags(SOCKET_PRIORITY);
 		w->setOption(WATCHER_OUTBOUND_MAX, 0); //default
+		w->setOption(WATCHER_SOJOURN, 0); //never shed
 	} else if (isInternal(id)) {
 		w->setFlags(SOCKET_OVERLAY);
 		w->setOption(WATCHER_OUTBOUND_MAX, 0); //default
+		w->setOption(WATCHER_SOJOURN, ctx.sojourn);
 		Node::update(id, true);
 	} else {
 		return;
@@ -484,17 +629,19 @@ int OverlayHub::enroll(unsigned long long source,
 		return ((request < getUid()) ? 1 : 2);
 	} else if (isLocal(mapKey(request))) {
 		//Replace existing connection on conflict
-		return !(isSuperNode() && (Socket::unallocated() <= TABLESIZE)) ? 2 : -1;
+		return !(isSuperNode() && (Socket::unallocated() <= ENTRIES)) ? 2 : -1;
 	} else {
 		return -1;
 	}
 }
 
-bool OverlayHub::authenticate(const Message *request) noexcept {
+bool OverlayHub::authenticate(Message *request) noexcept {
 	/*
 	 * 1. Confirm that the requested ID is valid
 	 * 2. Analyze the security features
 	 * 3. Impose rate limit
+	 * The signature's verification might be delegated to the worker threads,
+	 * check the MSG_DEFERRED flag on success.
 	 */
 	auto origin = request->getOrigin();
 	auto requested = request->getSource();
@@ -509,12 +656,17 @@ bool OverlayHub::authenticate(const Message *request) noexcept {
 		//CASE 2
 		return true;
 	} else if (request->getPayloadLength()
-			== Hash::SIZE + PKI::SIGNATURE_LENGTH) {
+			== Hash::SIZE + getPKI()->signatureLength()) {
 		//CASE 2 & 3
-		return tokens.take()
-				&& verifyNonce(hash, origin, getUid(),
-						(Digest*) request->getBytes(0))
-				&& request->verify(getPKI());
+		if (!tokens.take()
+				|| !verifyNonce(hash, origin, getUid(),
+						(Digest*) request->getBytes(0))) {
+			return false;
+		} else if (delegate(OP_REGISTER, request)) {
+			return true;
+		} else {
+			return request->verify(getPKI());
+		}
 	} else {
 		return false;
 	}
@@ -546,7 +698,9 @@ bool OverlayHub::validate(unsigned long long source,
 }
 
 bool OverlayHub::intercept(Message *message) noexcept {
-	if (message->getCommand() != WH_DHT_CMD_BASIC) {
+	if (message->getCommand() == WH_DHT_CMD_OVERLAY) {
+		return echo(message);
+	} else if (message->getCommand() != WH_DHT_CMD_BASIC) {
 		return false;
 	} else if (message->getQualifier() == WH_DHT_QLF_REGISTER) {
 		handleRegistrationRequest(message);
@@ -562,7 +716,8 @@ bool OverlayHub::intercept(Message *message) noexcept {
 void OverlayHub::annotate(Message *message) noexcept {
 	if (isWorker(message->getOrigin())) {
 		message->putLabel(getWorker() + getUid());
-		message->getHeader(worker.header);
+		auto slot = message->getSequenceNumber() % OverlayService::PIPELINE;
+		message->getHeader(worker.headers[slot]);
 	} else if (isExternal(message->getOrigin())) {
 		//Preserve the group ID at insertion
 		message->writeLabel(message->getGroup());
@@ -603,7 +758,8 @@ bool OverlayHub::plot(Message *message) noexcept {
 }
 
 bool OverlayHub::corroborate(const Message *response) const noexcept {
-	auto &sh = worker.header;
+	auto slot = response->getSequenceNumber() % OverlayService::PIPELINE;
+	auto &sh = worker.headers[slot];
 	return response->getStatus() != WH_DHT_AQLF_REQUEST
 			&& response->getLabel() == sh.getLabel()
 			&& isHost(response->getDestination())
@@ -795,8 +951,8 @@ bool OverlayHub::handleInvalidRequest(Message *msg) noexcept {
 bool OverlayHub::handleDescribeNodeRequest(Message *msg) noexcept {
 	/*
 	 * HEADER: SRC=0, DEST=X, ....CMD=0, QLF=127, AQLF=0/1/127
-	 * BODY: 0 bytes in Request; 84+25*Node::TABLESIZE bytes in Response
-	 * TOTAL: 32 bytes in Request; 116+25*Node::TABLESIZE bytes in Response
+	 * BODY: 0 bytes in Request; 229+13*Node::TABLESIZE bytes in Response
+	 * TOTAL: 32 bytes in Request; 261+13*Node::TABLESIZE bytes in Response
 	 */
 	if (msg->getLength() != Message::HEADER_SIZE) {
 		return handleInvalidRequest(msg);
@@ -820,8 +976,6 @@ bool OverlayHub::handleRegistrationRequest(Message *msg) noexcept {
 
 	//Get the UID of the connection object from which this message was received
 	auto origin = msg->getOrigin();
-	//Get the Requested UID
-	auto requestedUid = msg->getSource();
 	//Trap this message before publishing to the remote host
 	msg->setFlags(MSG_PROBE);
 	//-----------------------------------------------------------------
@@ -842,6 +996,17 @@ bool OverlayHub::handleRegistrationRequest(Message *msg) noexcept {
 	 */
 	//Do this before the message is modified
 	auto success = authenticate(msg);
+	if (!msg->testFlags(MSG_DEFERRED)) {
+		concludeRegistration(msg, success);
+	}
+	return true;
+}
+
+void OverlayHub::concludeRegistration(Message *msg, bool success) noexcept {
+	//Get the UID of the connection object from which this message was received
+	auto origin = msg->getOrigin();
+	//Get the Requested UID
+	auto requestedUid = msg->getSource();
 	//Set correct source identifier
 	msg->setSource(origin);
 	//-----------------------------------------------------------------
@@ -864,7 +1029,6 @@ bool OverlayHub::handleRegistrationRequest(Message *msg) noexcept {
 		msg->putLength(Message::HEADER_SIZE);
 		msg->putStatus(WH_DHT_AQLF_REJECTED);
 	}
-	return true;
 }
 
 bool OverlayHub::handleTokenRequest(Message *msg) noexcept {
@@ -886,10 +1050,12 @@ bool OverlayHub::handleTokenRequest(Message *msg) noexcept {
 		if (msg->getStatus() != WH_DHT_AQLF_ACCEPTED) {
 			return handleInvalidRequest(msg);
 		} else if (!((msg->getPayloadLength() == 2 * Hash::SIZE)
-				|| (msg->getPayloadLength()
-						== 2 * Hash::SIZE + PKI::SIGNATURE_LENGTH))) {
+				|| (getPKI()
+						&& msg->getPayloadLength()
+								== 2 * Hash::SIZE
+										+ getPKI()->signatureLength(true)))) {
 			return handleInvalidRequest(msg);
-		} else if (!msg->verify(verifyHost() ? getPKI() : nullptr)) {
+		} else if (!msg->verify(verifyHost() ? getPKI() : nullptr, true)) {
 			return handleInvalidRequest(msg);
 		} else if (nonceToId((Digest*) msg->getBytes(0)) != origin) {
 			return handleInvalidRequest(msg);
@@ -929,22 +1095,9 @@ bool OverlayHub::handleTokenRequest(Message *msg) noexcept {
 	} else if (isEphemeral(origin)
 			&& msg->getPayloadLength() == PKI::ENCRYPTED_LENGTH && verifyHost()
 			&& getPKI()) {
-		//Extract the challenge key
-		unsigned char challenge[PKI::ENCODING_LENGTH]; //Challenge
-		memset(&challenge, 0, sizeof(challenge));
-		getPKI()->decrypt((const CipherText*) msg->getBytes(0), &challenge);
-		msg->setBytes(0, (const unsigned char*) &challenge, Hash::SIZE);
-		//Build and return the session key
-		Digest hc; //Response
-		memset(&hc, 0, sizeof(hc));
-		generateNonce(hash, origin, getUid(), &hc);
-		msg->setBytes(Hash::SIZE, (const unsigned char*) &hc, Hash::SIZE);
-		msg->writeSource(0);
-		msg->writeDestination(0);
-		msg->setDestination(origin);
-		msg->putLength(Message::HEADER_SIZE + 2 * Hash::SIZE);
-		msg->putStatus(WH_DHT_AQLF_ACCEPTED);
-		msg->sign(getPKI());
+		if (!delegate(OP_TOKEN, msg)) {
+			generateSessionKey(msg, hash);
+		}
 	} else {
 		msg->writeSource(0);
 		msg->writeDestination(0);
@@ -955,6 +1108,27 @@ bool OverlayHub::handleTokenRequest(Message *msg) noexcept {
 	return true;
 }
 
+bool OverlayHub::generateSessionKey(Message *msg, Hash &hash) noexcept {
+	auto origin = msg->getOrigin();
+	//Extract the challenge key
+	unsigned char challenge[PKI::ENCODING_LENGTH]; //Challenge
+	memset(&challenge, 0, sizeof(challenge));
+	getPKI()->decrypt((const CipherText*) msg->getBytes(0), &challenge);
+	msg->setBytes(0, (const unsigned char*) &challenge, Hash::SIZE);
+	//Build and return the session key
+	Digest hc; //Response
+	memset(&hc, 0, sizeof(hc));
+	generateNonce(hash, origin, getUid(), &hc);
+	msg->setBytes(Hash::SIZE, (const unsigned char*) &hc, Hash::SIZE);
+	msg->writeSource(0);
+	msg->writeDestination(0);
+	msg->setDestination(origin);
+	msg->putLength(Message::HEADER_SIZE + 2 * Hash::SIZE);
+	msg->putStatus(WH_DHT_AQLF_ACCEPTED);
+	//Signed by the hub for every requester (compact signature)
+	return msg->sign(getPKI(), true);
+}
+
 bool OverlayHub::handleFindRootRequest(Message *msg) noexcept {
 	/*
 	 * HEADER: SRC=0, DEST=X, ....CMD=1, QLF=2, AQLF=0/1/127
@@ -1064,17 +1238,34 @@ bool OverlayHub::handlePublishRequest(Message *msg) noexcept {
 	 * BODY: variable in Request; no Response
 	 * TOTAL: at least 32 bytes in Request; no Response
 	 */
-	Watcher *sub = nullptr;
-	unsigned int index = 0;
-	auto topic = msg->getSession();
-	while ((sub = topics.get(topic, index))) {
-		if (sub->getUid() != msg->getOrigin()
-				&& permit(msg->getOrigin(), sub->getUid())
-				&& !sub->testGroup(msg->getGroup()) && sub->publish(msg)
-				&& sub->isReady()) {
-			retain(sub);
+	auto origin = msg->getOrigin();
+	auto group = msg->getGroup();
+	unsigned int count = 0;
+	auto subs = topics.list(msg->getSession(), count);
+	Socket *batch[MULTICAST_BATCH];
+	unsigned int selected = 0;
+	for (unsigned int index = 0; index < count; ++index) {
+		//Subscribers are scattered in memory, hide the cache misses
+		if ((index + Topics::PREFETCH_DISTANCE) < count) {
+			__builtin_prefetch(subs[index + Topics::PREFETCH_DISTANCE]);
+		}
+
+		//Subscribers are the client connections (see serveMulticastRequest)
+		auto sub = subs[index];
+		if (sub->getUid() != origin && permit(origin, sub->getUid())
+				&& !sub->testGroup(group)) {
+			batch[selected++] = static_cast<Socket*>(sub);
+		}
+
+		if (selected == MULTICAST_BATCH || (selected && index + 1 == count)) {
+			auto accepted = Socket::publish(msg, batch, selected);
+			for (unsigned int i = 0; i < accepted; ++i) {
+				if (batch[i]->isReady()) {
+					retain(batch[i]);
+				}
+			}
+			selected = 0;
 		}
-		++index;
 	}
 
 	msg->writeLabel(0); //Clean up internal information
@@ -1352,6 +1543,11 @@ bool OverlayHub::handlePingNodeRequest(Message *msg) noexcept {
 		buildDirectResponse(msg);
 		msg->putStatus(WH_DHT_AQLF_ACCEPTED);
 		return true;
+	} else if (isProbe(msg)) {
+		//Overlay peer measuring the round-trip time (see OverlayHub::sound())
+		buildDirectResponse(msg);
+		msg->putStatus(WH_DHT_AQLF_ACCEPTED);
+		return true;
 	} else {
 		return handleInvalidRequest(msg);
 	}
@@ -1449,14 +1645,14 @@ unsigned int OverlayHub::mapKey(unsigned long long key) noexcept {
 
 unsigned long long OverlayHub::nonceToId(const Digest *nonce) const noexcept {
 	unsigned int i = 0;
-	for (; i <= TABLESIZE; i++) {
+	for (; i <= ENTRIES; i++) {
 		if (memcmp(nonce, &sessions[i], sizeof(Digest)) == 0)
 			break;
 	}
 
-	if (i < TABLESIZE) {
+	if (i < ENTRIES) {
 		return get(i);
-	} else if (i == TABLESIZE) {
+	} else if (i == ENTRIES) {
 		return CONTROLLER;
 	} else {
 		return getUid();
@@ -1616,7 +1812,9 @@ int OverlayHub::reapClient(Watcher *w, void *arg) noexcept {
 }
 
 void OverlayHub::clear() noexcept {
-	worker.header.clear();
+	for (unsigned int i = 0; i < OverlayService::PIPELINE; ++i) {
+		worker.headers[i].clear();
+	}
 	worker.id = getUid();
 
 	memset(&ctx, 0, sizeof(ctx));
@@ -42,6 +42,8 @@ private:
 	void maintain() noexcept override;
 	bool probe(Message *message) noexcept override;
 	void route(Message *message) noexcept override;
+	void perform(Errand &errand) noexcept override;
+	void onCompletion(Errand &errand) noexcept override;
 	void onAlarm(unsigned long long uid, unsigned long long ticks) noexcept
 			override;
 	void onInotification(unsigned long long uid,
@@ -56,6 +58,9 @@ private:
 	//-----------------------------------------------------------------
 	bool converge() noexcept;
 	bool bridge(unsigned long long id, Digest *hc) noexcept;
+	void sound() noexcept;
+	bool echo(Message *message) noexcept;
+	bool isProbe(const Message *message) const noexcept;
 	//-----------------------------------------------------------------
 	void onboard(Watcher *w) noexcept;
 	void offboard(Watcher *w) noexcept;
@@ -63,7 +68,7 @@ private:
 	//-----------------------------------------------------------------
 	int enroll(const Message *request) noexcept;
 	int enroll(unsigned long long source, unsigned long long request) noexcept;
-	bool authenticate(const Message *request) noexcept;
+	bool authenticate(Message *request) noexcept;
 	bool validate(unsigned long long source,
 			unsigned long long request) const noexcept;
 	//-----------------------------------------------------------------
@@ -86,7 +91,9 @@ private:
 	bool handleDescribeNodeRequest(Message *msg) noexcept;
 
 	bool handleRegistrationRequest(Message *msg) noexcept;
+	void concludeRegistration(Message *msg, bool success) noexcept;
 	bool handleTokenRequest(Message *msg) noexcept;
+	bool generateSessionKey(Message *msg, Hash &hash) noexcept;
 	bool handleFindRootRequest(Message *msg) noexcept;
 	bool handleBootstrapRequest(Message *msg) noexcept;
 
@@ -136,7 +143,8 @@ private:
 	OverlayService stabilizer;
 
 	struct {
-		MessageHeader header;
+		//Requests in flight, indexed by their sequence numbers
+		MessageHeader headers[OverlayService::PIPELINE];
 		unsigned long long id;
 	} worker;
 	//-----------------------------------------------------------------
@@ -150,6 +158,8 @@ private:
 		unsigned int pause;
 		unsigned long long netmask;
 		unsigned int group;
+		unsigned int sojourn;
+		unsigned int successors;
 		unsigned long long nodes[128];
 	} ctx;
 	//-----------------------------------------------------------------
@@ -159,10 +169,12 @@ private:
 		unsigned long long cache[NODECACHE_SIZE];
 	} nodes;
 	//-----------------------------------------------------------------
-	Digest sessions[TABLESIZE + 1];
+	Digest sessions[ENTRIES + 1];
+	//Round-trip time probes of the finger table's connections
+	Timer probes;
 	Hash hash;
 	//-----------------------------------------------------------------
-	static constexpr unsigned int WATCHLIST_SIZE = 8;
+	static constexpr unsigned int WATCHLIST_SIZE = 10;
 	struct {
 		int context;
 		int identifier;
@@ -96,12 +96,12 @@ unsigned int OverlayHubInfo::pack(unsigned char *buffer,
 	index += sizeof(uint8_t);
 
 	for (unsigned int i = 0; i < getRoutes(); ++i) {
-		Serializer::packi64(buffer + index, getRoute(i)->start);
-		index += sizeof(uint64_t);
-		Serializer::packi64(buffer + index, getRoute(i)->current);
-		index += sizeof(uint64_t);
-		Serializer::packi64(buffer + index, getRoute(i)->old);
-		index += sizeof(uint64_t);
+		Serializer::packi32(buffer + index, getRoute(i)->start);
+		index += sizeof(uint32_t);
+		Serializer::packi32(buffer + index, getRoute(i)->current);
+		index += sizeof(uint32_t);
+		Serializer::packi32(buffer + index, getRoute(i)->old);
+		index += sizeof(uint32_t);
 		Serializer::packi8(buffer + index, getRoute(i)->connected ? 1 : 0);
 		index += sizeof(uint8_t);
 	}
@@ -125,18 +125,18 @@ unsigned int OverlayHubInfo::unpack(const unsigned char *buffer,
 	setStable(Serializer::unpacku8(buffer + index));
 	index += sizeof(uint8_t);
 
-	if (size < MIN_BYTES + (25 * getRoutes())) {
+	if (size < MIN_BYTES + (ROUTE_BYTES * getRoutes())) {
 		return 0;
 	}
 
 	for (unsigned int i = 0; i < getRoutes(); ++i) {
 		RouteInfo ri;
-		ri.start = Serializer::unpacku64(buffer + index);
-		index += sizeof(uint64_t);
-		ri.current = Serializer::unpacku64(buffer + index);
-		index += sizeof(uint64_t);
-		ri.old = Serializer::unpacku64(buffer + index);
-		index += sizeof(uint64_t);
+		ri.start = Serializer::unpacku32(buffer + index);
+		index += sizeof(uint32_t);
+		ri.current = Serializer::unpacku32(buffer + index);
+		index += sizeof(uint32_t);
+		ri.old = Serializer::unpacku32(buffer + index);
+		index += sizeof(uint32_t);
 		ri.connected = Serializer::unpacku8(buffer + index);
 		index += sizeof(uint8_t);
 		setRoute(ri, i);
@@ -152,11 +152,11 @@ void OverlayHubInfo::print() const noexcept {
 	printf("PREDECESSOR: %llu, SUCCESSOR: %llu\n\n"
 			"ROUTING TABLE [STABLE: %s]\n", getPredecessor(), getSuccessor(),
 			WH_BOOLF(isStable()));
-	printf(" SN    START  CURRENT  HISTORY   CONNECTED\n");
+	printf(" SN       START     CURRENT     HISTORY   CONNECTED\n");
 
 	for (unsigned int i = 0; i < getRoutes(); i++) {
 		auto r = getRoute(i);
-		printf("%3u%9llu%9llu%9llu%12s\n", (i + 1), r->start, r->current,
+		printf("%3u%12llu%12llu%12llu%12s\n", (i + 1), r->start, r->current,
 				r->old, WH_BOOLF(r->connected));
 	}
 	printf("\n------------------------------------------\n");
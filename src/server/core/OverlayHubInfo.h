@@ -127,9 +127,11 @@ public:
 public:
 	/*! The minimum serialized data size in bytes */
 	static constexpr unsigned int MIN_BYTES = (HubInfo::BYTES + 21);
+	/*! Serialized size of a route in bytes (32-bit keys) */
+	static constexpr unsigned int ROUTE_BYTES = 13;
 	/*! The maximum serialized data size in bytes */
 	static constexpr unsigned int MAX_BYTES = MIN_BYTES
-			+ (25 * DHT::KEY_LENGTH);
+			+ (ROUTE_BYTES * DHT::KEY_LENGTH);
 private:
 	unsigned long long predecessor { };
 	unsigned long long successor { };
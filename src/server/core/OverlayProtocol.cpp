@@ -49,8 +49,8 @@ unsigned int OverlayProtocol::processDescribeResponse(
 bool OverlayProtocol::describeRequest(uint64_t host, OverlayHubInfo &info) {
 	/*
 	 * HEADER: SRC=0, DEST=X, ....CMD=0, QLF=127, AQLF=0/1/127
-	 * BODY: 0 bytes in Request; 84+25*Node::TABLESIZE bytes in Response
-	 * TOTAL: 32 bytes in Request; 116+25*Node::TABLESIZE bytes in Response
+	 * BODY: 0 bytes in Request; 229+13*Node::TABLESIZE bytes in Response
+	 * TOTAL: 32 bytes in Request; 261+13*Node::TABLESIZE bytes in Response
 	 */
 	return createDescribeRequest(host) && executeRequest()
 			&& processDescribeResponse(info);
@@ -13,8 +13,29 @@
 #include "OverlayService.h"
 #include "../../base/common/Exception.h"
 #include "../../base/common/Logger.h"
+#include "../../base/ds/Twiddler.h"
+#include "../../util/commands.h"
 #include <cstring>
 
+namespace {
+
+//Requests which can be sent out together
+enum CallType {
+	CALL_GET_PREDECESSOR,
+	CALL_GET_SUCCESSOR,
+	CALL_GET_NEIGHBOURS,
+	CALL_PING,
+	CALL_FIND_SUCCESSOR,
+	CALL_SET_FINGER
+};
+
+//Outcome of a request, pending if the response didn't arrive
+enum CallStatus {
+	CALL_PENDING, CALL_ACCEPTED, CALL_REJECTED
+};
+
+}  // namespace
+
 namespace wanhive {
 
 OverlayService::OverlayService(unsigned long long uid) noexcept :
@@ -27,18 +48,27 @@ OverlayService::~OverlayService() {
 }
 
 void OverlayService::configure(int connection, const unsigned long long *nodes,
-		unsigned int period, unsigned int delay) noexcept {
+		unsigned int period, unsigned int delay,
+		unsigned int successors) noexcept {
 	cleanup();
 	setConnection(connection);
 	setBootstrapNodes(nodes);
 	setPeriod(period);
 	setDelay(delay);
+	setSuccessors(successors);
 }
 
 void OverlayService::periodic() noexcept {
 	try {
 		while (true) {
-			auto delay = execute() ? ctx.period : ctx.delay;
+			unsigned int delay;
+			if (execute()) {
+				delay = pace();
+			} else {
+				churn = true;
+				delay = ctx.delay;
+			}
+
 			if (wait(delay)) {
 				break;
 			}
@@ -56,28 +86,43 @@ bool OverlayService::execute() {
 			setup();
 		}
 		//-----------------------------------------------------------------
-		//STEP 1: Check whether the predecessor has failed
-		if (!checkPredecessor(uid)) {
+		//STEP 1: Fetch the predecessor and the successor (together)
+		Call local[2] { };
+		local[0] = { CALL_GET_PREDECESSOR, uid };
+		local[1] = { CALL_GET_SUCCESSOR, uid };
+		dispatch(local, 2);
+		//STEP 2: Probe the predecessor and the successor (together)
+		Call remote[2] { };
+		remote[0] = { CALL_PING, local[0].result[0] };
+		remote[1] = { CALL_GET_NEIGHBOURS, local[1].result[0] };
+		auto first = (local[0].status == CALL_ACCEPTED && remote[0].host) ? 0 : 1;
+		auto last = (local[1].status == CALL_ACCEPTED) ? 2 : 1;
+		if (first < last) {
+			dispatch(remote + first, last - first);
+		}
+		//-----------------------------------------------------------------
+		//STEP 3: Check whether the predecessor has failed
+		if (!checkPredecessor(uid, local[0], remote[0])) {
 			WH_LOG_ERROR("Predecessor check failed");
 			return false;
 		}
-		//STEP 2: Allow the network to recover from controller failure
+		//STEP 4: Allow the network to recover from controller failure
 		if (controllerFailed) {
 			controllerFailed = false;
 			return false;
 		}
-		//STEP 3: Check if the successor is alive and perform consistency check
-		if (!stabilize(uid)) {
+		//STEP 5: Check if the successor is alive and perform consistency check
+		if (!stabilize(uid, local[1], remote[1])) {
 			WH_LOG_ERROR("Stabilization failed");
 			return false;
 		}
-		//STEP 4: Now Fix the finger table (round-robin)
+		//STEP 6: Now Fix the finger table (round-robin)
 		if (!fixFingerTable(uid)) {
 			WH_LOG_ERROR("Finger table repair failed");
 			return false;
 		}
 
-		//STEP 5: success
+		//STEP 7: success
 		return true;
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
@@ -109,6 +154,132 @@ void OverlayService::cleanup() noexcept {
 	clear();
 }
 
+unsigned int OverlayService::dispatch(Call *calls, unsigned int count) noexcept {
+	if (count > PIPELINE) {
+		//The hub remembers at most PIPELINE requests in flight
+		auto accepted = dispatch(calls, PIPELINE);
+		return accepted + dispatch(calls + PIPELINE, count - PIPELINE);
+	}
+
+	unsigned int sent = 0;
+	try {
+		for (; sent < count; ++sent) {
+			calls[sent].status = post(calls[sent]) ? CALL_PENDING : CALL_REJECTED;
+		}
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+	}
+
+	unsigned int pending = 0;
+	for (unsigned int i = 0; i < sent; ++i) {
+		pending += (calls[i].status == CALL_PENDING);
+	}
+
+	//The responses can arrive in any order
+	unsigned int accepted = 0;
+	try {
+		while (pending) {
+			Endpoint::receive();
+			auto sequence = header().getSequenceNumber();
+			for (unsigned int i = 0; i < sent; ++i) {
+				auto &call = calls[i];
+				if (call.status == CALL_PENDING && call.sequence == sequence) {
+					complete(call);
+					accepted += (call.status == CALL_ACCEPTED);
+					--pending;
+					break;
+				}
+			}
+		}
+	} catch (const BaseException &e) {
+		//Timed out, the unanswered requests remain pending
+		WH_LOG_EXCEPTION(e);
+	}
+	return accepted;
+}
+
+bool OverlayService::post(Call &call) {
+	unsigned int length = 0;
+	switch (call.type) {
+	case CALL_GET_PREDECESSOR:
+		length = createGetPredecessorRequest(call.host);
+		break;
+	case CALL_GET_SUCCESSOR:
+		length = createGetSuccessorRequest(call.host);
+		break;
+	case CALL_GET_NEIGHBOURS:
+		length = createGetNeighboursRequest(call.host);
+		break;
+	case CALL_PING:
+		length = createPingRequest(call.host);
+		break;
+	case CALL_FIND_SUCCESSOR:
+		length = createFindSuccessorRequest(call.host, call.key);
+		break;
+	case CALL_SET_FINGER:
+		length = createSetFingerRequest(call.host, call.index, call.key);
+		break;
+	default:
+		break;
+	}
+
+	if (length) {
+		call.sequence = header().getSequenceNumber();
+		Endpoint::send();
+		return true;
+	} else {
+		return false;
+	}
+}
+
+void OverlayService::complete(Call &call) noexcept {
+	unsigned int length = 0;
+	if (header().getStatus() != WH_AQLF_ACCEPTED) {
+		call.status = CALL_REJECTED;
+		return;
+	}
+
+	switch (call.type) {
+	case CALL_GET_PREDECESSOR:
+		length = processGetPredecessorResponse(call.result[0]);
+		break;
+	case CALL_GET_SUCCESSOR:
+		length = processGetSuccessorResponse(call.result[0]);
+		break;
+	case CALL_GET_NEIGHBOURS:
+		length = processGetNeighboursResponse(call.result[0], call.result[1]);
+		break;
+	case CALL_PING:
+		length = processPingRequest();
+		break;
+	case CALL_FIND_SUCCESSOR:
+		length = processFindSuccessorResponse(call.key, call.result[0]);
+		break;
+	case CALL_SET_FINGER:
+		length = processSetFingerResponse(call.index, call.key);
+		break;
+	default:
+		break;
+	}
+	call.status = length ? CALL_ACCEPTED : CALL_REJECTED;
+}
+
+unsigned int OverlayService::pace() noexcept {
+	if (churn) {
+		//The ring is changing: fix the whole finger table, more often
+		tempo.batch = Node::TABLESIZE;
+		tempo.period = Twiddler::max(ctx.period / 8,
+				Twiddler::min(ctx.period, MIN_PERIOD));
+	} else {
+		//Back off gradually to the configured period
+		tempo.batch = FINGER_BATCH;
+		tempo.period = Twiddler::min(
+				Twiddler::max(tempo.period * 2, MIN_PERIOD), ctx.period);
+	}
+	churn = false;
+	return tempo.period;
+}
+
 void OverlayService::setup() {
 	try {
 		if (!uid || initialized) {
@@ -149,9 +320,14 @@ void OverlayService::clear() noexcept {
 	fIndex = 0;
 	controllerFailed = false;
 	initialized = false;
+	churn = true;
+	tempo.period = 0;
+	tempo.batch = Node::TABLESIZE;
+	memset(fingers, 0, sizeof(fingers));
 	memset(successors, 0, sizeof(successors));
 	memset(&ctx, 0, sizeof(ctx));
 	ctx.connection = -1;
+	ctx.successors = SUCCESSOR_LIST_LEN;
 }
 
 bool OverlayService::checkNetwork() noexcept {
@@ -230,19 +406,24 @@ bool OverlayService::join(uint64_t id, uint64_t start) noexcept {
 	}
 }
 
-bool OverlayService::checkPredecessor(uint64_t id) {
+bool OverlayService::checkPredecessor(uint64_t id, const Call &query,
+		const Call &probe) {
 	try {
-		uint64_t predecessor = 0;
-		if (!getPredecessorRequest(id, predecessor)) {
+		auto predecessor = query.result[0];
+		if (query.status == CALL_PENDING) {
+			//The hub didn't respond
+			throw Exception(EX_STATE);
+		} else if (query.status != CALL_ACCEPTED) {
 			return false;
 		} else if (!predecessor) {
 			//HACK: checking the controller
 			return checkController(id);
-		} else if (isReachable(predecessor)) {
+		} else if (probe.status == CALL_ACCEPTED) {
 			//Predecessor is alive
 			return true;
 		} else if (checkController(id)) {
 			//Predecessor has failed
+			churn = true;
 			return setPredecessorRequest(id, 0);
 		} else {
 			//Controller failure
@@ -254,24 +435,30 @@ bool OverlayService::checkPredecessor(uint64_t id) {
 	}
 }
 
-bool OverlayService::stabilize(uint64_t id) {
+bool OverlayService::stabilize(uint64_t id, const Call &query,
+		const Call &probe) {
 	try {
-		uint64_t successor;
-		if (!getSuccessorRequest(id, successor)) {
+		if (query.status == CALL_PENDING) {
+			throw Exception(EX_STATE);
+		} else if (query.status != CALL_ACCEPTED) {
 			return false;
 		}
+		auto successor = query.result[0];
 		//-----------------------------------------------------------------
-		uint64_t sPredecessor = 0; //predecessor of the current successor
-		uint64_t sSuccessor = 0; //successor of the current successor
-		//Get the neighbors of the current successor
-		if (!getNeighboursRequest(successor, sPredecessor, sSuccessor)) {
+		//Neighbors of the current successor
+		if (probe.status == CALL_PENDING) {
+			throw Exception(EX_STATE);
+		} else if (probe.status != CALL_ACCEPTED) {
 			return false;
 		}
+		auto sPredecessor = probe.result[0]; //predecessor of the successor
+		auto sSuccessor = probe.result[1]; //successor of the successor
 		//-----------------------------------------------------------------
 		//Stabilize the local node
 		if (sPredecessor != 0 && Node::isBetween(sPredecessor, id, successor)) {
 			if (setSuccessorRequest(id, sPredecessor)) {
 				//Successor changed
+				churn = true;
 				successor = sPredecessor;
 				successors[0] = successor;
 			} else {
@@ -292,26 +479,73 @@ bool OverlayService::stabilize(uint64_t id) {
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		//Stabilization failed, try to recover
+		churn = true;
 		return repairSuccessor(id);
 	}
 }
 
 bool OverlayService::fixFingerTable(uint64_t id) noexcept {
 	try {
-		fIndex = (fIndex + 1) % Node::TABLESIZE;
-		uint64_t start = Node::successor(id, fIndex);
-		uint64_t target = id; //Use this node to resolve the finger
-		uint64_t key = 0;
+		auto count = Twiddler::max(1U,
+				Twiddler::min(tempo.batch, Node::TABLESIZE));
+		Call lookups[Node::TABLESIZE] { };
+		for (unsigned int i = 0; i < count; ++i) {
+			fIndex = (fIndex + 1) % Node::TABLESIZE;
+			auto &call = lookups[i];
+			call.type = CALL_FIND_SUCCESSOR;
+			call.host = id; //Use this node to resolve the finger
+			call.key = Node::successor(id, fIndex);
+			call.index = fIndex;
+			if (fIndex == 0 && !getSuccessorRequest(id, call.host)) {
+				return false;
+			}
+		}
 
-		if (fIndex == 0 && !getSuccessorRequest(id, target)) {
-			return false;
-		} else if (!findSuccessorRequest(target, start, key)) {
-			return false;
-		} else if (!setFingerRequest(id, fIndex, key)) {
-			return false;
-		} else {
-			return true;
+		//Resolve the fingers together, then update them together
+		auto resolved = dispatch(lookups, count);
+		//The finger's successor is the interval's alternative (if inside)
+		Call neighbours[Node::TABLESIZE] { };
+		uint64_t alternatives[Node::TABLESIZE] { };
+		unsigned int m = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			alternatives[i] = id; //None
+			if (lookups[i].status == CALL_ACCEPTED && lookups[i].index) {
+				//Call's index refers to the lookup
+				neighbours[m++] = { CALL_GET_SUCCESSOR, lookups[i].result[0], 0, i };
+			}
 		}
+
+		dispatch(neighbours, m);
+		for (unsigned int i = 0; i < m; ++i) {
+			auto &call = neighbours[i];
+			auto &lookup = lookups[call.index];
+			if (call.status == CALL_ACCEPTED && call.result[0] != call.host
+					&& Node::isInInterval(call.result[0], id, lookup.index)) {
+				alternatives[call.index] = call.result[0];
+			}
+		}
+
+		Call updates[Node::ENTRIES] { };
+		unsigned int n = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			if (lookups[i].status == CALL_ACCEPTED) {
+				auto index = lookups[i].index;
+				updates[n++] = { CALL_SET_FINGER, id, lookups[i].result[0],
+						index };
+				updates[n++] = { CALL_SET_FINGER, id, alternatives[i],
+						Node::TABLESIZE + index };
+			}
+		}
+
+		auto updated = dispatch(updates, n);
+		for (unsigned int i = 0; i < n; ++i) {
+			auto &call = updates[i];
+			if (call.status == CALL_ACCEPTED && fingers[call.index] != call.key) {
+				fingers[call.index] = call.key;
+				churn = true;
+			}
+		}
+		return resolved == count && updated == n;
 	} catch (const BaseException &e) {
 		WH_LOG_EXCEPTION(e);
 		return false;
@@ -320,9 +554,9 @@ bool OverlayService::fixFingerTable(uint64_t id) noexcept {
 
 bool OverlayService::fixSuccessorsList(uint64_t id) noexcept {
 	try {
-		if (SUCCESSOR_LIST_LEN > 1) {
+		if (ctx.successors > 1) {
 			sIndex += 1;
-			sIndex = (sIndex >= SUCCESSOR_LIST_LEN ? 1 : sIndex);
+			sIndex = (sIndex >= ctx.successors ? 1 : sIndex);
 			//Store successor of _successors[sIndex - 1] in _successors[sIndex]
 			return getSuccessorRequest(successors[sIndex - 1],
 					successors[sIndex]);
@@ -344,7 +578,7 @@ bool OverlayService::repairSuccessor(uint64_t id) {
 		}
 
 		//Fix using the successors list
-		for (unsigned int i = 0; i < SUCCESSOR_LIST_LEN; i++) {
+		for (unsigned int i = 0; i < ctx.successors; i++) {
 			if (!successors[i]) {
 				continue;
 			} else if (successors[i] == id || isReachable(successors[i])) {
@@ -389,10 +623,19 @@ void OverlayService::setBootstrapNodes(const unsigned long long *nodes) noexcept
 
 void OverlayService::setPeriod(unsigned int period) noexcept {
 	ctx.period = period;
+	tempo.period = period;
 }
 
 void OverlayService::setDelay(unsigned int delay) noexcept {
 	ctx.delay = delay;
 }
 
+void OverlayService::setSuccessors(unsigned int successors) noexcept {
+	if (successors && successors < SUCCESSOR_LIST_LEN) {
+		ctx.successors = successors;
+	} else {
+		ctx.successors = SUCCESSOR_LIST_LEN;
+	}
+}
+
 } /* namespace wanhive */
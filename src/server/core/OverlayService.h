@@ -19,7 +19,9 @@
 /*! @namespace wanhive */
 namespace wanhive {
 /**
- * Overlay network stabilization service
+ * Overlay network stabilization service. Independent requests are sent out
+ * together and their responses are matched by the sequence numbers. The
+ * stabilization period shrinks while the ring is changing.
  */
 class OverlayService: private OverlayProtocol {
 public:
@@ -39,9 +41,12 @@ public:
 	 * @param period stabilization cycle's period in milliseconds
 	 * @param delay time to wait in milliseconds after stabilization
 	 * or network error.
+	 * @param successors successors list's length (capped at
+	 * OverlayService::SUCCESSOR_LIST_LEN, 0 for the maximum)
 	 */
 	void configure(int connection, const unsigned long long *nodes,
-			unsigned int period, unsigned int delay) noexcept;
+			unsigned int period, unsigned int delay,
+			unsigned int successors = 0) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Executes stabilization routines periodically until a notification or an
@@ -68,7 +73,30 @@ public:
 	 * Cleans up the internal resources.
 	 */
 	void cleanup() noexcept;
+public:
+	/*! Maximum number of requests in flight (power of two) */
+	static constexpr unsigned int PIPELINE = 32;
+	/*! Maximum length of the successors list */
+	static constexpr unsigned int SUCCESSOR_LIST_LEN = (
+			Node::KEYLENGTH > 1 ? Node::KEYLENGTH - 1 : 1);
 private:
+	/*
+	 * A request in flight (see OverlayService::dispatch())
+	 */
+	struct Call {
+		unsigned int type;
+		uint64_t host;
+		uint64_t key;
+		uint32_t index;
+		uint64_t result[2];
+		uint16_t sequence;
+		int status;
+	};
+	unsigned int dispatch(Call *calls, unsigned int count) noexcept;
+	bool post(Call &call);
+	void complete(Call &call) noexcept;
+	unsigned int pace() noexcept;
+	//-----------------------------------------------------------------
 	void setup();
 	void clear() noexcept;
 	bool checkNetwork() noexcept;
@@ -76,8 +104,8 @@ private:
 	//-----------------------------------------------------------------
 	bool isReachable(uint64_t id) noexcept;
 	bool join(uint64_t id, uint64_t start) noexcept;
-	bool checkPredecessor(uint64_t id);
-	bool stabilize(uint64_t id);
+	bool checkPredecessor(uint64_t id, const Call &query, const Call &probe);
+	bool stabilize(uint64_t id, const Call &query, const Call &probe);
 	bool fixFingerTable(uint64_t id) noexcept;
 	//-----------------------------------------------------------------
 	bool fixSuccessorsList(uint64_t id) noexcept;
@@ -88,23 +116,36 @@ private:
 	void setBootstrapNodes(const unsigned long long *nodes) noexcept;
 	void setPeriod(unsigned int period) noexcept;
 	void setDelay(unsigned int delay) noexcept;
+	void setSuccessors(unsigned int successors) noexcept;
 private:
 	const unsigned long long uid;
 	unsigned int sIndex;
 	unsigned int fIndex;
 	bool controllerFailed;
 	bool initialized;
+	bool churn;
 	TurnGate barrier;
 	//-----------------------------------------------------------------
-	static constexpr unsigned int SUCCESSOR_LIST_LEN = (
-			Node::KEYLENGTH > 1 ? Node::KEYLENGTH - 1 : 1);
+	//Adapts to the churn (see OverlayService::pace())
+	struct {
+		unsigned int period;
+		unsigned int batch;
+	} tempo;
+	uint64_t fingers[Node::ENTRIES];
+	//-----------------------------------------------------------------
 	uint64_t successors[SUCCESSOR_LIST_LEN];
 	//-----------------------------------------------------------------
+	/*! Number of fingers fixed per cycle in the absence of churn */
+	static constexpr unsigned int FINGER_BATCH = ((Node::TABLESIZE + 3) / 4);
+	/*! Shortest stabilization period in milliseconds */
+	static constexpr unsigned int MIN_PERIOD = 100;
+	//-----------------------------------------------------------------
 	struct {
 		unsigned long long nodes[16];
 		int connection;
 		unsigned int period;
 		unsigned int delay;
+		unsigned int successors;
 	} ctx;
 };
 
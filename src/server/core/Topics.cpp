@@ -33,7 +33,7 @@ bool Topics::put(unsigned int topic, const Watcher *w) noexcept {
 		//Elements are always added at the list's end
 		auto index = topics[topic].readSpace();
 		indexes.setValue(i, index);
-		topics[topic].put(w);
+		topics[topic].put(const_cast<Watcher*>(w));
 		return true;
 	} else { //Key was already present
 		return true;
@@ -41,14 +41,24 @@ bool Topics::put(unsigned int topic, const Watcher *w) noexcept {
 }
 
 Watcher* Topics::get(unsigned int topic, unsigned int index) const noexcept {
-	const Watcher *w = nullptr;
+	Watcher *w = nullptr;
 	if ((topic < Topic::COUNT) && topics[topic].get(w, index)) {
-		return const_cast<Watcher*>(w);
+		return w;
 	} else {
 		return nullptr;
 	}
 }
 
+Watcher* const* Topics::list(unsigned int topic,
+		unsigned int &count) const noexcept {
+	if ((topic < Topic::COUNT) && (count = topics[topic].readSpace())) {
+		return topics[topic].array();
+	} else {
+		count = 0;
+		return nullptr;
+	}
+}
+
 void Topics::remove(unsigned int topic, const Watcher *w) noexcept {
 	if ((topic >= Topic::COUNT) || !w) {
 		return;
@@ -66,7 +76,7 @@ void Topics::remove(unsigned int topic, const Watcher *w) noexcept {
 	topics[topic].remove(index);
 
 	//Adjust replacement's index
-	const Watcher *s = nullptr;
+	Watcher *s = nullptr;
 	if (!topics[topic].get(s, index)) { //The last entry
 		return;
 	} else {
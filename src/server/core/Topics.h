@@ -12,7 +12,7 @@
 
 #ifndef WH_SERVER_CORE_TOPICS_H_
 #define WH_SERVER_CORE_TOPICS_H_
-#include "../../base/ds/Khash.h"
+#include "../../base/ds/Swiss.h"
 #include "../../base/ds/ReadyList.h"
 #include "../../base/ds/Twiddler.h"
 #include "../../hub/Topic.h"
@@ -47,6 +47,14 @@ public:
 	 * @return watcher at the current index, nullptr on error
 	 */
 	Watcher* get(unsigned int topic, unsigned int index) const noexcept;
+	/**
+	 * Returns the list of watchers associated with a topic. The list remains
+	 * valid until the next modification of the topic's associations.
+	 * @param topic topic's identifier
+	 * @param count stores the number of watchers in the list
+	 * @return watchers' list (nullptr if the list is empty)
+	 */
+	Watcher* const* list(unsigned int topic, unsigned int &count) const noexcept;
 	/**
 	 * Dissociates a watcher from a topic.
 	 * @param topic topic's identifier
@@ -70,6 +78,9 @@ public:
 	 * Clears all associations.
 	 */
 	void clear() noexcept;
+public:
+	/*! Look-ahead (in elements) for prefetching during the list traversal */
+	static constexpr unsigned int PREFETCH_DISTANCE = 8;
 private:
 	struct Key {
 		const Watcher *w;
@@ -88,8 +99,8 @@ private:
 		}
 	};
 
-	ReadyList<const Watcher*> topics[Topic::COUNT];
-	Kmap<Key, unsigned int, HFN, EQFN> indexes;
+	ReadyList<Watcher*> topics[Topic::COUNT];
+	Smap<Key, unsigned int, HFN, EQFN> indexes;
 };
 
 } /* namespace wanhive */
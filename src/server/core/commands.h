@@ -24,7 +24,8 @@ enum WhpDhtCommand {
 	WH_DHT_CMD_BASIC = WH_CMD_BASIC, /**< basic command */
 	WH_DHT_CMD_MULTICAST = WH_CMD_MULTICAST,/**< Pub/Sub command */
 	WH_DHT_CMD_NODE, /**< node management command */
-	WH_DHT_CMD_OVERLAY /**< network management command */
+	WH_DHT_CMD_OVERLAY, /**< network management command */
+	WH_DHT_CMD_BATCH = WH_CMD_BATCH /**< batch of messages */
 };
 
 /**
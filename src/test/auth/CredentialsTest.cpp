@@ -0,0 +1,157 @@
+/*
+ * CredentialsTest.cpp
+ *
+ * Credentials cache test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "CredentialsTest.h"
+#include "../../base/Timer.h"
+#include "../../server/auth/Credentials.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+//The cached credential matches the given salt, secret, and group
+bool matches(const wanhive::Credential *c, const char *salt,
+		const char *secret, unsigned int group) noexcept {
+	return c && c->salt && c->secret && !strcmp(c->salt, salt)
+			&& !strcmp(c->secret, secret) && c->group == group;
+}
+
+}  // namespace
+
+namespace wanhive {
+
+CredentialsTest::CredentialsTest() noexcept {
+
+}
+
+CredentialsTest::~CredentialsTest() {
+
+}
+
+void CredentialsTest::execute() noexcept {
+	bool ok = storage();
+	ok &= eviction();
+	ok &= expiration();
+	ok &= negative();
+	printf("\nCredentials cache: %s\n", ok ? "PASSED" : "FAILED");
+}
+
+bool CredentialsTest::storage() noexcept {
+	Credentials cache;
+	bool ok = true;
+	char salt[] = "a1b2";
+	char secret[] = "c3d4";
+	Credential credential { salt, secret, 7 };
+
+	ok &= check("disabled: nothing stored",
+			!cache.put(1, credential) && !cache.get(1) && !cache.size());
+	cache.setup(4, 0, 1000);
+	ok &= check("disabled: zero lifetime", !cache.put(1, credential));
+
+	cache.setup(4, 60000, 1000);
+	ok &= check("store: credential found",
+			cache.put(1, credential) && matches(cache.get(1), "a1b2", "c3d4", 7));
+	//The cache keeps its own copy
+	salt[0] = 'x';
+	secret[0] = 'y';
+	ok &= check("store: copy of the credential",
+			matches(cache.get(1), "a1b2", "c3d4", 7));
+
+	Credential replacement { "e5", "f6", 9 };
+	ok &= check("store: replaced", cache.put(1, replacement)
+			&& cache.size() == 1 && matches(cache.get(1), "e5", "f6", 9));
+	ok &= check("invalidate: removed", cache.invalidate(1) && !cache.get(1)
+			&& !cache.invalidate(1) && !cache.size());
+
+	cache.put(1, replacement);
+	cache.put(2, replacement);
+	cache.clear();
+	ok &= check("clear: emptied", !cache.size() && !cache.get(2));
+	return ok;
+}
+
+bool CredentialsTest::eviction() noexcept {
+	Credentials cache;
+	bool ok = true;
+	Credential credential { "a1", "b2", 1 };
+	cache.setup(3, 60000, 1000);
+	for (unsigned long long id = 1; id <= 3; ++id) {
+		cache.put(id, credential);
+	}
+
+	//The oldest one goes first
+	cache.put(4, credential);
+	ok &= check("evict: least recently stored", cache.size() == 3
+			&& !cache.get(1) && cache.get(2) && cache.get(3) && cache.get(4));
+
+	//A lookup refreshes the entry: order is now 2 (oldest), 3, 4
+	cache.get(2);
+	cache.put(5, credential);
+	ok &= check("evict: least recently used", cache.size() == 3
+			&& cache.get(2) && !cache.get(3) && cache.get(4) && cache.get(5));
+
+	//Replacement doesn't evict
+	cache.put(5, credential);
+	ok &= check("evict: replacement keeps the others",
+			cache.size() == 3 && cache.get(2) && cache.get(4));
+	return ok;
+}
+
+bool CredentialsTest::expiration() noexcept {
+	Credentials cache;
+	bool ok = true;
+	Credential credential { "a1", "b2", 1 };
+	cache.setup(8, 100, 1000);
+	cache.put(1, credential);
+	Timer::sleep(50);
+	cache.put(2, credential);
+	ok &= check("expire: alive within the lifetime",
+			cache.get(1) && cache.get(2));
+
+	Timer::sleep(70);
+	ok &= check("expire: expired entry dropped",
+			!cache.get(1) && cache.get(2) && cache.size() == 1);
+	Timer::sleep(50);
+	ok &= check("expire: lookups don't extend the lifetime",
+			!cache.get(2) && !cache.size());
+	return ok;
+}
+
+bool CredentialsTest::negative() noexcept {
+	Credentials cache;
+	bool ok = true;
+	Credential unknown { };
+	Credential credential { "a1", "b2", 1 };
+
+	cache.setup(8, 60000, 0);
+	ok &= check("negative: disabled", !cache.put(1, unknown) && !cache.get(1));
+
+	cache.setup(8, 60000, 100);
+	const Credential *c { };
+	ok &= check("negative: unknown identity recorded", cache.put(1, unknown)
+			&& (c = cache.get(1)) && !c->salt && !c->secret);
+	cache.put(2, credential);
+	Timer::sleep(120);
+	ok &= check("negative: shorter lifetime", !cache.get(1) && cache.get(2));
+
+	cache.put(3, unknown);
+	ok &= check("negative: replaced by the credential",
+			cache.put(3, credential) && matches(cache.get(3), "a1", "b2", 1));
+	return ok;
+}
+
+bool CredentialsTest::check(const char *what, bool ok) noexcept {
+	printf("%-52s %s\n", what, ok ? "OK" : "FAILED");
+	return ok;
+}
+
+} /* namespace wanhive */
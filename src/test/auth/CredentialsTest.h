@@ -0,0 +1,34 @@
+/*
+ * CredentialsTest.h
+ *
+ * Credentials cache test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_AUTH_CREDENTIALSTEST_H_
+#define WH_TEST_AUTH_CREDENTIALSTEST_H_
+
+/*! @namespace wanhive */
+namespace wanhive {
+
+class CredentialsTest {
+public:
+	CredentialsTest() noexcept;
+	~CredentialsTest();
+	void execute() noexcept;
+private:
+	bool storage() noexcept;
+	bool eviction() noexcept;
+	bool expiration() noexcept;
+	bool negative() noexcept;
+	static bool check(const char *what, bool ok) noexcept;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_AUTH_CREDENTIALSTEST_H_ */
@@ -0,0 +1,442 @@
+/*
+ * SelectorTest.cpp
+ *
+ * Selector test routines (epoll and io_uring backends)
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "SelectorTest.h"
+#include "../../base/common/Exception.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+void notify(int fd) noexcept {
+	uint64_t one = 1;
+	if (write(fd, &one, sizeof(one)) != sizeof(one)) {
+		perror("write");
+	}
+}
+
+//Returns false if there was nothing to read
+bool consume(int fd) noexcept {
+	uint64_t value;
+	return read(fd, &value, sizeof(value)) == sizeof(value);
+}
+
+//Byte pattern of the stream tests
+unsigned char pattern(size_t index) noexcept {
+	return (unsigned char) (index % 251);
+}
+
+//Reads everything available from <fd>, verifies the pattern
+bool verify(int fd, size_t &offset) noexcept {
+	unsigned char buffer[4096];
+	ssize_t n;
+	while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+		for (ssize_t i = 0; i < n; ++i) {
+			if (buffer[i] != pattern(offset++)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+namespace wanhive {
+
+SelectorTest::SelectorTest() noexcept {
+
+}
+
+SelectorTest::~SelectorTest() {
+
+}
+
+void SelectorTest::execute() noexcept {
+	auto epoll = run(false);
+	auto uring = run(true);
+	printf("\nepoll: %s, io_uring: %s\n", epoll ? "PASSED" : "FAILED",
+			uring ? "PASSED" : "FAILED");
+}
+
+bool SelectorTest::run(bool uring) noexcept {
+	printf("\n[%s]\n", uring ? "io_uring" : "epoll");
+	try {
+		Selector s(16, false, uring);
+		auto ok = registration(s);
+		ok &= overflow(s);
+		if (s.streaming()) {
+			ok &= stream(s);
+			ok &= recycling(s);
+		} else if (uring) {
+			printf("Stream IO not supported, skipped\n");
+		}
+		return ok;
+	} catch (const BaseException &e) {
+		printf("Test aborted: %s\n", e.what());
+		return false;
+	}
+}
+
+bool SelectorTest::registration(Selector &s) noexcept {
+	auto fd = eventfd(0, EFD_NONBLOCK);
+	if (fd == -1) {
+		perror("eventfd");
+		return false;
+	}
+
+	bool ok = true;
+	int first = 1;
+	int second = 2;
+	uint32_t events = 0;
+	unsigned int foreign = 0;
+	try {
+		s.add(fd, IO_READ | TRIGGER_EDGE, &first);
+		ok &= check("idle descriptor reports nothing",
+				drain(s, &first, events, foreign, 0) == 0 && !foreign
+						&& s.expired());
+
+		notify(fd);
+		ok &= check("read event delivered",
+				drain(s, &first, events, foreign, 100) == 1
+						&& (events & IO_READ) && !foreign);
+
+		ok &= check("edge reported only once",
+				drain(s, &first, events, foreign, 0) == 0 && !foreign);
+
+		notify(fd);
+		ok &= check("multishot request stays armed",
+				drain(s, &first, events, foreign, 100) == 1 && !foreign);
+		consume(fd);
+
+		//An eventfd is always writable
+		s.modify(fd, IO_WRITE | TRIGGER_EDGE, &second);
+		ok &= check("modified interest delivered with the new handle",
+				drain(s, &second, events, foreign, 100) == 1
+						&& (events & IO_WRITE) && !(events & IO_READ)
+						&& !foreign);
+
+		notify(fd);
+		ok &= check("old interest no longer reported",
+				drain(s, &first, events, foreign, 0) == 0);
+		consume(fd);
+
+		s.modify(fd, IO_READ | TRIGGER_ONCE, &first);
+		notify(fd);
+		ok &= check("one-shot request delivered",
+				drain(s, &first, events, foreign, 100) == 1 && !foreign);
+		consume(fd);
+		notify(fd);
+		ok &= check("one-shot request not re-armed",
+				drain(s, &first, events, foreign, 0) == 0 && !foreign);
+		consume(fd);
+
+		s.modify(fd, IO_READ | TRIGGER_EDGE, &first);
+		s.remove(fd);
+		notify(fd);
+		ok &= check("removed descriptor reports nothing",
+				drain(s, &first, events, foreign, 0) == 0 && !foreign);
+
+		bool thrown = false;
+		try {
+			s.remove(fd);
+		} catch (const BaseException &e) {
+			thrown = true;
+		}
+		ok &= check("removing twice fails", thrown);
+	} catch (const BaseException &e) {
+		printf("Test aborted: %s\n", e.what());
+		ok = false;
+	}
+
+	close(fd);
+	return ok;
+}
+
+bool SelectorTest::overflow(Selector &s) noexcept {
+	int fds[DESCRIPTORS];
+	unsigned int count = 0;
+	bool ok = true;
+	try {
+		for (; count < DESCRIPTORS; ++count) {
+			if ((fds[count] = eventfd(0, EFD_NONBLOCK)) == -1) {
+				throw Exception(EX_RESOURCE);
+			}
+
+			try {
+				s.add(fds[count], IO_READ | TRIGGER_EDGE, fds + count);
+			} catch (...) {
+				close(fds[count]);
+				throw;
+			}
+		}
+
+		/*
+		 * More completions than the completion queue can hold: the kernel
+		 * terminates the multishot requests which can't post, the selector
+		 * must re-arm them.
+		 */
+		for (int round = 0; round < 3; ++round) {
+			for (unsigned int i = 0; i < DESCRIPTORS; ++i) {
+				notify(fds[i]);
+			}
+
+			//A re-armed request may report the same event again
+			unsigned int delivered = 0;
+			while (s.select(100)) {
+				const SelectionEvent *se;
+				while ((se = s.next())) {
+					auto fd = *((int*) Selector::attachment(se));
+					if ((Selector::events(se) & IO_READ) && consume(fd)) {
+						++delivered;
+					}
+				}
+			}
+
+			char what[64];
+			snprintf(what, sizeof(what), "round %d: %u of %u delivered",
+					round + 1, delivered, DESCRIPTORS);
+			ok &= check(what, delivered == DESCRIPTORS);
+		}
+	} catch (const BaseException &e) {
+		printf("Test aborted: %s\n", e.what());
+		ok = false;
+	}
+
+	for (unsigned int i = 0; i < count; ++i) {
+		try {
+			s.remove(fds[i]);
+		} catch (const BaseException &e) {
+			ok = false;
+		}
+		close(fds[i]);
+	}
+	return ok;
+}
+
+bool SelectorTest::stream(Selector &s) noexcept {
+	int sv[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv) == -1) {
+		perror("socketpair");
+		return false;
+	}
+
+	bool ok = true;
+	int h = 0;
+	uint32_t events = 0;
+	unsigned int foreign = 0;
+	try {
+		s.add(sv[0], IO_WR | TRIGGER_EDGE | TRIGGER_STREAM, &h);
+		ok &= check("stream: initial write event delivered",
+				drain(s, &h, events, foreign, 100) && (events & IO_WRITE)
+						&& !(events & IO_READ));
+
+		char buffer[64];
+		iovec iovs[2] = { { buffer, 3 }, { buffer + 3, 16 } };
+		ok &= check("stream: nothing to receive",
+				s.receive(sv[0], iovs, 2) == -1 && errno == EAGAIN);
+
+		ok &= check("stream: peer's write",
+				write(sv[1], "hello", 5) == 5);
+		ok &= check("stream: read event delivered",
+				drain(s, &h, events, foreign, 100) && (events & IO_READ));
+		ok &= check("stream: scatter read",
+				s.receive(sv[0], iovs, 2) == 5
+						&& !memcmp(buffer, "hello", 5));
+		ok &= check("stream: drained",
+				s.receive(sv[0], iovs, 2) == -1 && errno == EAGAIN);
+
+		//The result of a send is reported by the subsequent call
+		iovec out[2] = { { (void*) "wor", 3 }, { (void*) "ld", 2 } };
+		ok &= check("stream: send request in flight",
+				s.send(sv[0], out, 2) == -1 && errno == EAGAIN
+						&& s.send(sv[0], out, 2) == -1 && errno == EAGAIN);
+		ok &= check("stream: send completion delivered",
+				drain(s, &h, events, foreign, 100) && (events & IO_WRITE));
+		ok &= check("stream: send result",
+				s.send(sv[0], out, 2) == 5 && read(sv[1], buffer, 64) == 5
+						&& !memcmp(buffer, "world", 5));
+
+		//Receive far beyond the hold limit
+		size_t sent = 0;
+		size_t received = 0;
+		bool ordered = true;
+		const size_t total = (1 << 20);
+		for (int idle = 0; received < total && idle < 50;) {
+			unsigned char chunk[8192];
+			auto n = (total - sent) < sizeof(chunk) ?
+					(total - sent) : sizeof(chunk);
+			for (size_t i = 0; i < n; ++i) {
+				chunk[i] = pattern(sent + i);
+			}
+			auto w = n ? write(sv[1], chunk, n) : 0;
+			if (w > 0) {
+				sent += w;
+			}
+
+			if (!drain(s, &h, events, foreign, 10)) {
+				++idle;
+			}
+
+			unsigned char in[3000];
+			iovec iov = { in, sizeof(in) };
+			ssize_t r;
+			while ((r = s.receive(sv[0], &iov, 1)) > 0) {
+				for (ssize_t i = 0; i < r; ++i) {
+					ordered &= (in[i] == pattern(received++));
+				}
+			}
+		}
+		ok &= check("stream: 1MB received in order",
+				received == total && ordered);
+
+		ok &= transmit(s, sv[0], sv[1], (1 << 20));
+
+		close(sv[1]);
+		sv[1] = -1;
+		ok &= check("stream: peer's shutdown delivered",
+				drain(s, &h, events, foreign, 100) && (events & IO_READ));
+		ok &= check("stream: end of file", s.receive(sv[0], iovs, 2) == 0);
+		s.remove(sv[0]);
+	} catch (const BaseException &e) {
+		printf("Test aborted: %s\n", e.what());
+		ok = false;
+	}
+
+	close(sv[0]);
+	if (sv[1] != -1) {
+		close(sv[1]);
+	}
+	return ok;
+}
+
+bool SelectorTest::recycling(Selector &s) noexcept {
+	/*
+	 * Every stream leaves its data unread at removal: the selector must
+	 * return the buffers or the streams run out of them.
+	 */
+	bool ok = true;
+	unsigned int delivered = 0;
+	const unsigned int rounds = 2048;
+	for (unsigned int i = 0; i < rounds; ++i) {
+		int sv[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv) == -1) {
+			perror("socketpair");
+			return false;
+		}
+
+		int h = 0;
+		uint32_t events = 0;
+		unsigned int foreign = 0;
+		try {
+			s.add(sv[0], IO_READ | TRIGGER_EDGE | TRIGGER_STREAM, &h);
+			if (write(sv[1], "data", 4) == 4
+					&& drain(s, &h, events, foreign, 100)
+					&& (events & IO_READ)) {
+				++delivered;
+			}
+			s.remove(sv[0]);
+		} catch (const BaseException &e) {
+			ok = false;
+		}
+		close(sv[0]);
+		close(sv[1]);
+	}
+
+	char what[64];
+	snprintf(what, sizeof(what), "stream: buffers recycled (%u of %u)",
+			delivered, rounds);
+	return check(what, delivered == rounds) && ok;
+}
+
+bool SelectorTest::transmit(Selector &s, int fd, int peer, size_t count) {
+	//Fill up the send buffer so that the next request would block
+	unsigned char chunk[4096];
+	size_t offset = 0;
+	while (true) {
+		for (size_t i = 0; i < sizeof(chunk); ++i) {
+			chunk[i] = pattern(offset + i);
+		}
+		auto n = write(fd, chunk, sizeof(chunk));
+		if (n > 0) {
+			offset += n;
+		} else {
+			break;
+		}
+	}
+
+	unsigned char *data = new unsigned char[count];
+	for (size_t i = 0; i < count; ++i) {
+		data[i] = pattern(offset + i);
+	}
+
+	int h = 0;
+	uint32_t events = 0;
+	unsigned int foreign = 0;
+	iovec iov = { data, count };
+	auto blocked = s.send(fd, &iov, 1) == -1 && errno == EAGAIN
+			&& drain(s, &h, events, foreign, 50) == 0
+			&& s.send(fd, &iov, 1) == -1 && errno == EAGAIN;
+	auto ok = check("stream: send blocked on the full buffer", blocked);
+
+	size_t sent = 0;
+	size_t received = 0;
+	bool ordered = true;
+	for (int idle = 0; sent < count && idle < 50;) {
+		ordered &= verify(peer, received);
+		if (!drain(s, &h, events, foreign, 10)) {
+			++idle;
+		}
+
+		auto n = s.send(fd, &iov, 1);
+		if (n > 0) {
+			sent += n;
+			iov.iov_base = data + sent;
+			iov.iov_len = count - sent;
+		} else if (n == -1 && errno != EAGAIN) {
+			break;
+		}
+	}
+	ordered &= verify(peer, received);
+	delete[] data;
+	return check("stream: 1MB sent in order",
+			sent == count && received == (offset + count) && ordered) && ok;
+}
+
+unsigned int SelectorTest::drain(Selector &s, const void *h, uint32_t &events,
+		unsigned int &foreign, int timeout) {
+	unsigned int count = 0;
+	events = 0;
+	foreign = 0;
+	s.select(timeout);
+	const SelectionEvent *se;
+	while ((se = s.next())) {
+		if (Selector::attachment(se) == h) {
+			events |= Selector::events(se);
+			++count;
+		} else {
+			++foreign;
+		}
+	}
+	return count;
+}
+
+bool SelectorTest::check(const char *what, bool ok) noexcept {
+	printf("%-52s %s\n", what, ok ? "OK" : "FAILED");
+	return ok;
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,44 @@
+/*
+ * SelectorTest.h
+ *
+ * Selector test routines (epoll and io_uring backends)
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_BASE_SELECTORTEST_H_
+#define WH_TEST_BASE_SELECTORTEST_H_
+#include "../../base/Selector.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+
+class SelectorTest {
+public:
+	SelectorTest() noexcept;
+	~SelectorTest();
+	void execute() noexcept;
+private:
+	bool run(bool uring) noexcept;
+	bool registration(Selector &s) noexcept;
+	bool overflow(Selector &s) noexcept;
+	bool stream(Selector &s) noexcept;
+	bool recycling(Selector &s) noexcept;
+	//Sends <count> bytes of the pattern through the selector
+	bool transmit(Selector &s, int fd, int peer, size_t count);
+	//Returns the number of events delivered for the handle <h>
+	unsigned int drain(Selector &s, const void *h, uint32_t &events,
+			unsigned int &foreign, int timeout);
+	static bool check(const char *what, bool ok) noexcept;
+private:
+	//Exceeds the completion queue of the smallest ring
+	static constexpr unsigned int DESCRIPTORS = 1024;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_BASE_SELECTORTEST_H_ */
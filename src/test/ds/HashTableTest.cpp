@@ -13,10 +13,86 @@
 #include "HashTableTest.h"
 #include "../../base/Timer.h"
 #include "../../base/ds/Khash.h"
+#include "../../base/ds/Swiss.h"
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
 
+namespace {
+
+//Measures the average cost of insertion, lookup, and removal
+template<typename MAP>
+void measure(const char *name, const unsigned long long *keys,
+		unsigned int count) noexcept {
+	MAP h;
+	wanhive::Timer t;
+	for (unsigned int i = 0; i < count; ++i) {
+		h.hmPut(keys[i], keys[i]);
+	}
+	auto insert = t.elapsed();
+
+	t.now();
+	unsigned int hits = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned long long value;
+		hits += (h.hmGet(keys[i], value) && value == keys[i]);
+	}
+	auto hit = t.elapsed();
+
+	t.now();
+	unsigned int misses = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		misses += !h.contains(keys[i] | (1ULL << 63));
+	}
+	auto miss = t.elapsed();
+
+	t.now();
+	for (unsigned int i = 0; i < count; ++i) {
+		h.removeKey(keys[i]);
+	}
+	auto erase = t.elapsed();
+
+	auto failed = (hits != count) || (misses != count) || h.size();
+	printf("%-6s %9u keys (ns/op): insert %7.2f, hit %7.2f, miss %7.2f, "
+			"erase %7.2f%s\n", name, count, (insert * 1e9 / count),
+			(hit * 1e9 / count), (miss * 1e9 / count), (erase * 1e9 / count),
+			(failed ? " [FAILED]" : ""));
+}
+
+bool check(const char *what, bool ok) noexcept {
+	printf("%-52s %s\n", what, ok ? "OK" : "FAILED");
+	return ok;
+}
+
+//Compares the hash table's content with the reference
+template<typename MAP, typename REF>
+bool same(const MAP &h, const REF &ref) noexcept {
+	if (h.size() != ref.size()) {
+		return false;
+	}
+
+	for (auto i = ref.begin(); i != ref.end(); ++i) {
+		unsigned long long key;
+		unsigned long long expected;
+		unsigned long long value;
+		if (ref.getKey(i, key) && ref.getValue(i, expected)
+				&& (!h.hmGet(key, value) || value != expected)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//Swiss table's iteration callback: removes the odd keys
+int dropOdd(unsigned int index, void *arg) {
+	auto h = (wanhive::Smap<unsigned long long, unsigned long long>*) arg;
+	unsigned long long key = 0;
+	h->getKey(index, key);
+	return (key & 1) ? 1 : 0;
+}
+
+}  // namespace
+
 namespace wanhive {
 struct packed_t {
 	unsigned key;
@@ -54,6 +130,8 @@ void HashTableTest::execute() noexcept {
 	t.now();
 	packedTest();
 	printf("%.3lf sec\n", t.elapsed());
+	printf("\n[Swiss] %s\n", swissTest() ? "PASSED" : "FAILED");
+	benchmark();
 }
 
 void HashTableTest::initData() noexcept {
@@ -142,4 +220,133 @@ void HashTableTest::packedTest() noexcept {
 			h.size(), sizeof(packed_t), collisions, insertions, h.capacity());
 }
 
+bool HashTableTest::swissTest() noexcept {
+	bool ok = true;
+	{
+		//Sixteen keys per group: the keys [0, 16) fill up the first group
+		Sset<unsigned int> h;
+		h.resize(32);
+		for (unsigned int key = 0; key < 16; ++key) {
+			h.hsPut(key);
+		}
+		ok &= check("insert: keys found", h.size() == 16 && h.contains(15));
+		ok &= check("insert: duplicate rejected", !h.hsPut(7));
+		ok &= check("insert: full group overflows", h.hsPut(32)
+				&& h.contains(32) && h.get(32) >= 16);
+
+		auto occupied = h.occupied();
+		ok &= check("erase: full group leaves a tombstone",
+				h.removeKey(5) && !h.contains(5) && h.occupied() == occupied);
+		ok &= check("erase: probe passes through the tombstone",
+				h.contains(32));
+
+		int ret = 0;
+		auto i = h.put(5, ret);
+		ok &= check("insert: tombstone reused", ret == 2 && i < 16);
+		ok &= check("erase: bucket emptied in a sparse group",
+				h.removeKey(32) && h.occupied() == (occupied - 1));
+	}
+
+	{
+		Smap<unsigned long long, unsigned long long> h;
+		Kmap<unsigned long long, unsigned long long> ref;
+		unsigned long long seed = 1;
+		unsigned int maxCapacity = 0;
+		bool correct = true;
+		//Churn around a thousand keys: tombstones accumulate
+		for (unsigned int round = 0; round < 1000000; ++round) {
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			auto key = (seed >> 33) % 2048;
+			unsigned long long old;
+			if (seed & (1ULL << 20)) {
+				correct &= (h.hmReplace(key, round, old)
+						== ref.hmReplace(key, round, old));
+			} else {
+				correct &= (h.removeKey(key) == ref.removeKey(key));
+			}
+			maxCapacity = Twiddler::max(maxCapacity, h.capacity());
+		}
+		ok &= check("churn: same as the reference", correct && same(h, ref));
+		ok &= check("rehash: tombstones purged without growth",
+				maxCapacity <= 4096 && h.occupied() <= h.upperBound());
+	}
+
+	{
+		Smap<unsigned long long, unsigned long long> h;
+		Kmap<unsigned long long, unsigned long long> ref;
+		for (unsigned long long key = 0; key < 100000; ++key) {
+			auto k = (key & 1) ? Twiddler::mix(key) : key;
+			h.hmPut(k, key);
+			ref.hmPut(k, key);
+		}
+		ok &= check("rehash: growth keeps the keys",
+				same(h, ref) && h.capacity() >= 131072);
+
+		auto capacity = h.capacity();
+		for (unsigned long long key = 0; key < 95000; ++key) {
+			auto k = (key & 1) ? Twiddler::mix(key) : key;
+			h.removeKey(k);
+			ref.removeKey(k);
+		}
+		ok &= check("rehash: sparse table shrinks",
+				same(h, ref) && h.capacity() < capacity);
+	}
+
+	{
+		Smap<unsigned long long, unsigned long long> h;
+		for (unsigned long long key = 1; key <= 1000; ++key) {
+			h.hmPut(key, key);
+		}
+		unsigned int iterators[2];
+		unsigned long long value = 0;
+		ok &= check("swap: values exchanged",
+				h.hmSwap(1, 2, iterators, true) && h.hmGet(1, value)
+						&& value == 2);
+		ok &= check("swap: value moved to the missing key",
+				h.hmSwap(3, 5000, iterators, false) && !h.contains(3)
+						&& h.hmGet(5000, value) && value == 3);
+
+		h.iterate(dropOdd, &h);
+		ok &= check("iterate: odd keys removed", h.size() == 501
+				&& !h.contains(999) && h.contains(1000));
+	}
+	return ok;
+}
+
+void HashTableTest::benchmark() noexcept {
+	constexpr unsigned int MAX_KEYS = 10000000;
+	auto random = (unsigned long long*) calloc(MAX_KEYS,
+			sizeof(unsigned long long));
+	auto sequential = (unsigned long long*) calloc(MAX_KEYS,
+			sizeof(unsigned long long));
+	if (!random || !sequential) {
+		free(random);
+		free(sequential);
+		return;
+	}
+
+	for (unsigned int i = 0; i < MAX_KEYS; ++i) {
+		//Bit 63 is reserved for the lookup misses
+		random[i] = Twiddler::mix((unsigned long long) i) & ~(1ULL << 63);
+		sequential[i] = 1000000 + i;
+	}
+
+	printf("\n[Khash vs Swiss] map: unsigned long long -> unsigned long long\n");
+	for (unsigned int count = 10000; count <= MAX_KEYS; count *= 10) {
+		printf("Random keys\n");
+		measure<Kmap<unsigned long long, unsigned long long>>("Khash", random,
+				count);
+		measure<Smap<unsigned long long, unsigned long long>>("Swiss", random,
+				count);
+		printf("Sequential keys\n");
+		measure<Kmap<unsigned long long, unsigned long long>>("Khash",
+				sequential, count);
+		measure<Smap<unsigned long long, unsigned long long>>("Swiss",
+				sequential, count);
+	}
+
+	free(random);
+	free(sequential);
+}
+
 } /* namespace wanhive */
@@ -27,6 +27,9 @@ private:
 	void intTest() noexcept;
 	void strTest() noexcept;
 	void packedTest() noexcept;
+	//Insertion, removal, rehashing, and deleted buckets of the Swiss table
+	bool swissTest() noexcept;
+	void benchmark() noexcept;
 private:
 	unsigned int dataSize;
 	unsigned *intData;
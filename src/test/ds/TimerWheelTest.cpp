@@ -0,0 +1,233 @@
+/*
+ * TimerWheelTest.cpp
+ *
+ * Timing wheel test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "TimerWheelTest.h"
+#include <cstdio>
+
+namespace {
+
+//Deadline's owner: records the deliveries
+struct Probe {
+	wanhive::Deadline deadline;
+	//Expected expiration tick
+	unsigned long long due;
+	//Tick of the last delivery
+	unsigned long long fired;
+	//Number of deliveries
+	unsigned int count;
+	//Rescheduled after this many ticks on delivery (0 to stop)
+	unsigned long long period;
+	//Cancelled on delivery
+	wanhive::Deadline *victim;
+};
+
+void prepare(Probe &p, unsigned long long due) noexcept {
+	p = Probe { };
+	p.deadline.owner = &p;
+	p.due = due;
+}
+
+//Every probe was delivered once, at the expected tick
+bool delivered(const Probe *probes, unsigned int count) noexcept {
+	for (unsigned int i = 0; i < count; ++i) {
+		if (probes[i].count != 1 || probes[i].fired != probes[i].due) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace
+
+namespace wanhive {
+
+TimerWheelTest::TimerWheelTest() noexcept {
+
+}
+
+TimerWheelTest::~TimerWheelTest() {
+
+}
+
+void TimerWheelTest::execute() noexcept {
+	bool ok = scheduling();
+	ok &= cancellation();
+	ok &= cascading();
+	ok &= wrapping();
+	printf("\nTimer wheel: %s\n", ok ? "PASSED" : "FAILED");
+}
+
+bool TimerWheelTest::scheduling() noexcept {
+	TimerWheel wheel;
+	Probe p[3];
+	bool ok = true;
+
+	prepare(p[0], 1);
+	wheel.schedule(p[0].deadline, 0);
+	ok &= check("schedule: zero ticks rounded up to one",
+			TimerWheel::scheduled(p[0].deadline) && wheel.size() == 1
+					&& expires(wheel, 1) && delivered(p, 1));
+	ok &= check("schedule: delivered entry is unscheduled",
+			!TimerWheel::scheduled(p[0].deadline) && wheel.size() == 0);
+
+	prepare(p[0], wheel.now() + 10);
+	wheel.schedule(p[0].deadline, 100);
+	wheel.schedule(p[0].deadline, 10);
+	ok &= check("schedule: rescheduled entry moves",
+			wheel.size() == 1 && expires(wheel, 200) && delivered(p, 1));
+
+	prepare(p[0], 0);
+	wheel.schedule(p[0].deadline, TimerWheel::RANGE + 100);
+	ok &= check("schedule: expiration capped at the range",
+			p[0].deadline.expiry == (wheel.now() + TimerWheel::RANGE));
+	wheel.cancel(p[0].deadline);
+
+	//Periodic entry reschedules itself from the callback
+	prepare(p[0], 0);
+	p[0].period = 7;
+	wheel.schedule(p[0].deadline, 7);
+	expires(wheel, 70);
+	ok &= check("schedule: callback reschedules the entry",
+			p[0].count == 10 && TimerWheel::scheduled(p[0].deadline)
+					&& p[0].fired == (wheel.now()));
+	wheel.cancel(p[0].deadline);
+
+	//Same expiration tick
+	auto now = wheel.now();
+	for (auto &probe : p) {
+		prepare(probe, now + 5);
+		wheel.schedule(probe.deadline, 5);
+	}
+	ok &= check("schedule: entries sharing a slot delivered together",
+			wheel.size() == 3 && wheel.advance(4, nullptr, nullptr) == 0
+					&& wheel.advance(1, expire, &wheel) == 3
+					&& delivered(p, 3));
+	return ok;
+}
+
+bool TimerWheelTest::cancellation() noexcept {
+	TimerWheel wheel;
+	Probe p[3];
+	bool ok = true;
+
+	prepare(p[0], 0);
+	prepare(p[1], 20);
+	wheel.schedule(p[0].deadline, 10);
+	wheel.schedule(p[1].deadline, 20);
+	wheel.cancel(p[0].deadline);
+	ok &= check("cancel: entry unscheduled",
+			!TimerWheel::scheduled(p[0].deadline) && wheel.size() == 1);
+	wheel.cancel(p[0].deadline);
+	ok &= check("cancel: cancelling twice is a no-op", wheel.size() == 1);
+	expires(wheel, 30);
+	ok &= check("cancel: cancelled entry not delivered",
+			p[0].count == 0 && delivered(p + 1, 1));
+
+	//The first delivery cancels the second one (same tick)
+	auto now = wheel.now();
+	prepare(p[0], now + 3);
+	prepare(p[1], 0);
+	p[0].victim = &p[1].deadline;
+	wheel.schedule(p[0].deadline, 3);
+	wheel.schedule(p[1].deadline, 3);
+	ok &= check("cancel: callback cancels an expired entry",
+			wheel.advance(3, expire, &wheel) == 1 && delivered(p, 1)
+					&& p[1].count == 0 && wheel.size() == 0);
+
+	for (unsigned int i = 0; i < 3; ++i) {
+		prepare(p[i], 0);
+		wheel.schedule(p[i].deadline, 1 + i * 5000);
+	}
+	wheel.clear();
+	ok &= check("cancel: clear drops everything",
+			wheel.size() == 0 && !TimerWheel::scheduled(p[2].deadline)
+					&& wheel.advance(20000, expire, &wheel) == 0);
+	return ok;
+}
+
+bool TimerWheelTest::cascading() noexcept {
+	//Both sides of every level's boundary, from an unaligned clock
+	const unsigned long long deltas[] = { 1, 2, 63, 64, 65, 127, 128, 129,
+			4095, 4096, 4097, 4159, 262143, 262144, 262145, 266241, 1000003,
+			TimerWheel::RANGE - 1, TimerWheel::RANGE };
+	constexpr unsigned int COUNT = sizeof(deltas) / sizeof(deltas[0]);
+
+	TimerWheel wheel;
+	Probe p[COUNT];
+	wheel.advance(37, nullptr, nullptr);
+	for (unsigned int i = 0; i < COUNT; ++i) {
+		prepare(p[i], wheel.now() + deltas[i]);
+		wheel.schedule(p[i].deadline, deltas[i]);
+	}
+
+	auto ok = expires(wheel, TimerWheel::RANGE + 1) && delivered(p, COUNT);
+	return check("cascade: delivered at the exact tick", ok)
+			&& check("cascade: nothing left", wheel.size() == 0);
+}
+
+bool TimerWheelTest::wrapping() noexcept {
+	const unsigned long long deltas[] = { 1, 50, 100, 150, 5000, 300000,
+			TimerWheel::RANGE };
+	constexpr unsigned int COUNT = sizeof(deltas) / sizeof(deltas[0]);
+	//Just before the wheel's and the 32-bit rollovers
+	const unsigned long long starts[] = { TimerWheel::RANGE - 99,
+			(1ULL << 32) - 100 };
+
+	bool ok = true;
+	for (auto start : starts) {
+		TimerWheel wheel;
+		Probe p[COUNT];
+		//Empty wheel's clock jumps ahead
+		wheel.advance(start, nullptr, nullptr);
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			prepare(p[i], wheel.now() + deltas[i]);
+			wheel.schedule(p[i].deadline, deltas[i]);
+		}
+
+		char what[64];
+		snprintf(what, sizeof(what), "wrap-around: rollover at %llu",
+				start + 100);
+		ok &= check(what, wheel.now() == start
+				&& expires(wheel, TimerWheel::RANGE + 1) && delivered(p, COUNT)
+				&& wheel.size() == 0);
+	}
+	return ok;
+}
+
+bool TimerWheelTest::expires(TimerWheel &wheel,
+		unsigned long long ticks) noexcept {
+	while (ticks--) { //postfix --
+		wheel.advance(1, expire, &wheel);
+	}
+	return true;
+}
+
+void TimerWheelTest::expire(Deadline *d, void *arg) noexcept {
+	auto wheel = static_cast<TimerWheel*>(arg);
+	auto p = static_cast<Probe*>(d->owner);
+	p->fired = wheel->now();
+	p->count += 1;
+	if (p->victim) {
+		wheel->cancel(*p->victim);
+	}
+
+	if (p->period) {
+		wheel->schedule(*d, p->period);
+	}
+}
+
+bool TimerWheelTest::check(const char *what, bool ok) noexcept {
+	printf("%-52s %s\n", what, ok ? "OK" : "FAILED");
+	return ok;
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,38 @@
+/*
+ * TimerWheelTest.h
+ *
+ * Timing wheel test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_DS_TIMERWHEELTEST_H_
+#define WH_TEST_DS_TIMERWHEELTEST_H_
+#include "../../base/ds/TimerWheel.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+
+class TimerWheelTest {
+public:
+	TimerWheelTest() noexcept;
+	~TimerWheelTest();
+	void execute() noexcept;
+private:
+	bool scheduling() noexcept;
+	bool cancellation() noexcept;
+	bool cascading() noexcept;
+	bool wrapping() noexcept;
+	//Advances the clock one tick at a time, checks the expiration ticks
+	static bool expires(TimerWheel &wheel, unsigned long long ticks) noexcept;
+	static void expire(Deadline *d, void *arg) noexcept;
+	static bool check(const char *what, bool ok) noexcept;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_DS_TIMERWHEELTEST_H_ */
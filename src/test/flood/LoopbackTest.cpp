@@ -0,0 +1,521 @@
+/*
+ * LoopbackTest.cpp
+ *
+ * Loopback throughput and latency benchmark of the overlay hub
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "LoopbackTest.h"
+#include "../../base/Options.h"
+#include "../../base/Signal.h"
+#include "../../base/Thread.h"
+#include "../../base/common/Atomic.h"
+#include "../../base/common/Exception.h"
+#include "../../base/common/Logger.h"
+#include "../../base/ds/Serializer.h"
+#include "../../base/unix/Time.h"
+#include "../../hub/Protocol.h"
+#include "../../util/commands.h"
+#include "../../server/core/Node.h"
+#include "../../server/core/OverlayHub.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sched.h>
+#include <strings.h>
+#include <unistd.h>
+
+namespace {
+
+enum Pattern : unsigned int {
+	PATTERN_ECHO, //Every client sends to itself
+	PATTERN_PAIRS, //Clients send to each other in pairs
+	PATTERN_FANOUT //The first client publishes to all the others
+};
+
+const char *patternNames[] = { "echo", "pairs", "fanout" };
+
+constexpr uint64_t HUB_ID = 1;
+//Client identifiers fall outside the overlay's key space
+constexpr uint64_t CLIENT_ID = wanhive::Node::MAX_ID + 1;
+constexpr unsigned int TOPIC = 1;
+//Receive timeout in milliseconds (ends the final drain)
+constexpr int RECEIVE_TIMEOUT = 500;
+//Hub's startup time limit in milliseconds
+constexpr unsigned int STARTUP_TIME = 5000;
+
+using Tally = wanhive::Atomic<unsigned long long>;
+using Flag = wanhive::Atomic<unsigned int>;
+
+//Current time in nanoseconds (monotonic clock), stamps the messages
+unsigned long long nanotime() noexcept {
+	timespec ts;
+	if (wanhive::Time::now(CLOCK_MONOTONIC, ts)) {
+		return wanhive::Time::nanoseconds(ts);
+	} else {
+		return 0;
+	}
+}
+
+void pause(unsigned long long microseconds) noexcept {
+	timespec ts;
+	ts.tv_sec = microseconds / 1000000;
+	ts.tv_nsec = (microseconds % 1000000) * 1000;
+	nanosleep(&ts, nullptr);
+}
+
+//Runs the hub in its own thread
+class Server final: public wanhive::Task {
+public:
+	Server(wanhive::Hub *hub) noexcept :
+			hub(hub) {
+
+	}
+
+	void run(void *arg) noexcept override {
+		hub->execute(nullptr);
+	}
+
+	int getStatus() const noexcept override {
+		return 0;
+	}
+
+	void setStatus(int status) noexcept override {
+
+	}
+private:
+	wanhive::Hub *hub;
+};
+
+struct Control {
+	unsigned int size;
+	unsigned int rate;
+	unsigned int window;
+	unsigned int go;
+	unsigned int stop;
+	unsigned int drain;
+};
+
+//A client connection, sends and receives from two different threads
+class Client final: public wanhive::Protocol, public wanhive::Task {
+public:
+	Client(uint64_t id, const Control &control) noexcept :
+			id(id), control(control) {
+
+	}
+
+	void join(const char *path) {
+		wanhive::NameInfo ni { };
+		strncpy(ni.host, path, sizeof(ni.host) - 1);
+		strncpy(ni.service, "unix", sizeof(ni.service) - 1);
+		auto deadline = wanhive::Time::microseconds(CLOCK_MONOTONIC)
+				+ (STARTUP_TIME * 1000ULL);
+		while (true) {
+			try {
+				connect(ni, 1000);
+				break;
+			} catch (const wanhive::BaseException &e) {
+				if (wanhive::Time::microseconds(CLOCK_MONOTONIC) > deadline) {
+					throw;
+				}
+				pause(10000);
+			}
+		}
+
+		if (!registerRequest( { id, HUB_ID }, nullptr)) {
+			throw wanhive::Exception(wanhive::EX_OPERATION);
+		}
+		setSource(id);
+	}
+
+	void subscribe() {
+		if (!subscribeRequest(HUB_ID, TOPIC)) {
+			throw wanhive::Exception(wanhive::EX_OPERATION);
+		}
+	}
+
+	void start() {
+		setSocketTimeout(RECEIVE_TIMEOUT, 0);
+		receiver = new wanhive::Thread(*this);
+		if (sender) {
+			transmitter = new wanhive::Thread(*this, this);
+		}
+	}
+
+	void halt() noexcept {
+		if (transmitter) {
+			transmitter->join();
+			delete transmitter;
+			transmitter = nullptr;
+		}
+	}
+
+	void finish() noexcept {
+		if (receiver) {
+			receiver->join();
+			delete receiver;
+			receiver = nullptr;
+		}
+	}
+
+	//Number of messages sent by this client and delivered to the receivers
+	unsigned long long delivered() const noexcept {
+		if (!peers) {
+			return 0;
+		}
+
+		unsigned long long total = 0;
+		for (unsigned int i = 0; i < nPeers; ++i) {
+			total += Tally::load(&peers[i]->received, wanhive::MO_ACQUIRE);
+		}
+		return total / nPeers;
+	}
+
+	void run(void *arg) noexcept override {
+		if (arg) {
+			send();
+		} else {
+			receive();
+		}
+	}
+
+	int getStatus() const noexcept override {
+		return 0;
+	}
+
+	void setStatus(int status) noexcept override {
+
+	}
+private:
+	void send() noexcept {
+		wanhive::Packet out { id };
+		memset(out.buffer(), 0, MTU);
+		out.header().setAddress(id, destination);
+		if (fanout) {
+			out.header().setControl(control.size, 0, TOPIC);
+			out.header().setContext(wanhive::WH_CMD_MULTICAST,
+					wanhive::WH_QLF_PUBLISH, wanhive::WH_AQLF_REQUEST);
+		} else {
+			out.header().setControl(control.size, 0, 0);
+			out.header().setContext(0, 0, 0);
+		}
+		out.packHeader();
+
+		while (!Flag::load(&control.go, wanhive::MO_ACQUIRE)) {
+			pause(100);
+		}
+
+		auto interval = control.rate ? (1000000ULL / control.rate) : 0;
+		auto next = wanhive::Time::microseconds(CLOCK_MONOTONIC);
+		auto sfd = getSocket();
+		try {
+			while (!Flag::load(&control.stop, wanhive::MO_ACQUIRE)) {
+				if (control.window && (sent - delivered()) >= control.window) {
+					sched_yield();
+					continue;
+				}
+
+				if (interval) {
+					auto now = wanhive::Time::microseconds(CLOCK_MONOTONIC);
+					if (now < next) {
+						pause(next - now);
+						continue;
+					}
+					next += interval;
+				}
+
+				wanhive::Serializer::packi64(out.payload(), nanotime());
+				Endpoint::send(sfd, out);
+				Tally::store(&sent, sent + 1, wanhive::MO_RELEASE);
+			}
+		} catch (const wanhive::BaseException &e) {
+			WH_LOG_EXCEPTION(e);
+		}
+	}
+
+	void receive() noexcept {
+		wanhive::Packet in;
+		auto sfd = getSocket();
+		while (true) {
+			if (Flag::load(&control.drain, wanhive::MO_ACQUIRE)
+					&& received >= Tally::load(&expected)) {
+				break;
+			}
+
+			try {
+				Endpoint::receive(sfd, in);
+			} catch (const wanhive::BaseException &e) {
+				if (Flag::load(&control.drain, wanhive::MO_ACQUIRE)) {
+					break;
+				} else {
+					continue;
+				}
+			}
+
+			auto now = nanotime();
+			if (in.getPayloadLength() >= sizeof(uint64_t)) {
+				auto stamp = wanhive::Serializer::unpacku64(in.payload());
+				latency.record(now > stamp ? (now - stamp) : 0);
+			}
+			bytes += in.header().getLength();
+			last = now / 1000;
+			Tally::store(&received, received + 1, wanhive::MO_RELEASE);
+		}
+	}
+public:
+	const uint64_t id;
+	uint64_t destination { };
+	bool sender { };
+	bool fanout { };
+	Client **peers { }; //Receivers of this client's messages
+	unsigned int nPeers { };
+	//-----------------------------------------------------------------
+	unsigned long long sent { };
+	unsigned long long received { };
+	unsigned long long expected { };
+	unsigned long long bytes { };
+	unsigned long long last { };
+	wanhive::Histogram latency; //In nanoseconds
+private:
+	const Control &control;
+	wanhive::Thread *receiver { };
+	wanhive::Thread *transmitter { };
+};
+
+}  // namespace
+
+namespace wanhive {
+
+LoopbackTest::LoopbackTest(const char *path) noexcept :
+		path(path) {
+	memset(&ctx, 0, sizeof(ctx));
+	memset(&files, 0, sizeof(files));
+	results.sent = 0;
+	results.received = 0;
+	results.bytes = 0;
+	results.elapsed = 0;
+}
+
+LoopbackTest::~LoopbackTest() {
+	cleanup();
+}
+
+bool LoopbackTest::execute() noexcept {
+	try {
+		configure();
+		prepare();
+		run();
+		cleanup();
+		report();
+		return true;
+	} catch (const BaseException &e) {
+		WH_LOG_EXCEPTION(e);
+		cleanup();
+		return false;
+	}
+}
+
+void LoopbackTest::configure() {
+	Options conf;
+	if (path && !conf.load(path)) {
+		throw Exception(EX_RESOURCE);
+	}
+
+	ctx.clients = conf.getNumber("BENCHMARK", "clients", 4);
+	ctx.clients = (ctx.clients < 2) ? 2 : ctx.clients;
+	ctx.clients = (ctx.clients > 1024) ? 1024 : ctx.clients;
+	ctx.size = conf.getNumber("BENCHMARK", "size", 64);
+	ctx.size = (ctx.size < (Packet::HEADER_SIZE + sizeof(uint64_t))) ?
+			(Packet::HEADER_SIZE + sizeof(uint64_t)) : ctx.size;
+	ctx.size = (ctx.size > Packet::MTU) ? Packet::MTU : ctx.size;
+	ctx.rate = conf.getNumber("BENCHMARK", "rate", 0);
+	ctx.window = conf.getNumber("BENCHMARK", "window", 64);
+	ctx.duration = conf.getNumber("BENCHMARK", "duration", 5);
+	ctx.duration = ctx.duration ? ctx.duration : 1;
+
+	auto pattern = conf.getString("BENCHMARK", "pattern", "pairs");
+	ctx.pattern = PATTERN_PAIRS;
+	for (unsigned int i = 0; i < 3; ++i) {
+		if (!strcasecmp(pattern, patternNames[i])) {
+			ctx.pattern = i;
+			break;
+		}
+	}
+}
+
+void LoopbackTest::prepare() {
+	strcpy(files.directory, "/tmp/wanhive-benchmark-XXXXXX");
+	if (!mkdtemp(files.directory)) {
+		files.directory[0] = '\0';
+		throw Exception(EX_RESOURCE);
+	}
+	snprintf(files.config, sizeof(files.config), "%s/wanhive.conf",
+			files.directory);
+	snprintf(files.socket, sizeof(files.socket), "%s/hub.sock",
+			files.directory);
+
+	//Every client might fill up its window, the hub must not run out
+	auto messages = ctx.clients * (ctx.window ? ctx.window : 256) * 4 + 4096;
+	Options conf;
+	conf.setBoolean("HUB", "listen", true);
+	conf.setString("HUB", "name", files.socket);
+	conf.setString("HUB", "type", "unix");
+	conf.setNumber("HUB", "connections", ctx.clients + 16);
+	conf.setNumber("HUB", "messages", messages);
+	conf.setNumber("HUB", "guests", ctx.clients + 16);
+	conf.setNumber("HUB", "lease", 5000);
+	conf.setNumber("HUB", "inward", 16);
+	conf.setNumber("HUB", "outward", 512);
+	conf.setBoolean("HUB", "regulate", false);
+	conf.setNumber("HUB", "TTL", 64);
+	conf.setNumber("HUB", "expiration", 100);
+	conf.setNumber("HUB", "interval", 1000);
+	conf.setNumber("HUB", "logging", WH_LOGLEVEL_WARNING);
+	conf.setBoolean("OVERLAY", "enroll", true);
+	conf.setBoolean("OVERLAY", "authenticate", false);
+	if (!conf.store(files.config)) {
+		throw Exception(EX_RESOURCE);
+	}
+}
+
+void LoopbackTest::run() {
+	Control control { ctx.size, ctx.rate, ctx.window, 0, 0, 0 };
+	auto clients = new Client*[ctx.clients] { };
+	auto hub = new OverlayHub(HUB_ID, files.config);
+	Server server(hub);
+	Thread *thread = nullptr;
+	Signal::ignore(SIGPIPE);
+
+	try {
+		thread = new Thread(server);
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			clients[i] = new Client(CLIENT_ID + i, control);
+			clients[i]->join(files.socket);
+		}
+
+		//Set up the traffic pattern
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			auto c = clients[i];
+			if (ctx.pattern == PATTERN_FANOUT) {
+				c->sender = (i == 0);
+				c->fanout = true;
+				c->destination = HUB_ID;
+				if (i == 0) {
+					c->peers = clients + 1;
+					c->nPeers = ctx.clients - 1;
+				} else {
+					c->subscribe();
+				}
+			} else {
+				auto peer = i;
+				if (ctx.pattern == PATTERN_PAIRS && (i ^ 1) < ctx.clients) {
+					peer = i ^ 1;
+				}
+				c->sender = true;
+				c->destination = clients[peer]->id;
+				c->peers = &clients[peer];
+				c->nPeers = 1;
+			}
+		}
+
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			clients[i]->start();
+		}
+
+		//Measure
+		auto start = Time::microseconds(CLOCK_MONOTONIC);
+		Flag::store(&control.go, 1, MO_RELEASE);
+		pause(ctx.duration * 1000000ULL);
+		Flag::store(&control.stop, 1, MO_RELEASE);
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			clients[i]->halt();
+		}
+
+		//Drain
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			auto c = clients[i];
+			for (unsigned int j = 0; j < c->nPeers; ++j) {
+				Tally::store(&c->peers[j]->expected, c->sent);
+			}
+		}
+		Flag::store(&control.drain, 1, MO_RELEASE);
+		unsigned long long finish = start;
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			auto c = clients[i];
+			c->finish();
+			results.sent += (c->sent * c->nPeers);
+			results.received += c->received;
+			results.bytes += c->bytes;
+			results.latency.merge(c->latency);
+			finish = (c->last > finish) ? c->last : finish;
+		}
+		results.elapsed = (finish - start) / 1000000.0;
+	} catch (const BaseException &e) {
+		Flag::store(&control.stop, 1, MO_RELEASE);
+		Flag::store(&control.drain, 1, MO_RELEASE);
+		for (unsigned int i = 0; i < ctx.clients; ++i) {
+			if (clients[i]) {
+				clients[i]->halt();
+				clients[i]->finish();
+			}
+		}
+		WH_LOG_EXCEPTION(e);
+	}
+
+	for (unsigned int i = 0; i < ctx.clients; ++i) {
+		delete clients[i];
+	}
+	delete[] clients;
+
+	if (thread) {
+		hub->cancel();
+		thread->join();
+		delete thread;
+	}
+	delete hub;
+	Signal::reset(SIGPIPE);
+
+	if (!results.sent) {
+		throw Exception(EX_OPERATION);
+	}
+}
+
+void LoopbackTest::report() const noexcept {
+	//Latency is recorded in nanoseconds and reported in microseconds
+	auto &l = results.latency;
+	auto us = [](double ns) -> double {
+		return ns / 1000;
+	};
+	auto elapsed = results.elapsed > 0 ? results.elapsed : 1;
+	auto lost = (results.sent > results.received) ?
+			(results.sent - results.received) : 0;
+	printf("{\"pattern\": \"%s\", \"clients\": %u, \"size\": %u, "
+			"\"rate\": %u, \"window\": %u, \"elapsed\": %.3f, "
+			"\"sent\": %llu, \"received\": %llu, \"lost\": %llu, "
+			"\"msgs_per_sec\": %.1f, \"bytes_per_sec\": %.1f, "
+			"\"latency_us\": {\"min\": %.2f, \"mean\": %.2f, \"p50\": %.2f, "
+			"\"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}}\n",
+			patternNames[ctx.pattern], ctx.clients, ctx.size, ctx.rate,
+			ctx.window, results.elapsed, results.sent, results.received, lost,
+			results.received / elapsed, results.bytes / elapsed, us(l.min()),
+			us(l.mean()), us(l.percentile(50)), us(l.percentile(99)),
+			us(l.percentile(99.9)), us(l.max()));
+	fflush(stdout);
+}
+
+void LoopbackTest::cleanup() noexcept {
+	if (files.directory[0]) {
+		unlink(files.socket);
+		unlink(files.config);
+		rmdir(files.directory);
+		files.directory[0] = '\0';
+	}
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,62 @@
+/*
+ * LoopbackTest.h
+ *
+ * Loopback throughput and latency benchmark of the overlay hub
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_FLOOD_LOOPBACKTEST_H_
+#define WH_TEST_FLOOD_LOOPBACKTEST_H_
+#include "../../base/ds/Histogram.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Non-interactive benchmark: launches an overlay hub in-process on a Unix
+ * domain socket, drives it with concurrent client connections and prints the
+ * results as a single line of JSON to the standard output. The parameters are
+ * read from the [BENCHMARK] section of the configuration file.
+ */
+class LoopbackTest {
+public:
+	LoopbackTest(const char *path) noexcept;
+	~LoopbackTest();
+	bool execute() noexcept;
+private:
+	void configure();
+	void prepare();
+	void run();
+	void report() const noexcept;
+	void cleanup() noexcept;
+private:
+	const char *path;
+	struct {
+		unsigned int clients;
+		unsigned int size;
+		unsigned int rate;
+		unsigned int window;
+		unsigned int duration;
+		unsigned int pattern;
+	} ctx;
+	struct {
+		char directory[64];
+		char config[128];
+		char socket[128];
+	} files;
+	struct {
+		unsigned long long sent;
+		unsigned long long received;
+		unsigned long long bytes;
+		double elapsed;
+		Histogram latency;
+	} results;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_FLOOD_LOOPBACKTEST_H_ */
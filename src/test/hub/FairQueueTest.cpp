@@ -0,0 +1,185 @@
+/*
+ * FairQueueTest.cpp
+ *
+ * Fair queue test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "FairQueueTest.h"
+#include "../../base/common/Exception.h"
+#include <cstdio>
+
+namespace {
+
+//Sets the messages' lengths
+void resize(wanhive::Message **messages, unsigned int count,
+		unsigned int length) noexcept {
+	for (unsigned int i = 0; i < count; ++i) {
+		messages[i]->setLength(length);
+	}
+}
+
+}  // namespace
+
+namespace wanhive {
+
+FairQueueTest::FairQueueTest() noexcept :
+		messages { } {
+
+}
+
+FairQueueTest::~FairQueueTest() {
+
+}
+
+void FairQueueTest::execute() noexcept {
+	try {
+		Message::initPool(MESSAGES);
+		for (auto &m : messages) {
+			if (!(m = Message::create())) {
+				throw Exception(EX_MEMORY);
+			}
+		}
+
+		bool ok = basics();
+		ok &= priority();
+		ok &= fairness();
+		ok &= persistence();
+		printf("\nFair queue: %s\n", ok ? "PASSED" : "FAILED");
+	} catch (const BaseException &e) {
+		printf("\nFair queue: FAILED (%s)\n", e.what());
+	}
+
+	for (auto &m : messages) {
+		Message::recycle(m);
+		m = nullptr;
+	}
+	Message::destroyPool();
+}
+
+bool FairQueueTest::basics() noexcept {
+	FairQueue queue;
+	Message *m = nullptr;
+	bool ok = true;
+	resize(messages, 8, 256);
+
+	ok &= check("basics: zero capacity rejects everything",
+			!queue.put(messages[0], 0, 1) && queue.isEmpty() && !queue.get(m));
+	queue.initialize(4);
+	ok &= check("basics: invalid input rejected",
+			!queue.put(nullptr, 0, 1)
+					&& !queue.put(messages[0], FairQueue::CLASSES, 1)
+					&& queue.isEmpty() && queue.capacity() == 4);
+	for (unsigned int i = 0; i < 4; ++i) {
+		queue.put(messages[i], 2, 1);
+	}
+	ok &= check("basics: full queue rejects",
+			queue.readSpace() == 4 && !queue.put(messages[4], 2, 2));
+	ok &= check("basics: flow served in order",
+			drains(queue, messages, 4) && queue.isEmpty() && !queue.get(m));
+	return ok;
+}
+
+bool FairQueueTest::priority() noexcept {
+	FairQueue queue;
+	resize(messages, 6, 256);
+	queue.initialize(8);
+
+	//Flow 1 exists in every class
+	queue.put(messages[0], 2, 1);
+	queue.put(messages[1], 1, 1);
+	queue.put(messages[2], 0, 1);
+	queue.put(messages[3], 2, 1);
+	queue.put(messages[4], 1, 2);
+	queue.put(messages[5], 0, 3);
+	Message *expected[] = { messages[2], messages[5], messages[1], messages[4],
+			messages[0], messages[3] };
+	return check("priority: classes served in strict order",
+			drains(queue, expected, 6) && queue.isEmpty());
+}
+
+bool FairQueueTest::fairness() noexcept {
+	FairQueue queue;
+	queue.initialize(16);
+	//Flow 1 sends full-sized messages, flow 2 sends quarter-sized ones
+	resize(messages, 3, Message::MTU);
+	resize(messages + 3, 8, Message::MTU / 4);
+	for (unsigned int i = 0; i < 11; ++i) {
+		queue.put(messages[i], 2, (i < 3) ? 1 : 2);
+	}
+
+	Message *expected[] = { messages[0], messages[3], messages[4], messages[5],
+			messages[6], messages[1], messages[7], messages[8], messages[9],
+			messages[10], messages[2] };
+	return check("fairness: flows share the bytes equally",
+			drains(queue, expected, 11) && queue.isEmpty());
+}
+
+bool FairQueueTest::persistence() noexcept {
+	FairQueue queue;
+	bool ok = true;
+	resize(messages, 12, 256);
+	queue.initialize(12);
+
+	//The round continues after a partial drain
+	for (unsigned int i = 0; i < 8; ++i) {
+		queue.put(messages[i], 2, (i < 4) ? 1 : 2);
+	}
+	auto partial = drains(queue, messages, 2);
+	for (unsigned int i = 8; i < 12; ++i) {
+		queue.put(messages[i], 2, 3);
+	}
+	ok &= check("persistence: round continues across the turns",
+			partial && drains(queue, messages + 2, 10) && queue.isEmpty());
+
+	//Far more flows than the capacity, the idle flows make room
+	queue.initialize(4);
+	bool recycled = true;
+	Message *expected[] = { messages[0], messages[2], messages[1] };
+	for (unsigned long long turn = 0; recycled && turn < 100; ++turn) {
+		queue.put(messages[0], 2, turn << 1);
+		queue.put(messages[1], 2, (turn << 1) + 1);
+		queue.put(messages[2], 2, turn << 1);
+		recycled = drains(queue, expected, 3) && queue.isEmpty();
+	}
+	ok &= check("persistence: idle flows recycled", recycled);
+
+	//The queue never becomes empty
+	bool rolling = queue.put(messages[0], 2, 0);
+	for (unsigned int turn = 1; rolling && turn <= 100; ++turn) {
+		rolling = queue.put(messages[turn & 1], 2, turn)
+				&& drains(queue, messages + ((turn - 1) & 1), 1);
+	}
+	ok &= check("persistence: slots and flows reused while busy",
+			rolling && drains(queue, messages, 1) && queue.isEmpty());
+
+	//Evicted flow comes back
+	queue.put(messages[0], 2, 0);
+	queue.put(messages[1], 2, 198);
+	ok &= check("persistence: evicted flow restored",
+			drains(queue, messages, 2) && queue.isEmpty());
+	return ok;
+}
+
+bool FairQueueTest::drains(FairQueue &queue, Message *const *expected,
+		unsigned int count) noexcept {
+	for (unsigned int i = 0; i < count; ++i) {
+		Message *m = nullptr;
+		if (!queue.get(m) || m != expected[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FairQueueTest::check(const char *what, bool ok) noexcept {
+	printf("%-52s %s\n", what, ok ? "OK" : "FAILED");
+	return ok;
+}
+
+} /* namespace wanhive */
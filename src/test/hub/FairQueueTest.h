@@ -0,0 +1,41 @@
+/*
+ * FairQueueTest.h
+ *
+ * Fair queue test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_HUB_FAIRQUEUETEST_H_
+#define WH_TEST_HUB_FAIRQUEUETEST_H_
+#include "../../hub/FairQueue.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+
+class FairQueueTest {
+public:
+	FairQueueTest() noexcept;
+	~FairQueueTest();
+	void execute() noexcept;
+private:
+	bool basics() noexcept;
+	bool priority() noexcept;
+	bool fairness() noexcept;
+	bool persistence() noexcept;
+	//Removes the given messages in the given order
+	static bool drains(FairQueue &queue, Message *const *expected,
+			unsigned int count) noexcept;
+	static bool check(const char *what, bool ok) noexcept;
+private:
+	static constexpr unsigned int MESSAGES = 32;
+	Message *messages[MESSAGES];
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_HUB_FAIRQUEUETEST_H_ */
@@ -0,0 +1,239 @@
+/*
+ * FanoutTest.cpp
+ *
+ * Multicast fan-out benchmark
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "FanoutTest.h"
+#include "../../base/Network.h"
+#include "../../base/Timer.h"
+#include "../../base/common/Exception.h"
+#include "../../base/unix/Process.h"
+#include "../../base/unix/SystemException.h"
+#include "../../server/core/Topics.h"
+#include "../../util/Message.h"
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+
+//Publish cycles between the drains of the outgoing queues
+constexpr unsigned int DRAIN_CYCLE = (wanhive::Socket::OUT_QUEUE_SIZE >> 1);
+//Subscribers handed over to the bulk enqueue at once
+constexpr unsigned int BATCH = 64;
+//Measured delivery methods
+constexpr unsigned int MODES = 3;
+const char *MODE_NAMES[MODES] = { "indexed", "list   ", "bulk   " };
+
+}  // namespace
+
+namespace wanhive {
+
+FanoutTest::FanoutTest(unsigned int deliveries) noexcept :
+		deliveries(deliveries) {
+
+}
+
+FanoutTest::~FanoutTest() {
+
+}
+
+void FanoutTest::execute() noexcept {
+	unsigned int sizes[] = { 1, 100, 10000 };
+	try {
+		Message::initPool(1);
+		Socket::initPool(10000);
+		for (auto size : sizes) {
+			test(size);
+		}
+	} catch (const BaseException &e) {
+		printf("Benchmark failed: %s\n", e.what());
+	}
+	Socket::destroyPool();
+	Message::destroyPool();
+}
+
+void FanoutTest::test(unsigned int subscribers) {
+	Topics topics;
+	auto sockets = new Socket*[subscribers] { };
+	auto peers = new int[subscribers];
+	auto pairs = channels(subscribers);
+	auto ends = new int[pairs];
+	auto msg = Message::create(0);
+	try {
+		for (unsigned int i = 0; i < subscribers; ++i) {
+			int fd = -1;
+			if (i < pairs) {
+				int sv[2];
+				Network::socketPair(sv, false);
+				fd = ends[i] = sv[0];
+				peers[i] = sv[1];
+			} else if ((fd = ::dup(ends[i % pairs])) != -1) {
+				//Short of descriptors, share a socket pair
+				peers[i] = peers[i % pairs];
+			} else {
+				throw SystemException();
+			}
+			sockets[i] = new Socket(fd);
+			sockets[i]->setFlags(SOCKET_LOCAL);
+			sockets[i]->setType(SOCKET_PROXY);
+			sockets[i]->setUid(i + 1);
+			topics.put(0, sockets[i]);
+		}
+
+		if (!msg) {
+			throw Exception(EX_MEMORY);
+		}
+		msg->putLength(Message::HEADER_SIZE);
+		msg->link(); //Keep it alive
+
+		auto cycles = (deliveries / subscribers) ? (deliveries / subscribers) : 1;
+		unsigned long long delivered[MODES] = { };
+		double elapsed[MODES] = { };
+		for (unsigned int mode = 0; mode < MODES; ++mode) {
+			Timer t;
+			for (unsigned int cycle = 0; cycle < cycles; ++cycle) {
+				if (mode == 0) {
+					//Indexed traversal
+					Watcher *sub = nullptr;
+					unsigned int index = 0;
+					while ((sub = topics.get(0, index++))) {
+						if (sub->getUid() != msg->getOrigin()
+								&& !sub->testGroup(msg->getGroup())
+								&& sub->publish(msg)) {
+							++delivered[mode];
+						}
+					}
+				} else if (mode == 1) {
+					//List traversal, one subscriber at a time
+					auto origin = msg->getOrigin();
+					auto group = msg->getGroup();
+					unsigned int count = 0;
+					auto subs = topics.list(0, count);
+					for (unsigned int index = 0; index < count; ++index) {
+						if ((index + Topics::PREFETCH_DISTANCE) < count) {
+							__builtin_prefetch(
+									subs[index + Topics::PREFETCH_DISTANCE]);
+						}
+
+						auto sub = subs[index];
+						if (sub->getUid() != origin && !sub->testGroup(group)
+								&& sub->publish(msg)) {
+							++delivered[mode];
+						}
+					}
+				} else {
+					//Bulk enqueue (see OverlayHub::handlePublishRequest)
+					auto origin = msg->getOrigin();
+					auto group = msg->getGroup();
+					unsigned int count = 0;
+					auto subs = topics.list(0, count);
+					Socket *batch[BATCH];
+					unsigned int selected = 0;
+					for (unsigned int index = 0; index < count; ++index) {
+						if ((index + Topics::PREFETCH_DISTANCE) < count) {
+							__builtin_prefetch(
+									subs[index + Topics::PREFETCH_DISTANCE]);
+						}
+
+						auto sub = subs[index];
+						if (sub->getUid() != origin && !sub->testGroup(group)) {
+							batch[selected++] = static_cast<Socket*>(sub);
+						}
+
+						if (selected == BATCH
+								|| (selected && index + 1 == count)) {
+							delivered[mode] += Socket::publish(msg, batch,
+									selected);
+							selected = 0;
+						}
+					}
+				}
+
+				if ((cycle % DRAIN_CYCLE) == (DRAIN_CYCLE - 1)) {
+					//Exclude the network IO from the measurement
+					elapsed[mode] += t.elapsed();
+					drain(sockets, peers, subscribers);
+					t.now();
+				}
+			}
+			elapsed[mode] += t.elapsed();
+			drain(sockets, peers, subscribers);
+		}
+
+		printf("Subscribers: %u, socket pairs: %u, publishes: %u\n",
+				subscribers, pairs, cycles);
+		for (unsigned int mode = 0; mode < MODES; ++mode) {
+			printf("\t%s: %.0lf publishes/sec, %.2lf ns/delivery "
+					"(%llu deliveries)\n", MODE_NAMES[mode],
+					cycles / elapsed[mode],
+					(elapsed[mode] * 1000000000) / delivered[mode],
+					delivered[mode]);
+		}
+	} catch (const BaseException &e) {
+		printf("Benchmark failed: %s\n", e.what());
+	}
+
+	Message::recycle(msg);
+	for (unsigned int i = 0; i < subscribers && sockets[i]; ++i) {
+		delete sockets[i];
+		if (i < pairs) {
+			::close(peers[i]);
+		}
+	}
+	delete[] ends;
+	delete[] sockets;
+	delete[] peers;
+}
+
+unsigned int FanoutTest::channels(unsigned int subscribers) noexcept {
+	/*
+	 * A subscriber takes up two descriptors with its own socket pair, one if
+	 * it shares a duplicate. Leave some descriptors for the rest.
+	 */
+	const rlim_t spare = 256;
+	rlim_t needed = (rlim_t) subscribers * 2 + spare;
+	rlimit limit;
+	try {
+		Process::getLimit(RLIMIT_NOFILE, &limit);
+		if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur < needed) {
+			limit.rlim_cur = (limit.rlim_max == RLIM_INFINITY
+					|| limit.rlim_max > needed) ? needed : limit.rlim_max;
+			Process::setLimit(RLIMIT_NOFILE, &limit);
+		}
+	} catch (const BaseException &e) {
+		return 1;
+	}
+
+	if (limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= needed) {
+		return subscribers;
+	} else if (limit.rlim_cur > (subscribers + spare + 1)) {
+		return limit.rlim_cur - subscribers - spare;
+	} else {
+		return 1;
+	}
+}
+
+void FanoutTest::drain(Socket **sockets, int *peers, unsigned int count) {
+	unsigned char buffer[16384];
+	for (unsigned int i = 0; i < count; ++i) {
+		while (sockets[i]->write() > 0) {
+			while (::read(peers[i], buffer, sizeof(buffer)) > 0) {
+				//Discard
+			}
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				throw SystemException();
+			}
+		}
+	}
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,41 @@
+/*
+ * FanoutTest.h
+ *
+ * Multicast fan-out benchmark
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_MULTICAST_FANOUTTEST_H_
+#define WH_TEST_MULTICAST_FANOUTTEST_H_
+#include "../../hub/Socket.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+/**
+ * Measures the hub-side cost of delivering a published message to a topic's
+ * subscribers: per-subscriber Socket::publish() and the bulk enqueue into the
+ * subscribers' outgoing queues. The queues are written out to socket pairs
+ * between the measured rounds.
+ */
+class FanoutTest {
+public:
+	FanoutTest(unsigned int deliveries = 20000000) noexcept;
+	~FanoutTest();
+	void execute() noexcept;
+private:
+	void test(unsigned int subscribers);
+	//Returns the number of socket pairs the subscribers can have
+	static unsigned int channels(unsigned int subscribers) noexcept;
+	static void drain(Socket **sockets, int *peers, unsigned int count);
+private:
+	unsigned int deliveries;
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_MULTICAST_FANOUTTEST_H_ */
@@ -0,0 +1,113 @@
+/*
+ * SignatureTest.cpp
+ *
+ * Digital signature benchmark (RSA vs Ed25519)
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "SignatureTest.h"
+#include "../../base/Timer.h"
+#include "../../base/common/Exception.h"
+#include "../../util/Packet.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace wanhive {
+
+SignatureTest::SignatureTest(unsigned int iterations) noexcept :
+		iterations(iterations ? iterations : 1) {
+	strcpy(directory, "/tmp/wh-signature-XXXXXX");
+}
+
+SignatureTest::~SignatureTest() {
+
+}
+
+void SignatureTest::execute() noexcept {
+	if (!mkdtemp(directory)) {
+		perror("mkdtemp");
+		return;
+	}
+
+	printf("Iterations: %u, packet size: %u bytes\n", iterations,
+			(unsigned int) Packet::MTU / 2);
+	PKI rsa;
+	PKI ed25519;
+	if (setup(rsa, false) && setup(ed25519, true)) {
+		measure("RSA", rsa);
+		measure("Ed25519", ed25519);
+	} else {
+		printf("Key generation failed\n");
+	}
+
+	rmdir(directory);
+}
+
+bool SignatureTest::setup(PKI &pki, bool ed25519) noexcept {
+	char sk[128];
+	char pk[128];
+	snprintf(sk, sizeof(sk), "%s/%s", directory,
+			ed25519 ? "sign.pem" : "private.pem");
+	snprintf(pk, sizeof(pk), "%s/%s", directory,
+			ed25519 ? "check.pem" : "public.pem");
+	auto success = false;
+	try {
+		//The RSA keys are always required (encryption)
+		if (ed25519) {
+			PKI::generate(sk, pk);
+			success = pki.setup(sk, pk);
+			PKI::generateSignature(sk, pk);
+			success = success && pki.setupSignature(sk, pk);
+		} else {
+			PKI::generate(sk, pk);
+			success = pki.setup(sk, pk);
+		}
+	} catch (const BaseException &e) {
+		success = false;
+	}
+	unlink(sk);
+	unlink(pk);
+	return success;
+}
+
+void SignatureTest::measure(const char *name, PKI &pki) noexcept {
+	Packet packet { 0 };
+	packet.header().setAddress(1, 2);
+	packet.header().setControl(Packet::MTU / 2, 0, 0);
+	packet.header().setContext(0, 0, 0);
+	packet.packHeader();
+	memset(packet.payload(), 0xa5, Packet::MTU / 2 - Packet::HEADER_SIZE);
+	packet.bind();
+
+	//The Ed25519 keys sign only the compact signatures
+	auto compact = pki.isEd25519();
+	Timer t;
+	unsigned int signatures = 0;
+	for (unsigned int i = 0; i < iterations; ++i) {
+		packet.header().setLength(Packet::MTU / 2);
+		packet.bind();
+		signatures += packet.sign(&pki, compact);
+	}
+	auto sign = t.elapsed();
+
+	t.now();
+	unsigned int verified = 0;
+	for (unsigned int i = 0; i < iterations; ++i) {
+		verified += packet.verify(&pki, compact);
+	}
+	auto verify = t.elapsed();
+
+	auto failed = (signatures != iterations) || (verified != iterations);
+	printf("%-8s signature %3u bytes (ops/sec): sign %9.1f, verify %9.1f%s\n",
+			name, pki.signatureLength(compact), (iterations / sign),
+			(iterations / verify), (failed ? " [FAILED]" : ""));
+}
+
+} /* namespace wanhive */
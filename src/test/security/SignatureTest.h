@@ -0,0 +1,35 @@
+/*
+ * SignatureTest.h
+ *
+ * Digital signature benchmark (RSA vs Ed25519)
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_SECURITY_SIGNATURETEST_H_
+#define WH_TEST_SECURITY_SIGNATURETEST_H_
+#include "../../util/PKI.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+
+class SignatureTest {
+public:
+	SignatureTest(unsigned int iterations = 2000) noexcept;
+	~SignatureTest();
+	void execute() noexcept;
+private:
+	bool setup(PKI &pki, bool ed25519) noexcept;
+	void measure(const char *name, PKI &pki) noexcept;
+private:
+	unsigned int iterations;
+	char directory[64];
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_SECURITY_SIGNATURETEST_H_ */
@@ -0,0 +1,250 @@
+/*
+ * PacketTest.cpp
+ *
+ * Batch frame test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#include "PacketTest.h"
+#include "../../base/common/Exception.h"
+#include "../../base/ds/Serializer.h"
+#include "../../util/commands.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+//Batch's source and label, copied into every record
+constexpr uint64_t SOURCE = 42;
+constexpr uint64_t LABEL = 0xabcd;
+
+//Every field of the two headers is the same
+bool same(const wanhive::MessageHeader &a,
+		const wanhive::MessageHeader &b) noexcept {
+	return a.getLabel() == b.getLabel() && a.getSource() == b.getSource()
+			&& a.getDestination() == b.getDestination()
+			&& a.getLength() == b.getLength()
+			&& a.getSequenceNumber() == b.getSequenceNumber()
+			&& a.getSession() == b.getSession()
+			&& a.getCommand() == b.getCommand()
+			&& a.getQualifier() == b.getQualifier()
+			&& a.getStatus() == b.getStatus();
+}
+
+}  // namespace
+
+namespace wanhive {
+
+PacketTest::PacketTest() noexcept :
+		batch { } {
+	//Payloads of 0, 1, 15, and 100 bytes
+	const unsigned int sizes[RECORDS] = { 0, 1, 15, 100 };
+	for (unsigned int i = 0; i < RECORDS; ++i) {
+		headers[i].setLabel(LABEL);
+		headers[i].setAddress(SOURCE, 100 + i);
+		headers[i].setControl(Message::HEADER_SIZE + sizes[i], 7 + i, i);
+		headers[i].setContext(1, i, 2);
+		for (unsigned int j = 0; j < Message::PAYLOAD_SIZE; ++j) {
+			data[i][j] = (unsigned char) (i * 31 + j);
+		}
+	}
+}
+
+PacketTest::~PacketTest() {
+
+}
+
+void PacketTest::execute() noexcept {
+	try {
+		Message::initPool(1);
+		if (!(batch = Message::create())) {
+			throw Exception(EX_MEMORY);
+		}
+
+		bool ok = roundTrip();
+		ok &= capacity();
+		ok &= truncation();
+		ok &= alignment();
+		ok &= takeover();
+		printf("\nBatch frame: %s\n", ok ? "PASSED" : "FAILED");
+	} catch (const BaseException &e) {
+		printf("\nBatch frame: FAILED (%s)\n", e.what());
+	}
+
+	Message::recycle(batch);
+	batch = nullptr;
+	Message::destroyPool();
+}
+
+bool PacketTest::roundTrip() noexcept {
+	bool ok = true;
+	ok &= check("round trip: empty batch", fill(0) && matches(0));
+	ok &= check("round trip: records restored in order",
+			fill(RECORDS) && matches(RECORDS));
+
+	unsigned int length = 0;
+	for (auto &h : headers) {
+		length += Packet::RECORD_SIZE + h.getLength() - Message::HEADER_SIZE;
+	}
+	ok &= check("round trip: compact record headers",
+			batch->getPayloadLength() == length && batch->validate());
+	return ok;
+}
+
+bool PacketTest::capacity() noexcept {
+	fill(0);
+	const auto &h = headers[RECORDS - 1];
+	unsigned int count = 0;
+	while (batch->batch(h, data[RECORDS - 1])) {
+		++count;
+	}
+
+	auto expected = Message::PAYLOAD_SIZE
+			/ (Packet::RECORD_SIZE + h.getLength() - Message::HEADER_SIZE);
+	auto length = batch->getLength();
+	return check("capacity: filled up to the MTU",
+			count == expected && batch->records() == count)
+			&& check("capacity: overflow leaves the batch intact",
+					!batch->batch(h, data[RECORDS - 1])
+							&& batch->getLength() == length
+							&& batch->validate());
+}
+
+bool PacketTest::truncation() noexcept {
+	bool ok = true;
+	MessageHeader h;
+	const unsigned char *d = nullptr;
+	const auto last = headers[RECORDS - 1].getLength() - Message::HEADER_SIZE;
+
+	//The last record's payload is cut short
+	fill(RECORDS);
+	auto length = batch->getLength();
+	batch->putLength(length - 1);
+	ok &= check("truncation: short payload", matches(RECORDS - 1));
+
+	//The last record's header is cut short
+	batch->putLength(length - last - (Packet::RECORD_SIZE / 2));
+	ok &= check("truncation: short record header", matches(RECORDS - 1));
+
+	//The second record claims more than there is
+	fill(RECORDS);
+	auto offset = Packet::RECORD_SIZE
+			+ headers[0].getLength() - Message::HEADER_SIZE;
+	Serializer::packi16(batch->payload(offset) + 8, Message::PAYLOAD_SIZE);
+	unsigned int next = 0;
+	auto first = batch->unbatch(next, h, d) && same(h, headers[0]);
+	auto stuck = next;
+	ok &= check("truncation: oversized length field",
+			first && batch->records() == 1 && !batch->unbatch(next, h, d)
+					&& next == stuck);
+	return ok;
+}
+
+bool PacketTest::alignment() noexcept {
+	bool ok = true;
+	//Header-only records followed by fewer than RECORD_SIZE stray bytes
+	for (unsigned int stray = 1; stray < Packet::RECORD_SIZE; ++stray) {
+		fill(1);
+		batch->batch(headers[0], nullptr);
+		auto length = batch->getLength();
+		if (!batch->putLength(length + stray)) {
+			ok = false;
+			break;
+		}
+
+		MessageHeader h;
+		const unsigned char *d = nullptr;
+		unsigned int offset = 0;
+		unsigned int count = 0;
+		while (batch->unbatch(offset, h, d)) {
+			count += same(h, headers[0]) ? 1 : 0;
+		}
+		ok &= (count == 2 && batch->records() == 2
+				&& offset == (2 * Packet::RECORD_SIZE));
+	}
+	return check("alignment: stray bytes after the last record", ok);
+}
+
+bool PacketTest::takeover() noexcept {
+	//Follows Hub::unbatch(): the last record takes over the batch's message
+	fill(RECORDS);
+	MessageHeader h;
+	const unsigned char *d = nullptr;
+	unsigned int offset = 0;
+	unsigned int count = 0;
+	while (batch->unbatch(offset, h, d)) {
+		++count;
+		if (offset == batch->getPayloadLength()) {
+			break;
+		}
+	}
+
+	const auto &expected = headers[RECORDS - 1];
+	auto size = expected.getLength() - Message::HEADER_SIZE;
+	MessageHeader frame;
+	auto ok = check("takeover: last record located",
+			count == RECORDS && same(h, expected));
+	ok &= check("takeover: batch becomes the last record",
+			ok && batch->adopt(h, d) && same(batch->header(), expected)
+					&& !memcmp(batch->payload(), data[RECORDS - 1], size));
+	ok &= check("takeover: frame's header rewritten",
+			batch->unpackHeader(frame) && same(frame, expected)
+					&& batch->validate());
+
+	//A header-only record
+	fill(1);
+	offset = 0;
+	ok &= check("takeover: empty payload",
+			batch->unbatch(offset, h, d)
+					&& offset == batch->getPayloadLength()
+					&& batch->adopt(h, d) && same(batch->header(), headers[0])
+					&& batch->getPayloadLength() == 0 && batch->validate());
+	return ok;
+}
+
+bool PacketTest::fill(unsigned int count) noexcept {
+	MessageHeader h;
+	h.setLabel(LABEL);
+	h.setAddress(SOURCE, 1);
+	h.setControl(Message::HEADER_SIZE, 0, 0);
+	h.setContext(WH_CMD_BATCH, 0, 0);
+	if (!batch->putHeader(h)) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < count; ++i) {
+		if (!batch->batch(headers[i], data[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool PacketTest::matches(unsigned int count) const noexcept {
+	MessageHeader h;
+	const unsigned char *d = nullptr;
+	unsigned int offset = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		if (!batch->unbatch(offset, h, d) || !same(h, headers[i])
+				|| memcmp(d, data[i], h.getLength() - Message::HEADER_SIZE)) {
+			return false;
+		}
+	}
+
+	//Nothing is left, or the rest is malformed
+	auto rest = offset;
+	return !batch->unbatch(offset, h, d) && offset == rest
+			&& batch->records() == count;
+}
+
+bool PacketTest::check(const char *what, bool ok) noexcept {
+	printf("%-52s %s\n", what, ok ? "OK" : "FAILED");
+	return ok;
+}
+
+} /* namespace wanhive */
@@ -0,0 +1,45 @@
+/*
+ * PacketTest.h
+ *
+ * Batch frame test routines
+ *
+ *
+ * Copyright (C) 2025 Wanhive Systems Private Limited (info@wanhive.com)
+ * This program is part of the Wanhive IoT Platform.
+ * Check the COPYING file for the license.
+ *
+ */
+
+#ifndef WH_TEST_UTIL_PACKETTEST_H_
+#define WH_TEST_UTIL_PACKETTEST_H_
+#include "../../util/Message.h"
+
+/*! @namespace wanhive */
+namespace wanhive {
+
+class PacketTest {
+public:
+	PacketTest() noexcept;
+	~PacketTest();
+	void execute() noexcept;
+private:
+	bool roundTrip() noexcept;
+	bool capacity() noexcept;
+	bool truncation() noexcept;
+	bool alignment() noexcept;
+	bool takeover() noexcept;
+	//Empties the batch and appends the sample records to it
+	bool fill(unsigned int count) noexcept;
+	//The batch's records match the sample records
+	bool matches(unsigned int count) const noexcept;
+	static bool check(const char *what, bool ok) noexcept;
+private:
+	static constexpr unsigned int RECORDS = 4;
+	Message *batch;
+	MessageHeader headers[RECORDS];
+	unsigned char data[RECORDS][Message::PAYLOAD_SIZE];
+};
+
+} /* namespace wanhive */
+
+#endif /* WH_TEST_UTIL_PACKETTEST_H_ */
@@ -160,18 +160,18 @@ void Endpoint::send(bool sign) {
 	}
 }
 
-void Endpoint::receive(unsigned int seq, bool verify) {
+void Endpoint::receive(unsigned int seq, bool verify, bool compact) {
 	auto pki = verify ? getKeyPair() : nullptr;
 	if (!ssl) {
-		receive(sockfd, *this, seq, pki);
+		receive(sockfd, *this, seq, pki, compact);
 	} else {
-		receive(ssl, *this, seq, pki);
+		receive(ssl, *this, seq, pki, compact);
 	}
 }
 
-bool Endpoint::executeRequest(bool sign, bool verify) {
+bool Endpoint::executeRequest(bool sign, bool verify, bool compact) {
 	send(sign);
-	receive(header().getSequenceNumber(), verify);
+	receive(header().getSequenceNumber(), verify, compact);
 	return (header().getStatus() == WH_AQLF_ACCEPTED);
 }
 
@@ -221,7 +221,8 @@ void Endpoint::send(SSL *ssl, Packet &packet, PKI *pki) {
 	}
 }
 
-void Endpoint::receive(int sfd, Packet &packet, unsigned int seq, PKI *pki) {
+void Endpoint::receive(int sfd, Packet &packet, unsigned int seq, PKI *pki,
+		bool compact) {
 	packet.clear();
 	do {
 		//Receive the header
@@ -237,12 +238,13 @@ void Endpoint::receive(int sfd, Packet &packet, unsigned int seq, PKI *pki) {
 		Network::read(sfd, packet.payload(), payloadLength);
 	} while (seq && (packet.header().getSequenceNumber() != seq));
 
-	if (!packet.verify(pki)) {
+	if (!packet.verify(pki, compact)) {
 		throw Exception(EX_SECURITY);
 	}
 }
 
-void Endpoint::receive(SSL *ssl, Packet &packet, unsigned int seq, PKI *pki) {
+void Endpoint::receive(SSL *ssl, Packet &packet, unsigned int seq, PKI *pki,
+		bool compact) {
 	packet.clear();
 	do {
 		//Receive the header
@@ -258,7 +260,7 @@ void Endpoint::receive(SSL *ssl, Packet &packet, unsigned int seq, PKI *pki) {
 		SSLContext::receive(ssl, packet.payload(), payloadLength);
 	} while (seq && (packet.header().getSequenceNumber() != seq));
 
-	if (!packet.verify(pki)) {
+	if (!packet.verify(pki, compact)) {
 		throw Exception(EX_SECURITY);
 	}
 }
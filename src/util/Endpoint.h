@@ -128,15 +128,19 @@ public:
 	 * Receives a response.
 	 * @param seq expected sequence number (0 to ignore)
 	 * @param verify true for message verification, false otherwise
+	 * @param compact true if the response carries a compact signature
 	 */
-	void receive(unsigned int seq = 0, bool verify = false);
+	void receive(unsigned int seq = 0, bool verify = false,
+			bool compact = false);
 	/**
 	 * Executes a request: sends a request and receives the response.
 	 * @param sign true to sign the outgoing request, false otherwise
 	 * @param verify true to verify the incoming response, false otherwise
+	 * @param compact true if the response carries a compact signature
 	 * @return true on success, false otherwise (request rejected)
 	 */
-	bool executeRequest(bool sign = false, bool verify = false);
+	bool executeRequest(bool sign = false, bool verify = false,
+			bool compact = false);
 	/**
 	 * Waits for a ping and then responds back with a pong.
 	 */
@@ -176,9 +180,10 @@ public:
 	 * @param packet stores the incoming response
 	 * @param seq expected sequence number
 	 * @param pki verification key
+	 * @param compact true if the response carries a compact signature
 	 */
 	static void receive(int sfd, Packet &packet, unsigned int seq = 0,
-			PKI *pki = nullptr);
+			PKI *pki = nullptr, bool compact = false);
 	/**
 	 * Receives a response. If a verification key is provided (not nullptr) then
 	 * the response's digital signature is verified. If an "expected" sequence
@@ -188,9 +193,10 @@ public:
 	 * @param packet stores the incoming response
 	 * @param seq expected sequence number
 	 * @param pki verification key
+	 * @param compact true if the response carries a compact signature
 	 */
 	static void receive(SSL *ssl, Packet &packet, unsigned int seq = 0,
-			PKI *pki = nullptr);
+			PKI *pki = nullptr, bool compact = false);
 private:
 	int sockfd { -1 };
 	SSL *ssl { };
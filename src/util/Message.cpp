@@ -13,6 +13,7 @@
 #include "Message.h"
 #include "../base/common/Exception.h"
 #include "../base/ds/Serializer.h"
+#include <cstring>
 
 namespace wanhive {
 
@@ -34,7 +35,7 @@ void Message::operator delete(void *p) noexcept {
 }
 
 Message* Message::create(uint64_t origin) noexcept {
-	if (allocated() != poolSize()) {
+	if (unallocated()) {
 		return new Message(origin);
 	} else {
 		return nullptr;
@@ -54,41 +55,35 @@ bool Message::recycle(Message *message) noexcept {
 void Message::clear() noexcept {
 	State::clear();
 	Frame::clear();
+	stamp = 0;
 }
 
 bool Message::build(Source<unsigned char> &in) {
 	switch (getFlags()) {
 	case 0:
+		frame().clear();
+		putFlags(MSG_WAIT_HEADER);
 		/* no break */
 	case MSG_WAIT_HEADER:
-		if (in.available() >= Message::HEADER_SIZE) {
-			frame().clear();
-			in.emit(frame().offset(), Message::HEADER_SIZE);
+		if (fill(in, HEADER_SIZE)) {
 			//Prepare the routing header
 			header().read(frame().array());
-			frame().setIndex(HEADER_SIZE);
 			putFlags(MSG_WAIT_DATA);
 		} else {
 			return false;
 		}
 		/* no break */
 	case MSG_WAIT_DATA:
-		if (testLength()) {
-			auto payLoadLength = header().getLength() - HEADER_SIZE;
-			if (in.available() >= payLoadLength) {
-				in.emit(frame().offset(), payLoadLength);
-				//Set the correct limit and index
-				frame().setIndex(header().getLength());
-				frame().rewind();
-				putFlags(MSG_WAIT_PROCESSING);
-				return true;
-			} else {
-				return false;
-			}
-		} else {
+		if (!testLength()) {
 			throw Exception(EX_RANGE);
+		} else if (fill(in, header().getLength())) {
+			//Set the correct limit and index
+			frame().rewind();
+			putFlags(MSG_WAIT_PROCESSING);
+			return true;
+		} else {
+			return false;
 		}
-		/* no break */
 	case MSG_WAIT_PROCESSING:
 		return true;
 	default:
@@ -96,6 +91,32 @@ bool Message::build(Source<unsigned char> &in) {
 	}
 }
 
+unsigned char* Message::reserve(unsigned int &size) noexcept {
+	unsigned int limit = 0;
+	if (getFlags() == MSG_WAIT_HEADER) {
+		limit = HEADER_SIZE;
+	} else if (getFlags() == MSG_WAIT_DATA && testLength()) {
+		limit = header().getLength();
+	}
+
+	if (frame().getIndex() < limit) {
+		size = limit - frame().getIndex();
+		return frame().offset();
+	} else {
+		size = 0;
+		return nullptr;
+	}
+}
+
+bool Message::commit(unsigned int size) noexcept {
+	unsigned int space = 0;
+	if (reserve(space) && size <= space) {
+		return frame().setIndex(frame().getIndex() + size);
+	} else {
+		return !size;
+	}
+}
+
 uint64_t Message::getLabel() const noexcept {
 	return header().getLabel();
 }
@@ -561,6 +582,18 @@ bool Message::pack(const unsigned char *message) noexcept {
 	}
 }
 
+bool Message::adopt(const MessageHeader &header,
+		const unsigned char *data) noexcept {
+	auto length = header.getLength();
+	if (!testLength(length) || (length > HEADER_SIZE && !data)) {
+		return false;
+	} else if (length > HEADER_SIZE) {
+		//Overlapping copy
+		memmove(payload(), data, length - HEADER_SIZE);
+	}
+	return putHeader(header);
+}
+
 bool Message::append(const char *format, ...) noexcept {
 	va_list ap;
 	va_start(ap, format);
@@ -604,14 +637,35 @@ bool Message::available(unsigned int count) noexcept {
 	return count <= unallocated();
 }
 
-unsigned int Message::link() noexcept {
-	setLinks(getLinks() + 1);
+unsigned int Message::link(unsigned int count) noexcept {
+	setLinks(getLinks() + count);
 	return getLinks();
 }
 
+bool Message::isLinked() const noexcept {
+	return getLinks() != 0;
+}
+
 unsigned int Message::hop() noexcept {
 	setHops(getHops() + 1);
 	return getHops();
 }
 
+unsigned long long Message::getStamp() const noexcept {
+	return stamp;
+}
+
+void Message::setStamp(unsigned long long stamp) noexcept {
+	this->stamp = stamp;
+}
+
+bool Message::fill(Source<unsigned char> &in, unsigned int limit) {
+	auto index = frame().getIndex();
+	if (index < limit) {
+		index += in.emit(frame().offset(), limit - index);
+		frame().setIndex(index);
+	}
+	return index == limit;
+}
+
 } /* namespace wanhive */
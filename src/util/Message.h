@@ -32,7 +32,8 @@ enum MessageFlag : uint32_t {
 	MSG_PROCESSED = 8, /**< Processed */
 	MSG_PRIORITY = 16, /**< High priority message */
 	MSG_PROBE = 32, /**< Requires additional processing */
-	MSG_INVALID = 64 /**< Invalid message */
+	MSG_INVALID = 64, /**< Invalid message */
+	MSG_DEFERRED = 128 /**< Withheld (delegated to a worker thread) */
 };
 //-----------------------------------------------------------------
 /**
@@ -73,6 +74,23 @@ public:
 	 * @return true on completion (message populated), false otherwise
 	 */
 	bool build(Source<unsigned char> &in);
+	/**
+	 * Returns the frame buffer's region reserved for the remaining bytes of an
+	 * incomplete message (see Message::build()). It allows the caller to
+	 * receive the data directly into the frame buffer, bypassing the source.
+	 * @param size stores the region's size in bytes
+	 * @return region's base address, nullptr if the message is not waiting for
+	 * more data (a message which has not started building yet waits for the
+	 * source).
+	 */
+	unsigned char* reserve(unsigned int &size) noexcept;
+	/**
+	 * Commits the data written into the region returned by Message::reserve().
+	 * Call Message::build() afterwards for completion.
+	 * @param size number of bytes written into the region
+	 * @return true on success, false on error (region overflow)
+	 */
+	bool commit(unsigned int size) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Returns routing header's label.
@@ -525,6 +543,14 @@ public:
 	 * @return true on success, false on error (invalid data)
 	 */
 	bool pack(const unsigned char *message) noexcept;
+	/**
+	 * Turns this message into a batch record's message (see Packet::unbatch()).
+	 * The record's payload may reside inside this message's payload.
+	 * @param header record's header
+	 * @param data record's payload (can be nullptr if the payload is empty)
+	 * @return true on success, false on error (invalid length)
+	 */
+	bool adopt(const MessageHeader &header, const unsigned char *data) noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * Appends additional data to the payload and updates message's length.
@@ -564,15 +590,36 @@ public:
 	static bool available(unsigned int count) noexcept;
 	//-----------------------------------------------------------------
 	/**
-	 * Increments the reference count by one (1) and returns the new value.
+	 * Increments the reference count and returns the new value.
+	 * @param count increment's value, one (1) by default
 	 * @return updated reference count
 	 */
-	unsigned int link() noexcept;
+	unsigned int link(unsigned int count = 1) noexcept;
+	/**
+	 * Checks whether the message has been linked (see Message::link()).
+	 * @return true if the reference count is nonzero, false otherwise
+	 */
+	bool isLinked() const noexcept;
 	/**
 	 * Increments the hop count by one (1) and returns the new value.
 	 * @return updated hop count
 	 */
 	unsigned int hop() noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Returns the arrival timestamp (see Message::setStamp()).
+	 * @return timestamp in microseconds, 0 if not set
+	 */
+	unsigned long long getStamp() const noexcept;
+	/**
+	 * Sets the arrival timestamp (for profiling).
+	 * @param stamp timestamp in microseconds (monotonic clock)
+	 */
+	void setStamp(unsigned long long stamp) noexcept;
+private:
+	bool fill(Source<unsigned char> &in, unsigned int limit);
+private:
+	unsigned long long stamp { };
 };
 
 } /* namespace wanhive */
@@ -35,6 +35,28 @@ bool PKI::loadPublicKey(const char *key) noexcept {
 	return rsa.loadPublicKey(key) || !key;
 }
 
+bool PKI::setupSignature(const char *privateKey,
+		const char *publicKey) noexcept {
+	if (!privateKey && !publicKey) {
+		ed25519.reset();
+		ed25519Enabled = false;
+		return true;
+	} else if (ed25519.setup(privateKey, publicKey)) {
+		ed25519Enabled = true;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+bool PKI::loadSigningKey(const char *key) noexcept {
+	return ed25519.loadPrivateKey(key) || !key;
+}
+
+bool PKI::loadVerificationKey(const char *key) noexcept {
+	return ed25519.loadPublicKey(key) || !key;
+}
+
 bool PKI::hasPrivateKey() const noexcept {
 	return rsa.hasPrivateKey();
 }
@@ -43,6 +65,15 @@ bool PKI::hasPublicKey() const noexcept {
 	return rsa.hasPublicKey();
 }
 
+bool PKI::isEd25519() const noexcept {
+	return ed25519Enabled;
+}
+
+unsigned int PKI::signatureLength(bool compact) const noexcept {
+	return (compact && ed25519Enabled) ?
+			ED25519_SIGNATURE_LENGTH : SIGNATURE_LENGTH;
+}
+
 bool PKI::encrypt(const void *plaintext, unsigned int size,
 		CipherText *ciphertext) noexcept {
 	auto len = ENCRYPTED_LENGTH;
@@ -66,17 +97,28 @@ bool PKI::decrypt(const CipherText *ciphertext, void *plaintext,
 	}
 }
 
-bool PKI::sign(const void *data, unsigned int size,
-		Signature *signature) noexcept {
+bool PKI::sign(const void *data, unsigned int size, Signature *signature,
+		bool compact) noexcept {
 	auto len = SIGNATURE_LENGTH;
-	return rsa.sign((const unsigned char*) data, size,
-			(unsigned char*) signature, len) && (len == SIGNATURE_LENGTH);
+	if (compact && ed25519Enabled) {
+		return ed25519.sign((const unsigned char*) data, size,
+				(unsigned char*) signature, len)
+				&& (len == ED25519_SIGNATURE_LENGTH);
+	} else {
+		return rsa.sign((const unsigned char*) data, size,
+				(unsigned char*) signature, len) && (len == SIGNATURE_LENGTH);
+	}
 }
 
 bool PKI::verify(const void *data, unsigned int size,
-		const Signature *signature) noexcept {
-	return rsa.verify((unsigned char*) data, size, (unsigned char*) signature,
-			SIGNATURE_LENGTH);
+		const Signature *signature, bool compact) noexcept {
+	if (compact && ed25519Enabled) {
+		return ed25519.verify((const unsigned char*) data, size,
+				(const unsigned char*) signature, ED25519_SIGNATURE_LENGTH);
+	} else {
+		return rsa.verify((unsigned char*) data, size,
+				(unsigned char*) signature, SIGNATURE_LENGTH);
+	}
 }
 
 void PKI::generate(const char *privateKey, const char *publicKey) {
@@ -85,4 +127,10 @@ void PKI::generate(const char *privateKey, const char *publicKey) {
 	}
 }
 
+void PKI::generateSignature(const char *privateKey, const char *publicKey) {
+	if (!Ed25519 { }.generate(privateKey, publicKey)) {
+		throw Exception(EX_SECURITY);
+	}
+}
+
 } /* namespace wanhive */
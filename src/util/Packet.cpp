@@ -112,16 +112,85 @@ bool Packet::checkContext(uint8_t command, uint8_t qualifier,
 	return checkContext(header(), command, qualifier, status);
 }
 
-bool Packet::sign(PKI *pki) noexcept {
+bool Packet::batch(const MessageHeader &header,
+		const unsigned char *data) noexcept {
+	auto offset = this->header().getLength();
+	auto length = header.getLength();
+	if (!validate() || length < HEADER_SIZE
+			|| (length > HEADER_SIZE && !data)) {
+		return false;
+	}
+
+	auto size = length - HEADER_SIZE;
+	auto total = offset + RECORD_SIZE + size;
+	if (!testLength(total) || !bind(total)) {
+		return false;
+	}
+
+	auto p = buffer(offset);
+	Serializer::packi64(p, header.getDestination());
+	Serializer::packi16(p + 8, size);
+	Serializer::packi16(p + 10, header.getSequenceNumber());
+	Serializer::packi8(p + 12, header.getSession());
+	Serializer::packi8(p + 13, header.getCommand());
+	Serializer::packi8(p + 14, header.getQualifier());
+	Serializer::packi8(p + 15, header.getStatus());
+	if (size) {
+		Serializer::packib(p + RECORD_SIZE, data, size);
+	}
+	this->header().setLength(total);
+	return true;
+}
+
+bool Packet::unbatch(unsigned int &offset, MessageHeader &header,
+		const unsigned char *&data) const noexcept {
+	auto length = getPayloadLength();
+	if (offset >= length || (length - offset) < RECORD_SIZE) {
+		return false;
+	}
+
+	auto p = payload(offset);
+	auto size = Serializer::unpacku16(p + 8);
+	if (size > (length - offset - RECORD_SIZE)) {
+		return false;
+	}
+
+	header.setLabel(this->header().getLabel());
+	header.setAddress(this->header().getSource(), Serializer::unpacku64(p));
+	header.setControl(HEADER_SIZE + size, Serializer::unpacku16(p + 10),
+			Serializer::unpacku8(p + 12));
+	header.setContext(Serializer::unpacku8(p + 13),
+			Serializer::unpacku8(p + 14), Serializer::unpacku8(p + 15));
+	data = p + RECORD_SIZE;
+	offset += RECORD_SIZE + size;
+	return true;
+}
+
+unsigned int Packet::records() const noexcept {
+	auto length = getPayloadLength();
+	unsigned int count = 0;
+	unsigned int offset = 0;
+	while (offset < length && (length - offset) >= RECORD_SIZE) {
+		auto size = Serializer::unpacku16(payload(offset) + 8);
+		if (size > (length - offset - RECORD_SIZE)) {
+			break;
+		}
+		offset += RECORD_SIZE + size;
+		++count;
+	}
+	return count;
+}
+
+bool Packet::sign(PKI *pki, bool compact) noexcept {
 	if (pki && validate()
-			&& header().getLength() <= (MTU - PKI::SIGNATURE_LENGTH)) {
+			&& header().getLength() <= (MTU - pki->signatureLength(compact))) {
 		const auto length = header().getLength(); //To roll back
 
 		//Finalize the frame, otherwise verification will fail
-		header().setLength(length + PKI::SIGNATURE_LENGTH);
+		header().setLength(length + pki->signatureLength(compact));
 		bind();
 
-		if (pki->sign(buffer(), length, (Signature*) buffer(length))) {
+		if (pki->sign(buffer(), length, (Signature*) buffer(length), compact)) {
 			return true;
 		} else {
 			//Roll back
@@ -134,10 +203,11 @@ bool Packet::sign(PKI *pki) noexcept {
 	}
 }
 
-bool Packet::verify(PKI *pki) const noexcept {
-	if (pki && getPayloadLength() >= PKI::SIGNATURE_LENGTH) {
-		auto length = header().getLength() - PKI::SIGNATURE_LENGTH;
-		return pki->verify(buffer(), length, (const Signature*) buffer(length));
+bool Packet::verify(PKI *pki, bool compact) const noexcept {
+	if (pki && getPayloadLength() >= pki->signatureLength(compact)) {
+		auto length = header().getLength() - pki->signatureLength(compact);
+		return pki->verify(buffer(), length, (const Signature*) buffer(length),
+				compact);
 	} else {
 		return !pki;
 	}
@@ -140,17 +140,49 @@ public:
 			uint8_t status) const noexcept;
 	//-----------------------------------------------------------------
 	/**
-	 * Signs this packet.
+	 * Appends a message to this packet's payload as a batch record. A record
+	 * consists of the message's compact header (see Packet::RECORD_SIZE)
+	 * followed by the message's payload.
+	 * @param header message's header, the length includes the header's size
+	 * @param data message's payload (can be nullptr if the payload is empty)
+	 * @return true on success, false on error (invalid message or no space)
+	 */
+	bool batch(const MessageHeader &header, const unsigned char *data) noexcept;
+	/**
+	 * Extracts a batch record from this packet's payload (see Packet::batch()).
+	 * The source and the label are copied from this packet's routing header.
+	 * @param offset a value-result argument which provides the record's offset
+	 * inside the payload and receives the next record's offset.
+	 * @param header stores the message's header
+	 * @param data stores a pointer to the message's payload
+	 * @return true on success, false on error (no more records or a malformed
+	 * record).
+	 */
+	bool unbatch(unsigned int &offset, MessageHeader &header,
+			const unsigned char *&data) const noexcept;
+	/**
+	 * Counts the batch records inside this packet's payload (see
+	 * Packet::batch()).
+	 * @return number of records preceding the first malformed one (if any)
+	 */
+	unsigned int records() const noexcept;
+	//-----------------------------------------------------------------
+	/**
+	 * Signs this packet. The signature is appended to the payload.
 	 * @param pki signing key
+	 * @param compact true for a compact (Ed25519 if available) signature,
+	 * false for RSA signature
 	 * @return true on success (or the key is nullptr), false otherwise
 	 */
-	bool sign(PKI *pki) noexcept;
+	bool sign(PKI *pki, bool compact = false) noexcept;
 	/**
 	 * Verifies this packet's signature.
 	 * @param pki verifying key
+	 * @param compact true for a compact (Ed25519 if available) signature,
+	 * false for RSA signature
 	 * @return true on success (or the key is nullptr), false otherwise
 	 */
-	bool verify(PKI *pki) const noexcept;
+	bool verify(PKI *pki, bool compact = false) const noexcept;
 	//-----------------------------------------------------------------
 	/**
 	 * For debugging: prints the header data to stderr.
@@ -158,6 +190,13 @@ public:
 	 * print the routing header's data.
 	 */
 	void printHeader(bool deep = false) const noexcept;
+public:
+	/**
+	 * Batch record's header size in bytes: destination (8 bytes), payload
+	 * length (2 bytes), sequence number (2 bytes), session (1 byte), command
+	 * (1 byte), qualifier (1 byte), and status (1 byte).
+	 */
+	static constexpr unsigned int RECORD_SIZE = 16;
 };
 
 } /* namespace wanhive */
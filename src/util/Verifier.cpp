@@ -31,13 +31,21 @@ Verifier::~Verifier() {
 
 bool Verifier::identify(unsigned long long identity, const char *secret,
 		const char *salt, const Data &nonce) noexcept {
+	return prepare(secret, salt) && identify(identity, nonce);
+}
+
+bool Verifier::prepare(const char *secret, const char *salt) noexcept {
+	return _host && initialize() && loadSalt(salt)
+			&& loadPasswordVerifier(secret);
+}
+
+bool Verifier::identify(unsigned long long identity, const Data &nonce) noexcept {
 	if (!_host) {
 		return false;
 	}
 
-	auto success = initialize() && loadSalt(salt)
-			&& loadPasswordVerifier(secret) && loadHostSecret()
-			&& loadHostNonce() && loadUserNonce(nonce.base, nonce.length)
+	auto success = loadHostSecret() && loadHostNonce()
+			&& loadUserNonce(nonce.base, nonce.length)
 			&& loadRandomScramblingParameter() && loadSessionKey(true)
 			&& generateUserEvidence() && generateHostEvidence();
 
@@ -52,6 +52,23 @@ public:
 	 */
 	bool identify(unsigned long long identity, const char *secret,
 			const char *salt, const Data &nonce) noexcept;
+	/**
+	 * STEP 1 in two phases, PHASE 1: loads user's salt and password verifier
+	 * at the host's end (inexpensive).
+	 * @param secret password verifier (hexadecimal)
+	 * @param salt user's salt (hexadecimal)
+	 * @return true on success, false on error
+	 */
+	bool prepare(const char *secret, const char *salt) noexcept;
+	/**
+	 * STEP 1 in two phases, PHASE 2: carries out the computations of STEP 1
+	 * (expensive) using the salt and password verifier loaded by the
+	 * Verifier::prepare() call.
+	 * @param identity user's identity
+	 * @param nonce user's public ephemeral value
+	 * @return true on success, false on error
+	 */
+	bool identify(unsigned long long identity, const Data &nonce) noexcept;
 	/**
 	 * STEP 2: Calculates user's proof at the user's end.
 	 * Host -> User:  s, B = kv + g^b (sends salt and nonce, b = random number)
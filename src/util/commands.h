@@ -22,7 +22,8 @@ namespace wanhive {
 enum WhpCommand {
 	WH_CMD_NULL = 0, /**< Null command */
 	WH_CMD_BASIC = 1, /**< Basic command */
-	WH_CMD_MULTICAST = 2/**< Pub/Sub command */
+	WH_CMD_MULTICAST = 2,/**< Pub/Sub command */
+	WH_CMD_BATCH = 127 /**< Batch of messages */
 };
 
 /**
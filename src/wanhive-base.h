@@ -46,6 +46,8 @@
 #include "base/ds/State.h"
 #include "base/ds/StaticBuffer.h"
 #include "base/ds/StaticCircularBuffer.h"
+#include "base/ds/Swiss.h"
+#include "base/ds/TimerWheel.h"
 #include "base/ds/Tokens.h"
 #include "base/ds/UID.h"
 
@@ -60,6 +62,7 @@
  */
 #include "base/Network.h"
 #include "base/Options.h"
+#include "base/Ring.h"
 #include "base/Selector.h"
 #include "base/Signal.h"
 #include "base/Storage.h"